@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2016 iCub Facility
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ */
+
+// Measure the latency of the getters of remote_controlboard that are
+// served from the streamed state, while the state keeps arriving.
+// A controlboardwrapper2 with a fakeMotionControl (or any --subdevice)
+// and the remote_controlboard run in the same process, with local ports,
+// so no yarpserver is needed.
+//
+//   ./remote_controlboard_benchmark --axes 16 --count 100000 --period 5
+//
+// --subdevice test_motor works where device plugins cannot be loaded.
+
+#include <cstdio>
+#include <vector>
+
+#include <yarp/os/Network.h>
+#include <yarp/os/Property.h>
+#include <yarp/os/Time.h>
+#include <yarp/dev/PolyDriver.h>
+#include <yarp/dev/ControlBoardInterfaces.h>
+
+using namespace yarp::os;
+using namespace yarp::dev;
+
+int main(int argc, char *argv[])
+{
+    Network yarp;
+    Network::setLocalMode(true);
+
+    Property options;
+    options.fromCommand(argc, argv);
+    int axes = options.check("axes", Value(16)).asInt();
+    int count = options.check("count", Value(100000)).asInt();
+    int period = options.check("period", Value(5)).asInt();
+    ConstString subdevice = options.check("subdevice", Value("fakeMotionControl")).asString();
+
+    Property server;
+    server.put("device", "controlboardwrapper2");
+    server.put("subdevice", subdevice);
+    server.put("name", "/benchmark");
+    server.put("period", period);
+    server.put("axes", axes);
+    Property& general = server.addGroup("GENERAL");
+    general.put("Joints", axes);
+
+    PolyDriver wrapper;
+    if(!wrapper.open(server))
+    {
+        printf("cannot open controlboardwrapper2 with %s\n", subdevice.c_str());
+        return 1;
+    }
+
+    Property client;
+    client.put("device", "remote_controlboard");
+    client.put("remote", "/benchmark");
+    client.put("local", "/benchmark/client");
+    client.put("carrier", "tcp");
+    PolyDriver remote;
+    if(!remote.open(client))
+    {
+        printf("cannot open remote_controlboard\n");
+        return 1;
+    }
+
+    IEncoders *enc = NULL;
+    ITorqueControl *trq = NULL;
+    remote.view(enc);
+    remote.view(trq);
+    if(enc == NULL)
+    {
+        printf("no encoder interface\n");
+        return 1;
+    }
+
+    // wait for the first state message
+    std::vector<double> v(axes);
+    double timeout = Time::now()+5.0;
+    while(!enc->getEncoders(&v[0]) && Time::now() < timeout)
+        Time::delay(0.01);
+    if(Time::now() >= timeout)
+    {
+        printf("no state received\n");
+        return 1;
+    }
+
+    printf("%d calls per getter, %d axes, state streamed every %d ms\n",
+           count, axes, period);
+
+    double start = Time::now();
+    for(int i=0; i<count; i++)
+        enc->getEncoders(&v[0]);
+    printf("%-18s %8.3f us/call\n", "getEncoders",
+           1e6*(Time::now()-start)/count);
+
+    start = Time::now();
+    for(int i=0; i<count; i++)
+        enc->getEncoder(i%axes, &v[0]);
+    printf("%-18s %8.3f us/call\n", "getEncoder",
+           1e6*(Time::now()-start)/count);
+
+    start = Time::now();
+    for(int i=0; i<count; i++)
+        enc->getEncoderSpeeds(&v[0]);
+    printf("%-18s %8.3f us/call\n", "getEncoderSpeeds",
+           1e6*(Time::now()-start)/count);
+
+    if(trq != NULL)
+    {
+        start = Time::now();
+        for(int i=0; i<count; i++)
+            trq->getTorques(&v[0]);
+        printf("%-18s %8.3f us/call\n", "getTorques",
+               1e6*(Time::now()-start)/count);
+    }
+
+    remote.close();
+    wrapper.close();
+    return 0;
+}
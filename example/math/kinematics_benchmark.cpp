@@ -0,0 +1,141 @@
+/*
+ * Copyright: (C) 2016 iCub Facility - Istituto Italiano di Tecnologia
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ */
+
+// Compare typical kinematics expressions written with the yarp::math
+// operators against the same expressions evaluated in preallocated
+// storage, counting heap allocations per iteration.
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include <yarp/sig/Vector.h>
+#include <yarp/sig/Matrix.h>
+#include <yarp/math/Math.h>
+#include <yarp/math/Rand.h>
+#include <yarp/os/Time.h>
+
+using namespace yarp::sig;
+using namespace yarp::math;
+
+static long allocations = 0;
+
+#if __cplusplus >= 201103L
+#  define NEW_THROWS
+#  define DELETE_THROWS noexcept
+#else
+#  define NEW_THROWS throw(std::bad_alloc)
+#  define DELETE_THROWS throw()
+#endif
+
+void *operator new(size_t size) NEW_THROWS
+{
+    allocations++;
+    void *p = malloc(size>0 ? size : 1);
+    if (p == NULL) throw std::bad_alloc();
+    return p;
+}
+
+void *operator new[](size_t size) NEW_THROWS
+{
+    return operator new(size);
+}
+
+void operator delete(void *p) DELETE_THROWS
+{
+    free(p);
+}
+
+void operator delete[](void *p) DELETE_THROWS
+{
+    free(p);
+}
+
+void fillMatrix(Matrix& mat) {
+    for (int r = 0; r < mat.rows(); r++) {
+        for (int c = 0; c < mat.cols(); c++) {
+            mat(r, c) = Rand::scalar(-1, 1);
+        }
+    }
+}
+
+void fillVector(Vector& vec) {
+    for (size_t i = 0; i < vec.size(); i++) {
+        vec[i] = Rand::scalar(-1, 1);
+    }
+}
+
+void report(const char *name, int times, double t, long allocs) {
+    printf("%-34s %8.3f us/iteration, %6.2f allocations/iteration\n",
+           name, 1e6*t/times, (double)allocs/times);
+}
+
+int main(int argc, char** argv) {
+    int times = 100000;
+    if (argc > 1) {
+        times = atoi(argv[1]);
+    }
+
+    // a 6x7 Jacobian, as for an arm, and a 4x4 chain of transforms
+    Matrix J(6, 7), K(6, 6), H1(4, 4), H2(4, 4);
+    Vector q(7), xd(6), x(6);
+    fillMatrix(J);
+    fillMatrix(K);
+    fillVector(q);
+    fillVector(xd);
+    fillVector(x);
+    H1 = rpy2dcm(cat(0.1, 0.2, 0.3));
+    H2 = rpy2dcm(cat(-0.3, 0.5, 0.2));
+    H1(0, 3) = 0.1;
+    H2(2, 3) = -0.2;
+
+    Vector y, e;
+    Matrix H, Hinv, A;
+    long allocs;
+    double t;
+
+    // y = J*q + K*(xd - x)
+    allocs = allocations;
+    t = yarp::os::Time::now();
+    for (int i = 0; i < times; i++) {
+        y = J*q + K*(xd - x);
+    }
+    t = yarp::os::Time::now() - t;
+    report("operators: J*q+K*(xd-x)", times, t, allocations - allocs);
+
+    y.resize(6);
+    allocs = allocations;
+    t = yarp::os::Time::now();
+    for (int i = 0; i < times; i++) {
+        sub(xd, x, e);
+        mul(J, q, y);
+        gemv(1.0, K, e, 1.0, y);
+    }
+    t = yarp::os::Time::now() - t;
+    report("in place:  J*q+K*(xd-x)", times, t, allocations - allocs);
+
+    // H = H1*H2, its inverse and its adjoint
+    allocs = allocations;
+    t = yarp::os::Time::now();
+    for (int i = 0; i < times; i++) {
+        H = H1*H2;
+        Hinv = SE3inv(H);
+        A = adjoint(Hinv);
+    }
+    t = yarp::os::Time::now() - t;
+    report("operators: SE3inv/adjoint(H1*H2)", times, t, allocations - allocs);
+
+    allocs = allocations;
+    t = yarp::os::Time::now();
+    for (int i = 0; i < times; i++) {
+        mul(H1, H2, H);
+        SE3inv(H, Hinv);
+        adjoint(Hinv, A);
+    }
+    t = yarp::os::Time::now() - t;
+    report("in place:  SE3inv/adjoint(H1*H2)", times, t, allocations - allocs);
+
+    return 0;
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright: (C) 2016 iCub Facility - Istituto Italiano di Tecnologia
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ */
+
+// Compare pinv(), pinvDamped(), luinv() and det() against SVDSolver,
+// LUSolver and CholeskySolver reusing their storage, on the 6x7
+// Jacobian of an arm, counting heap allocations per iteration.
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include <yarp/sig/Vector.h>
+#include <yarp/sig/Matrix.h>
+#include <yarp/math/Math.h>
+#include <yarp/math/SVD.h>
+#include <yarp/math/LinearSolvers.h>
+#include <yarp/math/Rand.h>
+#include <yarp/os/Time.h>
+
+using namespace yarp::sig;
+using namespace yarp::math;
+
+static long allocations = 0;
+
+#if __cplusplus >= 201103L
+#  define NEW_THROWS
+#  define DELETE_THROWS noexcept
+#else
+#  define NEW_THROWS throw(std::bad_alloc)
+#  define DELETE_THROWS throw()
+#endif
+
+void *operator new(size_t size) NEW_THROWS
+{
+    allocations++;
+    void *p = malloc(size>0 ? size : 1);
+    if (p == NULL) throw std::bad_alloc();
+    return p;
+}
+
+void *operator new[](size_t size) NEW_THROWS
+{
+    return operator new(size);
+}
+
+void operator delete(void *p) DELETE_THROWS
+{
+    free(p);
+}
+
+void operator delete[](void *p) DELETE_THROWS
+{
+    free(p);
+}
+
+void report(const char *name, int times, double t, long allocs) {
+    printf("%-36s %8.3f us/iteration, %6.2f allocations/iteration\n",
+           name, 1e6*t/times, (double)allocs/times);
+}
+
+int main(int argc, char** argv) {
+    int times = 10000;
+    if (argc > 1) {
+        times = atoi(argv[1]);
+    }
+
+    Matrix J = Rand::matrix(6, 7);
+    Matrix A = J*J.transposed() + 0.01*eye(6);
+    Matrix Jinv, Ainv;
+    SVDSolver golub(6, 7);
+    SVDSolver jacobi(6, 7, SVDSolver::Jacobi);
+    LUSolver lu(6);
+    CholeskySolver chol(6);
+    double sink = 0.0;
+    long allocs;
+    double t;
+
+    // warm up, so that the outputs have the right size
+    golub.pinv(J, Jinv);
+    jacobi.pinv(J, Jinv);
+    lu.factorize(A);
+    lu.inverse(Ainv);
+
+    allocs = allocations;
+    t = yarp::os::Time::now();
+    for (int i = 0; i < times; i++) {
+        Jinv = pinv(J, 1e-6);
+    }
+    t = yarp::os::Time::now() - t;
+    report("pinv(J)", times, t, allocations - allocs);
+
+    allocs = allocations;
+    t = yarp::os::Time::now();
+    for (int i = 0; i < times; i++) {
+        golub.pinv(J, Jinv, 1e-6);
+    }
+    t = yarp::os::Time::now() - t;
+    report("SVDSolver::pinv(J), Golub-Reinsch", times, t, allocations - allocs);
+
+    allocs = allocations;
+    t = yarp::os::Time::now();
+    for (int i = 0; i < times; i++) {
+        jacobi.pinv(J, Jinv, 1e-6);
+    }
+    t = yarp::os::Time::now() - t;
+    report("SVDSolver::pinv(J), Jacobi", times, t, allocations - allocs);
+
+    allocs = allocations;
+    t = yarp::os::Time::now();
+    for (int i = 0; i < times; i++) {
+        Jinv = pinvDamped(J, 0.05);
+    }
+    t = yarp::os::Time::now() - t;
+    report("pinvDamped(J)", times, t, allocations - allocs);
+
+    allocs = allocations;
+    t = yarp::os::Time::now();
+    for (int i = 0; i < times; i++) {
+        jacobi.pinvDamped(J, Jinv, 0.05);
+    }
+    t = yarp::os::Time::now() - t;
+    report("SVDSolver::pinvDamped(J), Jacobi", times, t, allocations - allocs);
+
+    // inverse and determinant of J*J^T+lambda*I
+    allocs = allocations;
+    t = yarp::os::Time::now();
+    for (int i = 0; i < times; i++) {
+        Ainv = luinv(A);
+        sink += det(A);
+    }
+    t = yarp::os::Time::now() - t;
+    report("luinv(A), det(A)", times, t, allocations - allocs);
+
+    allocs = allocations;
+    t = yarp::os::Time::now();
+    for (int i = 0; i < times; i++) {
+        lu.factorize(A);
+        lu.inverse(Ainv);
+        sink += lu.det();
+    }
+    t = yarp::os::Time::now() - t;
+    report("LUSolver inverse, det", times, t, allocations - allocs);
+
+    allocs = allocations;
+    t = yarp::os::Time::now();
+    for (int i = 0; i < times; i++) {
+        chol.factorize(A);
+        chol.inverse(Ainv);
+    }
+    t = yarp::os::Time::now() - t;
+    report("CholeskySolver inverse", times, t, allocations - allocs);
+
+    printf("(checksum %g)\n", sink);
+    return 0;
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright: (C) 2016 iCub Facility - Istituto Italiano di Tecnologia
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ */
+
+// Compare the rotation and roto-translation functions working on
+// yarp::sig::Matrix against the fixed-size Rotation3, Transform3 and
+// Quaternion types.
+
+#include <cstdio>
+#include <cstdlib>
+
+#include <yarp/sig/Vector.h>
+#include <yarp/sig/Matrix.h>
+#include <yarp/math/Math.h>
+#include <yarp/math/Quaternion.h>
+#include <yarp/math/Rotation3.h>
+#include <yarp/math/Transform3.h>
+#include <yarp/os/Time.h>
+
+using namespace yarp::sig;
+using namespace yarp::math;
+
+// accumulated results, printed so that the loops are not optimized away
+static double sink = 0.0;
+
+void report(const char *name, int times, double t) {
+    printf("%-40s %8.3f us/iteration\n", name, 1e6*t/times);
+}
+
+int main(int argc, char** argv) {
+    int times = 100000;
+    if (argc > 1) {
+        times = atoi(argv[1]);
+    }
+
+    Vector rpy(3), axis(4);
+    rpy[0] = 0.1; rpy[1] = 0.2; rpy[2] = 0.3;
+    axis[0] = 0.0; axis[1] = 0.6; axis[2] = 0.8; axis[3] = 0.5;
+
+    Matrix H1 = rpy2dcm(rpy);
+    Matrix H2 = axis2dcm(axis);
+    H1(0, 3) = 0.1;
+    H2(2, 3) = -0.2;
+
+    Transform3 T1(H1), T2(H2);
+    double t;
+
+    // rpy -> rotation -> quaternion -> rotation -> rpy
+    t = yarp::os::Time::now();
+    for (int i = 0; i < times; i++) {
+        rpy[0] = 1e-6*i;
+        Vector v = dcm2rpy(quat2dcm(dcm2quat(rpy2dcm(rpy))));
+        sink += v[0];
+    }
+    t = yarp::os::Time::now() - t;
+    report("Matrix:     rpy->quat->rpy", times, t);
+
+    t = yarp::os::Time::now();
+    for (int i = 0; i < times; i++) {
+        double r, p, y;
+        Rotation3 R = Rotation3::fromRPY(1e-6*i, rpy[1], rpy[2]);
+        Rotation3(R.toQuaternion()).toRPY(r, p, y);
+        sink += r;
+    }
+    t = yarp::os::Time::now() - t;
+    report("Rotation3:  rpy->quat->rpy", times, t);
+
+    // axis/angle round trip
+    t = yarp::os::Time::now();
+    for (int i = 0; i < times; i++) {
+        axis[3] = 0.5 + 1e-6*i;
+        Vector v = dcm2axis(axis2dcm(axis));
+        sink += v[3];
+    }
+    t = yarp::os::Time::now() - t;
+    report("Matrix:     axis->dcm->axis", times, t);
+
+    t = yarp::os::Time::now();
+    for (int i = 0; i < times; i++) {
+        double v[4];
+        Rotation3::fromAxisAngle(axis[0], axis[1], axis[2], 0.5 + 1e-6*i).toAxisAngle(v);
+        sink += v[3];
+    }
+    t = yarp::os::Time::now() - t;
+    report("Rotation3:  axis->dcm->axis", times, t);
+
+    // chain of transforms, inverse and adjoint
+    t = yarp::os::Time::now();
+    for (int i = 0; i < times; i++) {
+        H1(0, 3) = 1e-6*i;
+        Matrix A = adjoint(SE3inv(H1*H2*H1));
+        sink += A(0, 5);
+    }
+    t = yarp::os::Time::now() - t;
+    report("Matrix:     adjoint(SE3inv(H1*H2*H1))", times, t);
+
+    t = yarp::os::Time::now();
+    for (int i = 0; i < times; i++) {
+        double A[36];
+        T1.translation()[0] = 1e-6*i;
+        (T1*T2*T1).inverse().adjoint(A);
+        sink += A[5];
+    }
+    t = yarp::os::Time::now() - t;
+    report("Transform3: adjoint(inverse(T1*T2*T1))", times, t);
+
+    // quaternion composition
+    Vector q1 = dcm2quat(H1), q2 = dcm2quat(H2);
+    t = yarp::os::Time::now();
+    for (int i = 0; i < times; i++) {
+        Vector q = dcm2quat(quat2dcm(q1)*quat2dcm(q2));
+        sink += q[0];
+    }
+    t = yarp::os::Time::now() - t;
+    report("Matrix:     quat(R(q1)*R(q2))", times, t);
+
+    Quaternion Q1(q1), Q2(q2);
+    t = yarp::os::Time::now();
+    for (int i = 0; i < times; i++) {
+        Quaternion q = Q1*Q2;
+        Q1[0] += 1e-12;
+        sink += q[0];
+    }
+    t = yarp::os::Time::now() - t;
+    report("Quaternion: q1*q2", times, t);
+
+    printf("(checksum %g)\n", sink);
+    return 0;
+}
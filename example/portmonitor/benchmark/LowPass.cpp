@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2016 iCub Facility
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ */
+
+#include <yarp/os/SharedLibraryClass.h>
+
+#include "LowPass.h"
+
+using namespace yarp::os;
+using namespace yarp::sig;
+
+
+bool LowPassMonitorObject::create(const yarp::os::Property& options)
+{
+    alpha = 0.1;
+    decimation = 1;
+    count = 0;
+    return true;
+}
+
+bool LowPassMonitorObject::setparam(const yarp::os::Property& params)
+{
+    alpha = params.check("alpha", Value(alpha)).asDouble();
+    decimation = params.check("decimation", Value(decimation)).asInt();
+    if(decimation < 1)
+        decimation = 1;
+    return true;
+}
+
+bool LowPassMonitorObject::getparam(yarp::os::Property& params)
+{
+    params.put("alpha", alpha);
+    params.put("decimation", decimation);
+    return true;
+}
+
+bool LowPassMonitorObject::acceptData(Vector& data)
+{
+    // the filter sees every message, the port only one in 'decimation'
+    if(state.size() != data.size())
+        state = data;
+    double *y = state.data();
+    const double *x = data.data();
+    for(size_t i=0; i<data.size(); i++)
+        y[i] += alpha*(x[i]-y[i]);
+    count = (count+1) % decimation;
+    return (count == 0);
+}
+
+void LowPassMonitorObject::updateData(Vector& data)
+{
+    data = state;
+}
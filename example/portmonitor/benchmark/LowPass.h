@@ -0,0 +1,35 @@
+/*
+ * Copyright (C) 2016 iCub Facility
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ */
+
+#ifndef LOWPASS_INC
+#define LOWPASS_INC
+
+#include <yarp/os/TypedMonitorObject.h>
+#include <yarp/sig/Vector.h>
+
+/**
+ * Low-pass filter and decimate a stream of vectors (e.g., encoders):
+ * only one message every 'decimation' is delivered, carrying the
+ * first order filtered value y = y + alpha*(x - y) of each element.
+ */
+class LowPassMonitorObject : public yarp::os::TypedMonitorObject<yarp::sig::Vector>
+{
+public:
+    bool create(const yarp::os::Property& options);
+
+    bool setparam(const yarp::os::Property& params);
+    bool getparam(yarp::os::Property& params);
+
+    bool acceptData(yarp::sig::Vector& data);
+    void updateData(yarp::sig::Vector& data);
+
+private:
+    double alpha;
+    int decimation;
+    int count;
+    yarp::sig::Vector state;
+};
+
+#endif
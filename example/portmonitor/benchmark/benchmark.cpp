@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2016 iCub Facility
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ */
+
+// Measure the per-message cost of a connection with no port monitor,
+// with the low-pass monitor as a dll and with the same monitor in Lua.
+// Everything runs in one process, no yarpserver is needed.
+
+#include <cstdio>
+
+#include <yarp/os/Network.h>
+#include <yarp/os/Port.h>
+#include <yarp/os/BufferedPort.h>
+#include <yarp/os/Property.h>
+#include <yarp/os/Time.h>
+#include <yarp/sig/Vector.h>
+
+using namespace yarp::os;
+using namespace yarp::sig;
+
+static bool run(const char *name, const ConstString& carrier,
+                int size, int count, double& perMessage)
+{
+    Port out;
+    BufferedPort<Vector> in;
+    in.setStrict();
+    if(!out.open("/benchmark/out") || !in.open("/benchmark/in"))
+        return false;
+    if(!Network::connect("/benchmark/out", "/benchmark/in", carrier))
+    {
+        printf("%-8s skipped, cannot connect with %s\n", name, carrier.c_str());
+        out.close();
+        in.close();
+        return false;
+    }
+
+    // a monitor that failed to load drops everything
+    Vector v(size, 0.0);
+    out.write(v);
+    double timeout = Time::now()+2.0;
+    while(in.read(false) == NULL && Time::now() < timeout)
+        Time::delay(0.01);
+    if(Time::now() >= timeout)
+    {
+        printf("%-8s skipped, no data through %s\n", name, carrier.c_str());
+        out.close();
+        in.close();
+        return false;
+    }
+
+    int warmup = count/10;
+    double start = 0;
+    for(int i=0; i<warmup+count; i++)
+    {
+        if(i == warmup)
+            start = Time::now();
+        for(int j=0; j<size; j++)
+            v[j] = i+j;
+        out.write(v);
+        in.read();
+    }
+    perMessage = (Time::now()-start)/count;
+
+    out.close();
+    in.close();
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    Network yarp;
+    Network::setLocalMode(true);
+
+    Property options;
+    options.fromCommand(argc, argv);
+    int size = options.check("size", Value(16)).asInt();
+    int count = options.check("count", Value(10000)).asInt();
+    ConstString dll = options.check("dll", Value("lowpass")).asString();
+    ConstString lua = options.check("lua", Value("lowpass.lua")).asString();
+
+    printf("%d messages of a Vector of %d elements\n", count, size);
+
+    double base = 0;
+    double t;
+    if(!run("none", "tcp", size, count, base))
+        return 1;
+    printf("%-8s %8.2f us/message\n", "none", 1e6*base);
+
+    if(run("dll", ConstString("tcp+recv.portmonitor+type.dll+file.") + dll,
+           size, count, t))
+        printf("%-8s %8.2f us/message, %8.2f us/message over none\n",
+               "dll", 1e6*t, 1e6*(t-base));
+
+    if(run("lua", ConstString("tcp+recv.portmonitor+type.lua+file.") + lua,
+           size, count, t))
+        printf("%-8s %8.2f us/message, %8.2f us/message over none\n",
+               "lua", 1e6*t, 1e6*(t-base));
+
+    return 0;
+}
@@ -0,0 +1,66 @@
+--
+-- Copyright (C) 2016 iCub Facility
+-- CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+--
+
+-- loading lua-yarp binding library
+require("yarp")
+
+--
+-- The Lua version of the LowPassMonitorObject from LowPass.cpp:
+-- low-pass filter and decimate a stream of yarp.Vector
+--
+
+PortMonitor.create = function(options)
+    PortMonitor.alpha = 0.1
+    PortMonitor.decimation = 1
+    PortMonitor.count = 0
+    PortMonitor.state = nil
+    return true
+end
+
+PortMonitor.accept = function(thing)
+    local vec = thing:asVector()
+    if vec == nil then
+        print("lowpass.lua: got wrong data type (expected type Vector)")
+        return false
+    end
+    local n = vec:size()
+    if PortMonitor.state == nil or #PortMonitor.state ~= n then
+        PortMonitor.state = {}
+        for i=0,n-1 do
+            PortMonitor.state[i+1] = vec:get(i)
+        end
+    end
+    local y = PortMonitor.state
+    local alpha = PortMonitor.alpha
+    for i=0,n-1 do
+        y[i+1] = y[i+1] + alpha*(vec:get(i) - y[i+1])
+    end
+    PortMonitor.count = (PortMonitor.count + 1) % PortMonitor.decimation
+    return PortMonitor.count == 0
+end
+
+PortMonitor.update = function(thing)
+    local vec = thing:asVector()
+    for i=0,vec:size()-1 do
+        vec:set(i, PortMonitor.state[i+1])
+    end
+    return thing
+end
+
+PortMonitor.setparam = function(property)
+    if property:check("alpha") then
+        PortMonitor.alpha = property:find("alpha"):asDouble()
+    end
+    if property:check("decimation") then
+        PortMonitor.decimation = math.max(1, property:find("decimation"):asInt())
+    end
+end
+
+PortMonitor.getparam = function()
+    local property = yarp.Property()
+    property:put("alpha", PortMonitor.alpha)
+    property:put("decimation", PortMonitor.decimation)
+    return property
+end
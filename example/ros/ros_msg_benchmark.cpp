@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2016 iCub Facility
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ */
+
+// Measure how fast sensor_msgs/JointState and sensor_msgs/LaserScan
+// messages can be serialized and published, building a new message
+// each cycle or reusing the one returned by prepare().
+// Everything runs in one process, no name server is needed.
+
+#include <stdio.h>
+#include <yarp/os/all.h>
+#include <yarp/os/impl/BufferedConnectionWriter.h>
+
+#include "sensor_msgs_JointState.h"
+#include "sensor_msgs_LaserScan.h"
+
+using namespace yarp::os;
+using namespace yarp::os::impl;
+
+static int seq = 0;
+
+static void fill(sensor_msgs_JointState& msg, int size) {
+    msg.name.resize(size);
+    msg.position.resize(size);
+    msg.velocity.resize(size);
+    msg.effort.resize(size);
+    for (int i=0; i<size; i++) {
+        if (msg.name[i].empty()) {
+            char buf[32];
+            sprintf(buf,"joint_%d",i);
+            msg.name[i] = buf;
+        }
+        msg.position[i] = seq+i;
+        msg.velocity[i] = seq-i;
+        msg.effort[i] = i;
+    }
+    msg.header.seq = seq++;
+}
+
+static void fill(sensor_msgs_LaserScan& msg, int size) {
+    msg.header.frame_id = "laser";
+    msg.ranges.resize(size);
+    msg.intensities.resize(size);
+    for (int i=0; i<size; i++) {
+        msg.ranges[i] = (float)(seq+i);
+        msg.intensities[i] = 0;
+    }
+    msg.header.seq = seq++;
+}
+
+static void report(const char *name, int count, double t) {
+    printf("%-40s %8.2f us/message %10.0f messages/s\n",
+           name, 1e6*t/count, count/t);
+}
+
+template <class T>
+static void serialize(const char *name, int size, int count, bool bare) {
+    BufferedConnectionWriter writer(false,bare);
+    char label[64];
+
+    double t = Time::now();
+    for (int i=0; i<count; i++) {
+        T msg;
+        fill(msg,size);
+        writer.restart();
+        msg.write(writer);
+    }
+    t = Time::now()-t;
+    sprintf(label,"%s %s, new message",name,bare?"ros":"yarp");
+    report(label,count,t);
+
+    T msg;
+    t = Time::now();
+    for (int i=0; i<count; i++) {
+        fill(msg,size);
+        writer.restart();
+        msg.write(writer);
+    }
+    t = Time::now()-t;
+    sprintf(label,"%s %s, reused message",name,bare?"ros":"yarp");
+    report(label,count,t);
+}
+
+template <class T>
+static void publish(const char *name, int size, int count) {
+    Port out;
+    BufferedPort<T> out_buffered;
+    BufferedPort<T> in;
+    in.setStrict();
+    char label[64];
+    if (!out.open("/benchmark/out") ||
+        !out_buffered.open("/benchmark/out_buffered") ||
+        !in.open("/benchmark/in")) {
+        return;
+    }
+    Network::connect("/benchmark/out","/benchmark/in");
+    Network::connect("/benchmark/out_buffered","/benchmark/in");
+
+    double t = Time::now();
+    for (int i=0; i<count; i++) {
+        T msg;
+        fill(msg,size);
+        out.write(msg);
+        in.read();
+    }
+    t = Time::now()-t;
+    sprintf(label,"%s publish, new message",name);
+    report(label,count,t);
+
+    t = Time::now();
+    for (int i=0; i<count; i++) {
+        T& msg = out_buffered.prepare();
+        fill(msg,size);
+        out_buffered.write(true);
+        in.read();
+    }
+    t = Time::now()-t;
+    sprintf(label,"%s publish, prepare()",name);
+    report(label,count,t);
+
+    out.close();
+    out_buffered.close();
+    in.close();
+}
+
+int main(int argc, char *argv[]) {
+    Network yarp;
+    Network::setLocalMode(true);
+
+    Property options;
+    options.fromCommand(argc,argv);
+    int joints = options.check("joints",Value(32)).asInt();
+    int ranges = options.check("ranges",Value(1081)).asInt();
+    int count = options.check("count",Value(10000)).asInt();
+
+    printf("JointState with %d joints, LaserScan with %d ranges, %d messages\n",
+           joints, ranges, count);
+    serialize<sensor_msgs_JointState>("JointState",joints,count,true);
+    serialize<sensor_msgs_JointState>("JointState",joints,count,false);
+    serialize<sensor_msgs_LaserScan>("LaserScan",ranges,count,true);
+    serialize<sensor_msgs_LaserScan>("LaserScan",ranges,count,false);
+    publish<sensor_msgs_JointState>("JointState",joints,count);
+    publish<sensor_msgs_LaserScan>("LaserScan",ranges,count);
+    return 0;
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2016 iCub Facility
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ */
+
+// Measure the time to receive a BGR image into an ImageOf<PixelRgb>,
+// which converts the pixels while reading, against receiving it into an
+// ImageOf<PixelBgr>, which does not.  The image is written once to a
+// DummyConnector and read back from memory, so only the cost of
+// Image::read is measured.
+//
+//   ./image_read_benchmark --width 1920 --height 1080 --count 200
+
+#include <cstdio>
+
+#include <yarp/os/DummyConnector.h>
+#include <yarp/os/Network.h>
+#include <yarp/os/Property.h>
+#include <yarp/os/Time.h>
+#include <yarp/sig/Image.h>
+
+using namespace yarp::os;
+using namespace yarp::sig;
+
+template <class T>
+static double run(DummyConnector& con, int count)
+{
+    ImageOf<T> dest;
+    dest.read(con.getReader());
+    double start = Time::now();
+    for (int i=0; i<count; i++)
+        dest.read(con.getReader());
+    return (Time::now()-start)/count;
+}
+
+int main(int argc, char *argv[])
+{
+    Network yarp;
+
+    Property options;
+    options.fromCommand(argc, argv);
+    int width = options.check("width", Value(1920)).asInt();
+    int height = options.check("height", Value(1080)).asInt();
+    int count = options.check("count", Value(200)).asInt();
+
+    ImageOf<PixelBgr> src;
+    src.resize(width, height);
+    for (int y=0; y<height; y++)
+        for (int x=0; x<width; x++)
+        {
+            PixelBgr& p = src.pixel(x, y);
+            p.r = x;
+            p.g = y;
+            p.b = x+y;
+        }
+
+    DummyConnector con;
+    src.write(con.getWriter());
+
+    printf("%d reads of a %dx%d BGR image\n", count, width, height);
+    printf("%-12s %8.3f ms/frame\n", "into BGR", 1e3*run<PixelBgr>(con, count));
+    printf("%-12s %8.3f ms/frame\n", "into RGB", 1e3*run<PixelRgb>(con, count));
+    return 0;
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2016 iCub Facility
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ */
+
+// Compare the methods of yarp::sig::resample::resize, on one and on
+// several threads, with the per-pixel nearest neighbour loop that
+// Image::copy(alt,w,h) used before.
+//
+//   ./image_resample_benchmark --width 1920 --height 1080 --to_width 320 --to_height 240 --threads 4
+
+#include <cstdio>
+#include <cstring>
+
+#include <yarp/os/Network.h>
+#include <yarp/os/Property.h>
+#include <yarp/os/Time.h>
+#include <yarp/sig/Image.h>
+#include <yarp/sig/ImageResample.h>
+
+using namespace yarp::os;
+using namespace yarp::sig;
+
+static void oldCopy(const Image& alt, Image& dest, int nw, int nh)
+{
+    dest.resize(nw, nh);
+    int d = dest.getPixelSize();
+    float di = ((float)alt.height())/nh;
+    float dj = ((float)alt.width())/nw;
+    for (int i=0; i<nh; i++)
+    {
+        int i0 = (int)(di*i);
+        for (int j=0; j<nw; j++)
+        {
+            int j0 = (int)(dj*j);
+            memcpy(dest.getPixelAddress(j,i), alt.getPixelAddress(j0,i0), d);
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    Network yarp;
+
+    Property options;
+    options.fromCommand(argc, argv);
+    int width = options.check("width", Value(1920)).asInt();
+    int height = options.check("height", Value(1080)).asInt();
+    int toWidth = options.check("to_width", Value(320)).asInt();
+    int toHeight = options.check("to_height", Value(240)).asInt();
+    int threads = options.check("threads", Value(4)).asInt();
+    int count = options.check("count", Value(50)).asInt();
+
+    ImageOf<PixelRgb> src, dest;
+    src.resize(width, height);
+    for (int y=0; y<height; y++)
+        for (int x=0; x<width; x++)
+            src(x, y) = PixelRgb(x, y, x+y);
+
+    printf("%dx%d RGB to %dx%d, %d runs\n", width, height, toWidth, toHeight, count);
+
+    double start = Time::now();
+    for (int i=0; i<count; i++)
+        oldCopy(src, dest, toWidth, toHeight);
+    printf("%-24s %8.3f ms\n", "old copy(alt,w,h)", 1e3*(Time::now()-start)/count);
+
+    const char *names[] = { "nearest", "area", "bilinear", "cubic" };
+    int methods[] = { resample::METHOD_NEAREST, resample::METHOD_AREA,
+                      resample::METHOD_BILINEAR, resample::METHOD_CUBIC };
+    for (int m=0; m<4; m++)
+    {
+        start = Time::now();
+        for (int i=0; i<count; i++)
+            resample::resize(src, dest, toWidth, toHeight, methods[m], 1);
+        double t1 = (Time::now()-start)/count;
+        start = Time::now();
+        for (int i=0; i<count; i++)
+            resample::resize(src, dest, toWidth, toHeight, methods[m], threads);
+        double tn = (Time::now()-start)/count;
+        printf("%-24s %8.3f ms, %8.3f ms on %d threads\n", names[m], 1e3*t1, 1e3*tn, threads);
+    }
+    return 0;
+}
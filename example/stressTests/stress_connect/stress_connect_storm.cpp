@@ -0,0 +1,63 @@
+/*
+ * Copyright: (C) 2016 iCub Facility - Istituto Italiano di Tecnologia
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ */
+
+// Time a burst of connections between many pairs of ports, as happens
+// when an application starts up.  Run it with and without the name
+// cache, e.g.:
+//   stress_connect_storm --pairs 500
+//   YARP_NAME_CACHE=60 stress_connect_storm --pairs 500
+
+#include <stdio.h>
+#include <yarp/os/all.h>
+
+using namespace yarp::os;
+
+int main(int argc, char *argv[]) {
+    Network yarp;
+
+    Property options;
+    options.fromCommand(argc,argv);
+    int pairs = options.check("pairs",Value(500)).asInt();
+    int rounds = options.check("rounds",Value(3)).asInt();
+
+    Port *src = new Port[pairs];
+    Port *dest = new Port[pairs];
+    double start = Time::now();
+    char buf[256];
+    for (int i=0; i<pairs; i++) {
+        sprintf(buf,"/stress/storm/src/%06d",i);
+        src[i].open(buf);
+        sprintf(buf,"/stress/storm/dest/%06d",i);
+        dest[i].open(buf);
+    }
+    printf("Opened %d ports in %g seconds\n", 2*pairs, Time::now()-start);
+
+    for (int r=0; r<rounds; r++) {
+        int fails = 0;
+        start = Time::now();
+        for (int i=0; i<pairs; i++) {
+            if (!Network::connect(src[i].getName(),dest[i].getName())) {
+                fails++;
+            }
+        }
+        double connect = Time::now()-start;
+        start = Time::now();
+        for (int i=0; i<pairs; i++) {
+            Network::disconnect(src[i].getName(),dest[i].getName());
+        }
+        double disconnect = Time::now()-start;
+        printf("Round %d: %d connections in %g seconds (%g ms each), %d failed; disconnected in %g seconds\n",
+               r, pairs, connect, 1000*connect/pairs, fails, disconnect);
+    }
+
+    for (int i=0; i<pairs; i++) {
+        src[i].close();
+        dest[i].close();
+    }
+    delete[] src;
+    delete[] dest;
+
+    return 0;
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2016 iCub Facility
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ *
+ */
+
+#include "ImageScaleCarrier.h"
+
+#include <yarp/os/Bottle.h>
+#include <yarp/os/ConnectionState.h>
+#include <yarp/os/Log.h>
+#include <yarp/os/Property.h>
+#include <yarp/sig/ImageResample.h>
+
+#include <string.h>
+
+using namespace yarp::os;
+using namespace yarp::sig;
+
+bool ImageScaleCarrier::configure(yarp::os::ConnectionState& proto) {
+    happy = false;
+    Property options;
+    options.fromString(proto.getSenderSpecifier().c_str());
+
+    width = options.check("w",Value(0)).asInt();
+    height = options.check("h",Value(0)).asInt();
+    if (width<0 || height<0) {
+        yError("imgscale: w and h cannot be negative");
+        return false;
+    }
+
+    Bottle& r = options.findGroup("roi");
+    roi = !r.isNull();
+    if (roi) {
+        if (r.size()!=5) {
+            yError("imgscale: roi needs x, y, width and height, e.g. roi.10.20.320.240");
+            return false;
+        }
+        roiX = r.get(1).asInt();
+        roiY = r.get(2).asInt();
+        roiW = r.get(3).asInt();
+        roiH = r.get(4).asInt();
+        if (roiW<=0 || roiH<=0) {
+            yError("imgscale: the roi must have a positive size");
+            return false;
+        }
+    }
+
+    ConstString m = options.check("method",Value("area")).asString();
+    if (m=="nearest") {
+        method = resample::METHOD_NEAREST;
+    } else if (m=="area") {
+        method = resample::METHOD_AREA;
+    } else if (m=="bilinear") {
+        method = resample::METHOD_BILINEAR;
+    } else if (m=="cubic") {
+        method = resample::METHOD_CUBIC;
+    } else {
+        yError("imgscale: method %s not recognized, try: nearest area bilinear cubic",
+               m.c_str());
+        return false;
+    }
+    happy = true;
+    return true;
+}
+
+bool ImageScaleCarrier::clip(const Image& img,
+                             int& x0, int& y0, int& x1, int& y1) {
+    x0 = (roiX>0)?roiX:0;
+    y0 = (roiY>0)?roiY:0;
+    x1 = (roiX+roiW<img.width())?roiX+roiW:img.width();
+    y1 = (roiY+roiH<img.height())?roiY+roiH:img.height();
+    return x0<x1 && y0<y1;
+}
+
+bool ImageScaleCarrier::acceptOutgoingData(yarp::os::PortWriter& writer) {
+    // nothing is sent on a connection with bad parameters
+    if (!happy) return false;
+    if (!roi) return true;
+    Image *img = dynamic_cast<Image*>(&writer);
+    if (img==NULL || img->width()==0) return true;
+    int x0, y0, x1, y1;
+    return clip(*img,x0,y0,x1,y1);
+}
+
+yarp::os::PortWriter& ImageScaleCarrier::modifyOutgoingData(yarp::os::PortWriter& writer) {
+    Image *img = dynamic_cast<Image*>(&writer);
+    if (img==NULL || img->width()==0 || img->height()==0) return writer;
+
+    const Image *src = img;
+    if (roi) {
+        int x0, y0, x1, y1;
+        if (!clip(*img,x0,y0,x1,y1)) return writer;
+        crop.setPixelCode(img->getPixelCode());
+        crop.setPixelSize(img->getPixelSize());
+        crop.setQuantum(img->getQuantum());
+        crop.resize(x1-x0,y1-y0);
+        size_t len = (size_t)(x1-x0)*img->getPixelSize();
+        for (int y=y0; y<y1; y++) {
+            memcpy(crop.getPixelAddress(0,y-y0),img->getPixelAddress(x0,y),len);
+        }
+        src = &crop;
+    }
+
+    int w = width;
+    int h = height;
+    if (w==0 && h==0) {
+        w = src->width();
+        h = src->height();
+    } else if (w==0) {
+        w = (int)((double)src->width()*h/src->height()+0.5);
+        if (w<1) w = 1;
+    } else if (h==0) {
+        h = (int)((double)src->height()*w/src->width()+0.5);
+        if (h<1) h = 1;
+    }
+    if (w==src->width() && h==src->height()) {
+        if (src==img) return writer;
+        return crop;
+    }
+
+    out.setPixelCode(src->getPixelCode());
+    out.setPixelSize(src->getPixelSize());
+    out.setQuantum(src->getQuantum());
+    if (!resample::resize(*src,out,w,h,method)) {
+        if (!warned) {
+            yWarning("imgscale: cannot resample images of this pixel type, sending them unscaled");
+            warned = true;
+        }
+        if (src==img) return writer;
+        return crop;
+    }
+    return out;
+}
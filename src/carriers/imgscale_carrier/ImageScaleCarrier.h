@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2016 iCub Facility
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ *
+ */
+
+#ifndef IMAGESCALECARRIER_INC
+#define IMAGESCALECARRIER_INC
+
+#include <yarp/os/ModifyingCarrier.h>
+#include <yarp/sig/Image.h>
+
+namespace yarp {
+    namespace os {
+        class ImageScaleCarrier;
+    }
+}
+
+
+/**
+ *
+ * Crop and/or resample images on the sending side of a connection,
+ * before they are serialized, so that a consumer needing a thumbnail
+ * or a region of interest does not receive (or decode) full frames.
+ * Other data is sent unchanged.  Affected by carrier modifiers.
+ * Examples:
+ *   tcp+send.imgscale+w.160+h.120
+ *   tcp+send.imgscale+w.160             (height keeps the aspect ratio)
+ *   tcp+send.imgscale+roi.100.50.320.240
+ *   tcp+send.imgscale+roi.100.50.320.240+w.80+method.bilinear
+ *
+ * The region of interest (x, y, width, height) is clipped to the image;
+ * frames it does not intersect are not sent on the connection.  The
+ * method is one of nearest, area (the default), bilinear and cubic, see
+ * yarp::sig::resample.  Nothing is sent on a connection with invalid
+ * parameters.
+ *
+ */
+class yarp::os::ImageScaleCarrier : public yarp::os::ModifyingCarrier {
+private:
+    int width, height;
+    bool roi;
+    int roiX, roiY, roiW, roiH;
+    int method;
+    bool happy;
+    bool warned;
+
+    yarp::sig::FlexImage crop;
+    yarp::sig::FlexImage out;
+
+    bool clip(const yarp::sig::Image& img,
+              int& x0, int& y0, int& x1, int& y1);
+public:
+    ImageScaleCarrier() {
+        width = height = 0;
+        roi = false;
+        roiX = roiY = roiW = roiH = 0;
+        method = 0;
+        happy = false;
+        warned = false;
+    }
+
+    virtual Carrier *create() {
+        return new ImageScaleCarrier();
+    }
+
+    virtual ConstString getName() {
+        return "imgscale";
+    }
+
+    virtual ConstString toString() {
+        return "imgscale_carrier";
+    }
+
+    virtual bool configure(yarp::os::ConnectionState& proto);
+
+    virtual bool modifiesIncomingData() {
+        return false;
+    }
+
+    virtual bool modifiesReply() {
+        return false;
+    }
+
+    virtual bool acceptOutgoingData(yarp::os::PortWriter& writer);
+
+    virtual yarp::os::PortWriter& modifyOutgoingData(yarp::os::PortWriter& writer);
+};
+
+#endif
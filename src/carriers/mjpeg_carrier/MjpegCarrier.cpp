@@ -46,6 +46,7 @@ extern "C" {
 #include <yarp/sig/Image.h>
 #include <yarp/sig/ImageNetworkHeader.h>
 #include <yarp/os/Name.h>
+#include <yarp/os/Bottle.h>
 #include <yarp/os/Bytes.h>
 
 #include "WireImage.h"
@@ -55,16 +56,6 @@ using namespace yarp::sig;
 
 #define dbg_printf if (0) printf
 
-typedef struct {
-    struct jpeg_destination_mgr pub;
-
-    JOCTET *buffer;
-    int bufsize;
-    JOCTET cache[1000000];  // need to make this variable...
-} net_destination_mgr;
-
-typedef net_destination_mgr *net_destination_ptr;
-
 void send_net_data(JOCTET *data, int len, void *client) {
     dbg_printf("Send %d bytes\n", len);
     ConnectionState *p = (ConnectionState *)client;
@@ -97,94 +88,45 @@ Content-Length: %d%s%s", brk, len, brk, brk);
 
 }
 
-static void init_net_destination(j_compress_ptr cinfo) {
-    //printf("Initializing destination\n");
-    net_destination_ptr dest = (net_destination_ptr)cinfo->dest;
-    dest->buffer = &(dest->cache[0]);
-    dest->bufsize = sizeof(dest->cache);
-    dest->pub.next_output_byte = dest->buffer;
-    dest->pub.free_in_buffer = dest->bufsize;
-}
-
-static boolean empty_net_output_buffer(j_compress_ptr cinfo) {
-    net_destination_ptr dest = (net_destination_ptr)cinfo->dest;
-    printf("Empty buffer - PROBLEM\n");
-    send_net_data(dest->buffer,dest->bufsize-dest->pub.free_in_buffer,
-                  cinfo->client_data);
-    dest->pub.next_output_byte = dest->buffer;
-    dest->pub.free_in_buffer = dest->bufsize;
-    return TRUE;
-}
-
-static void term_net_destination(j_compress_ptr cinfo) {
-    net_destination_ptr dest = (net_destination_ptr)cinfo->dest;
-    //printf("Terminating net %d %d\n", dest->bufsize,dest->pub.free_in_buffer);
-    send_net_data(dest->buffer,dest->bufsize-dest->pub.free_in_buffer,
-                  cinfo->client_data);
-}
-
-void jpeg_net_dest(j_compress_ptr cinfo) {
-    net_destination_ptr dest;
-
-      //ERREXIT(cinfo, JERR_BUFFER_SIZE);
-
-    /* The destination object is made permanent so that multiple JPEG images
-     * can be written to the same buffer without re-executing jpeg_net_dest.
-     */
-    if (cinfo->dest == NULL) {    /* first time for this JPEG object? */
-        cinfo->dest = (struct jpeg_destination_mgr *)
-            (*cinfo->mem->alloc_large) ((j_common_ptr) cinfo, JPOOL_PERMANENT,
-                                        sizeof(net_destination_mgr));
-    }
-
-    dest = (net_destination_ptr) cinfo->dest;
-    dest->pub.init_destination = init_net_destination;
-    dest->pub.empty_output_buffer = empty_net_output_buffer;
-    dest->pub.term_destination = term_net_destination;
-}
-
 bool MjpegCarrier::write(ConnectionState& proto, SizedWriter& writer) {
     WireImage rep;
     FlexImage *img = rep.checkForImage(writer);
 
     if (img==NULL) return false;
-    int w = img->width();
-    int h = img->height();
-    int row_stride = img->getRowSize();
-    JOCTET *data = (JOCTET*)img->getRawImage();
-
-    JSAMPROW row_pointer[1];
-
-    struct jpeg_compress_struct cinfo;
-    struct jpeg_error_mgr jerr;
-    cinfo.err = jpeg_std_error(&jerr);
-    cinfo.client_data = &proto;
-    jpeg_create_compress(&cinfo);
-    jpeg_net_dest(&cinfo);
-    cinfo.image_width = w;
-    cinfo.image_height = h;
-    cinfo.input_components = 3;
-    cinfo.in_color_space = JCS_RGB;
-    jpeg_set_defaults(&cinfo);
-    //jpeg_set_quality(&cinfo, 85, TRUE);
+
+    Bytes data;
     dbg_printf("Starting to compress...\n");
-    jpeg_start_compress(&cinfo, TRUE);
-    if(!envelope.empty()) {
-        jpeg_write_marker(&cinfo, JPEG_COM, reinterpret_cast<const JOCTET*>(envelope.c_str()), envelope.length() + 1);
-        envelope.clear();
+    if (!compression.compress(*img, envelope, data)) {
+        return false;
     }
-    dbg_printf("Done compressing (height %d)\n", cinfo.image_height);
-    while (cinfo.next_scanline < cinfo.image_height) {
-        dbg_printf("Writing row %d...\n", cinfo.next_scanline);
-        row_pointer[0] = data + cinfo.next_scanline * row_stride;
-        jpeg_write_scanlines(&cinfo, row_pointer, 1);
-    }
-    jpeg_finish_compress(&cinfo);
-    jpeg_destroy_compress(&cinfo);
+    envelope.clear();
+    dbg_printf("Done compressing (%d bytes)\n", (int)data.length());
+    send_net_data((JOCTET*)data.get(), data.length(), &proto);
 
     return true;
 }
 
+void MjpegCarrier::configure(const ConstString& request) {
+    // turn "...&key=value&..." into a list of key-value pairs
+    ConstString txt = request;
+    for (size_t i=0; i<txt.length(); i++) {
+        char ch = txt[i];
+        if (ch=='?' || ch=='&' || ch=='=' || ch=='\r') {
+            txt[i] = ' ';
+        }
+    }
+    Bottle b(txt.c_str());
+    if (b.check("quality")) {
+        compression.setQuality(b.find("quality").asInt());
+    }
+    if (b.check("subsampling")) {
+        compression.setSubsampling(b.find("subsampling").asInt());
+    }
+    if (b.check("threads")) {
+        compression.setThreads(b.find("threads").asInt());
+    }
+}
+
 bool MjpegCarrier::reply(ConnectionState& proto, SizedWriter& writer) {
     return false;
 }
@@ -193,11 +135,24 @@ bool MjpegCarrier::reply(ConnectionState& proto, SizedWriter& writer) {
 bool MjpegCarrier::sendHeader(ConnectionState& proto) {
     Name n(proto.getRoute().getCarrierName() + "://test");
     ConstString pathValue = n.getCarrierModifier("path");
-    ConstString target = "GET /?action=stream\n\n";
+    ConstString target = "GET /?action=stream";
     if (pathValue!="") {
         target = "GET /";
         target += pathValue;
     }
+    // compression settings go in the query, whichever the path
+    bool query = (target.find("?")!=ConstString::npos);
+    const char *settings[] = { "quality", "subsampling", "threads", NULL };
+    for (int i=0; settings[i]!=NULL; i++) {
+        ConstString value = n.getCarrierModifier(settings[i]);
+        if (value!="") {
+            target += ConstString(query?"&":"?") + settings[i] + "=" + value;
+            query = true;
+        }
+    }
+    if (pathValue=="") {
+        target += "\n\n";
+    }
     target += " HTTP/1.1\n";
     Contact host = proto.getRoute().getToContact();
     if (host.getHost()!="") {
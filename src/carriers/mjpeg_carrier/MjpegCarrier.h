@@ -11,6 +11,7 @@
 #include <yarp/os/Carrier.h>
 #include <yarp/os/NetType.h>
 #include "MjpegStream.h"
+#include "MjpegCompression.h"
 
 #include <string.h>
 
@@ -38,12 +39,24 @@ namespace yarp {
  * You can also view yarp image ports from a browser.  Do a "yarp name query /portname" to find their port number NNN, then go to:
  *   http://localhost:NNN/?output=stream
  *
+ * The sender keeps one encoder per connection.  Its settings can be
+ * chosen by the receiver, either as carrier modifiers:
+ *   yarp connect /src /dest mjpeg+quality.60+subsampling.422+threads.4
+ * or in the URL requested by a browser:
+ *   http://localhost:NNN/?action=stream&quality=60
+ * The quality is in [1,100] (75 by default), the chroma subsampling is
+ * one of 444, 422 or 420 (default), and with more than one thread each
+ * frame is encoded in stripes concurrently.
+ *
  */
 class yarp::os::MjpegCarrier : public Carrier {
 private:
     bool firstRound;
     bool sender;
     yarp::os::ConstString envelope;
+    yarp::mjpeg::MjpegCompression compression;
+
+    void configure(const ConstString& request);
 public:
     MjpegCarrier() {
         firstRound = true;
@@ -144,10 +157,12 @@ public:
     }
 
     virtual bool expectExtraHeader(ConnectionState& proto) {
-        ConstString txt;
-        do {
+        // the rest of the request line carries the encoder settings
+        ConstString txt = proto.is().readLine();
+        configure(txt);
+        while (txt!="") {
             txt = proto.is().readLine();
-        } while (txt!="");
+        }
         return true;
     }
 
@@ -0,0 +1,415 @@
+/*
+ * Copyright (C) 2016 iCub Facility - Istituto Italiano di Tecnologia
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ *
+ */
+
+#include <stdio.h>
+#include <vector>
+
+#ifdef WIN32
+#define INT32 long  // jpeg's definition
+#define QGLOBAL_H 1
+#endif
+
+#ifdef _MSC_VER
+#pragma warning (push)
+#pragma warning (disable : 4091)
+#endif
+
+extern "C" {
+#include <jpeglib.h>
+}
+
+#ifdef _MSC_VER
+#pragma warning (pop)
+#endif
+
+#ifdef WIN32
+#undef INT32
+#undef QGLOBAL_H
+#endif
+
+#include <setjmp.h>
+
+#include <yarp/os/Log.h>
+#include <yarp/os/Semaphore.h>
+#include <yarp/os/Thread.h>
+#include <yarp/sig/Image.h>
+#include "MjpegCompression.h"
+
+using namespace yarp::os;
+using namespace yarp::sig;
+using namespace yarp::mjpeg;
+
+struct mem_error_mgr {
+    struct jpeg_error_mgr pub;
+    jmp_buf setjmp_buffer;
+};
+typedef struct mem_error_mgr *mem_error_ptr;
+
+static void mem_error_exit(j_common_ptr cinfo) {
+    mem_error_ptr myerr = (mem_error_ptr) cinfo->err;
+    (*cinfo->err->output_message) (cinfo);
+    longjmp(myerr->setjmp_buffer, 1);
+}
+
+// destination manager appending to a buffer that is kept across frames
+struct mem_destination_mgr {
+    struct jpeg_destination_mgr pub;
+    std::vector<JOCTET> *buffer;
+    size_t used;
+};
+typedef struct mem_destination_mgr *mem_destination_ptr;
+
+static void init_mem_destination(j_compress_ptr cinfo) {
+    mem_destination_ptr dest = (mem_destination_ptr) cinfo->dest;
+    if (dest->buffer->size()<65536) {
+        dest->buffer->resize(65536);
+    }
+    dest->pub.next_output_byte = &(*dest->buffer)[0];
+    dest->pub.free_in_buffer = dest->buffer->size();
+    dest->used = 0;
+}
+
+static boolean empty_mem_output_buffer(j_compress_ptr cinfo) {
+    mem_destination_ptr dest = (mem_destination_ptr) cinfo->dest;
+    size_t len = dest->buffer->size();
+    dest->buffer->resize(2*len);
+    dest->pub.next_output_byte = &(*dest->buffer)[len];
+    dest->pub.free_in_buffer = len;
+    return TRUE;
+}
+
+static void term_mem_destination(j_compress_ptr cinfo) {
+    mem_destination_ptr dest = (mem_destination_ptr) cinfo->dest;
+    dest->used = dest->buffer->size()-dest->pub.free_in_buffer;
+}
+
+
+/**
+ *
+ * A persistent libjpeg compressor for rgb rows.
+ *
+ */
+class MjpegEncoder {
+public:
+    struct jpeg_compress_struct cinfo;
+    struct mem_error_mgr jerr;
+    struct mem_destination_mgr dest;
+    std::vector<JOCTET> buffer;
+    bool ok;
+
+    MjpegEncoder() : ok(false) {
+        cinfo.err = jpeg_std_error(&jerr.pub);
+        jerr.pub.error_exit = mem_error_exit;
+        jpeg_create_compress(&cinfo);
+        dest.pub.init_destination = init_mem_destination;
+        dest.pub.empty_output_buffer = empty_mem_output_buffer;
+        dest.pub.term_destination = term_mem_destination;
+        dest.buffer = &buffer;
+        dest.used = 0;
+        cinfo.dest = &dest.pub;
+        cinfo.input_components = 3;
+        cinfo.in_color_space = JCS_RGB;
+        jpeg_set_defaults(&cinfo);
+    }
+
+    ~MjpegEncoder() {
+        jpeg_destroy_compress(&cinfo);
+    }
+
+    void configure(int quality, int subsampling) {
+        // stripes are joined only if their huffman tables match, so
+        // the standard tables are kept (no optimize_coding)
+        jpeg_set_quality(&cinfo, (quality>0)?quality:75, TRUE);
+        cinfo.comp_info[0].h_samp_factor = (subsampling==444)?1:2;
+        cinfo.comp_info[0].v_samp_factor = (subsampling==420)?2:1;
+    }
+
+    bool encode(const Image& img, int row0, int rows,
+                const ConstString& comment) {
+        ok = false;
+        if (setjmp(jerr.setjmp_buffer)) {
+            jpeg_abort_compress(&cinfo);
+            return false;
+        }
+        cinfo.image_width = img.width();
+        cinfo.image_height = rows;
+        jpeg_start_compress(&cinfo, TRUE);
+        if (!comment.empty()) {
+            jpeg_write_marker(&cinfo, JPEG_COM,
+                              reinterpret_cast<const JOCTET*>(comment.c_str()),
+                              comment.length() + 1);
+        }
+        JSAMPROW row_pointer[1];
+        while (cinfo.next_scanline < cinfo.image_height) {
+            row_pointer[0] = (JSAMPROW)img.getRow(row0 + cinfo.next_scanline);
+            jpeg_write_scanlines(&cinfo, row_pointer, 1);
+        }
+        jpeg_finish_compress(&cinfo);
+        ok = true;
+        return true;
+    }
+
+    const JOCTET *data() const {
+        return &buffer[0];
+    }
+
+    size_t length() const {
+        return dest.used;
+    }
+};
+
+
+/**
+ *
+ * A thread encoding one stripe of each frame.
+ *
+ */
+class MjpegStripeWorker : public Thread {
+public:
+    MjpegEncoder encoder;
+    Semaphore go;
+    Semaphore done;
+    const Image *image;
+    int row0;
+    int rows;
+    bool closing;
+
+    MjpegStripeWorker() : go(0), done(0), image(NULL), row0(0), rows(0),
+                          closing(false) {
+    }
+
+    virtual void run() {
+        while (true) {
+            go.wait();
+            if (closing) {
+                break;
+            }
+            encoder.encode(*image, row0, rows, "");
+            done.post();
+        }
+    }
+
+    virtual void onStop() {
+        closing = true;
+        go.post();
+    }
+};
+
+
+// locate the SOF0 and SOS markers of a baseline JPEG
+static bool findScan(const JOCTET *data, size_t len, size_t& sof, size_t& sos,
+                     size_t& sosLen) {
+    if (len<4 || data[0]!=0xFF || data[1]!=0xD8) { // SOI
+        return false;
+    }
+    size_t at = 2;
+    sof = 0;
+    while (at+4<=len) {
+        if (data[at]!=0xFF) {
+            return false;
+        }
+        int marker = data[at+1];
+        size_t segLen = (data[at+2]<<8)|data[at+3];
+        if (marker==0xC0) {
+            sof = at;
+        } else if (marker==0xDA) {
+            sos = at;
+            sosLen = 2+segLen;
+            return (sof!=0) && (sos+sosLen+2<=len);
+        }
+        at += 2+segLen;
+    }
+    return false;
+}
+
+
+class MjpegCompressionHelper {
+public:
+    int quality;
+    int subsampling;
+    int threads;
+    bool dirty;
+    MjpegEncoder encoder;
+    std::vector<MjpegStripeWorker*> workers;
+    std::vector<JOCTET> joined;
+    ImageOf<PixelRgb> rgb;
+
+    MjpegCompressionHelper() : quality(-1), subsampling(420), threads(1),
+                               dirty(true) {
+    }
+
+    ~MjpegCompressionHelper() {
+        resizeWorkers(0);
+    }
+
+    void resizeWorkers(size_t n) {
+        while (workers.size()>n) {
+            workers.back()->stop();
+            delete workers.back();
+            workers.pop_back();
+        }
+        while (workers.size()<n) {
+            MjpegStripeWorker *worker = new MjpegStripeWorker;
+            yAssert(worker!=NULL);
+            worker->encoder.configure(quality, subsampling);
+            if (!worker->start()) {
+                delete worker;
+                break;
+            }
+            workers.push_back(worker);
+        }
+    }
+
+    bool compress(const Image& image, const ConstString& comment,
+                  Bytes& result) {
+        const Image *img = &image;
+        if (image.getPixelCode()!=VOCAB_PIXEL_RGB) {
+            rgb.copy(image);
+            img = &rgb;
+        }
+        int w = img->width();
+        int h = img->height();
+        if (w<=0 || h<=0) {
+            return false;
+        }
+
+        if (dirty) {
+            encoder.configure(quality, subsampling);
+            for (size_t i=0; i<workers.size(); i++) {
+                workers[i]->encoder.configure(quality, subsampling);
+            }
+            dirty = false;
+        }
+
+        // if not every worker could be started, keep encoding with the
+        // ones we have rather than dropping the stream
+        if (threads>1) {
+            resizeWorkers(threads-1);
+            if ((int)workers.size()<threads-1) {
+                yWarning("mjpeg: started %d of %d encoder threads, using fewer stripes",
+                         (int)workers.size()+1, threads);
+                threads = (int)workers.size()+1;
+            }
+        }
+
+        // stripes span whole MCU rows, and every stripe but the last
+        // is a restart interval of the joined frame
+        int mcuW = (subsampling==444)?8:16;
+        int mcuH = (subsampling==420)?16:8;
+        int stripeRows = ((h+threads-1)/threads+mcuH-1)/mcuH*mcuH;
+        int interval = (stripeRows/mcuH)*((w+mcuW-1)/mcuW);
+        int stripes = (h+stripeRows-1)/stripeRows;
+        if (threads<=1 || stripes<=1 || interval>65535) {
+            if (!encoder.encode(*img, 0, h, comment)) {
+                return false;
+            }
+            result = Bytes((char*)encoder.data(), encoder.length());
+            return true;
+        }
+
+        for (int k=1; k<stripes; k++) {
+            MjpegStripeWorker& worker = *workers[k-1];
+            worker.image = img;
+            worker.row0 = k*stripeRows;
+            worker.rows = (h-worker.row0<stripeRows)?(h-worker.row0):stripeRows;
+            worker.go.post();
+        }
+        bool ok = encoder.encode(*img, 0, stripeRows, comment);
+        for (int k=1; k<stripes; k++) {
+            workers[k-1]->done.wait();
+            ok = ok && workers[k-1]->encoder.ok;
+        }
+        if (!ok) {
+            return false;
+        }
+        if (!join(h, interval, stripes)) {
+            return false;
+        }
+        result = Bytes((char*)&joined[0], joined.size());
+        return true;
+    }
+
+    bool join(int h, int interval, int stripes) {
+        size_t sof, sos, sosLen;
+        const JOCTET *head = encoder.data();
+        size_t headLen = encoder.length();
+        if (!findScan(head, headLen, sof, sos, sosLen)) {
+            return false;
+        }
+
+        // headers of the first stripe, with the full height and
+        // the restart interval
+        joined.assign(head, head+sos);
+        joined[sof+5] = (JOCTET)(h>>8);
+        joined[sof+6] = (JOCTET)(h&0xFF);
+        const JOCTET dri[6] = { 0xFF, 0xDD, 0x00, 0x04,
+                                (JOCTET)(interval>>8),
+                                (JOCTET)(interval&0xFF) };
+        joined.insert(joined.end(), dri, dri+6);
+
+        // scan header and entropy-coded data of each stripe, without EOI
+        joined.insert(joined.end(), head+sos, head+headLen-2);
+        for (int k=1; k<stripes; k++) {
+            const MjpegEncoder& part = workers[k-1]->encoder;
+            size_t partSof, partSos, partSosLen;
+            if (!findScan(part.data(), part.length(), partSof, partSos,
+                          partSosLen)) {
+                return false;
+            }
+            joined.push_back(0xFF);
+            joined.push_back((JOCTET)(0xD0+((k-1)&7)));
+            joined.insert(joined.end(), part.data()+partSos+partSosLen,
+                          part.data()+part.length()-2);
+        }
+        joined.push_back(0xFF);
+        joined.push_back(JPEG_EOI);
+        return true;
+    }
+};
+
+#define HELPER(x) (*((MjpegCompressionHelper*)(x)))
+
+MjpegCompression::MjpegCompression() {
+    system_resource = new MjpegCompressionHelper;
+    yAssert(system_resource!=NULL);
+}
+
+MjpegCompression::~MjpegCompression() {
+    if (system_resource!=NULL) {
+        delete &HELPER(system_resource);
+        system_resource = NULL;
+    }
+}
+
+void MjpegCompression::setQuality(int quality) {
+    MjpegCompressionHelper& helper = HELPER(system_resource);
+    if (quality>100) {
+        quality = 100;
+    }
+    helper.dirty = helper.dirty || (quality!=helper.quality);
+    helper.quality = quality;
+}
+
+void MjpegCompression::setSubsampling(int subsampling) {
+    MjpegCompressionHelper& helper = HELPER(system_resource);
+    if (subsampling!=444 && subsampling!=422) {
+        subsampling = 420;
+    }
+    helper.dirty = helper.dirty || (subsampling!=helper.subsampling);
+    helper.subsampling = subsampling;
+}
+
+void MjpegCompression::setThreads(int threads) {
+    MjpegCompressionHelper& helper = HELPER(system_resource);
+    helper.threads = (threads>1)?threads:1;
+}
+
+bool MjpegCompression::compress(const Image& image,
+                                const ConstString& comment,
+                                Bytes& result) {
+    MjpegCompressionHelper& helper = HELPER(system_resource);
+    return helper.compress(image, comment, result);
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2016 iCub Facility - Istituto Italiano di Tecnologia
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ *
+ */
+
+#ifndef YARP2_MJPEGCOMPRESSION_INC
+#define YARP2_MJPEGCOMPRESSION_INC
+
+#include <yarp/os/Bytes.h>
+#include <yarp/os/ConstString.h>
+#include <yarp/sig/Image.h>
+
+namespace yarp {
+    namespace mjpeg {
+        class MjpegCompression;
+    }
+}
+
+/**
+ *
+ * A JPEG encoder that keeps its libjpeg state across frames.
+ *
+ * With more than one thread, the frame is cut into horizontal stripes
+ * that are encoded concurrently and joined into a single baseline JPEG
+ * by means of restart markers, so any decoder can read it.
+ *
+ */
+class yarp::mjpeg::MjpegCompression {
+private:
+    void *system_resource;
+public:
+    MjpegCompression();
+
+    virtual ~MjpegCompression();
+
+    /**
+     * @param quality JPEG quality in [1,100] (libjpeg default is 75)
+     */
+    void setQuality(int quality);
+
+    /**
+     * @param subsampling chroma subsampling: 444, 422 or 420 (default)
+     */
+    void setSubsampling(int subsampling);
+
+    /**
+     * @param threads number of threads encoding each frame (default 1)
+     */
+    void setThreads(int threads);
+
+    /**
+     *
+     * Encode an rgb image.
+     * @param image the image to encode
+     * @param comment text stored in a COM marker, if not empty
+     * @param result set to the encoded frame, valid until the next call
+     * @return true on success
+     *
+     */
+    bool compress(const yarp::sig::Image& image,
+                  const yarp::os::ConstString& comment,
+                  yarp::os::Bytes& result);
+};
+
+#endif
@@ -40,6 +40,8 @@ using namespace yarp::os;
 using namespace yarp::sig;
 using namespace yarp::mjpeg;
 
+#define MJPEG_MAX_ROWS 16
+
 struct net_error_mgr {
     struct jpeg_error_mgr pub;
     jmp_buf setjmp_buffer;
@@ -135,7 +137,13 @@ public:
     }
 
     void init() {
+        // the error manager and the source are set up once, the
+        // frames only reset the data pointers
+        cinfo.err = jpeg_std_error(&jerr.pub);
+        jerr.pub.error_exit = net_error_exit;
         jpeg_create_decompress(&cinfo);
+        cinfo.client_data = &error_buffer;
+        jpeg_save_markers(&cinfo, JPEG_COM, 0xFFFF);
     }
 
     bool decompress(const Bytes& cimg, ImageOf<PixelRgb>& img) {
@@ -145,30 +153,33 @@ public:
             init();
             active = true;
         }
-        cinfo.client_data = &error_buffer;
-        cinfo.err = jpeg_std_error(&jerr.pub);
-        jerr.pub.error_exit = net_error_exit;
-
         if (setjmp(jerr.setjmp_buffer)) {
-            jpeg_finish_decompress(&cinfo);
+            jpeg_abort_decompress(&cinfo);
             return false;
         }
 
         jpeg_net_src(&cinfo,cimg.get(),cimg.length());
-        jpeg_save_markers(&cinfo, JPEG_COM, 0xFFFF);
         jpeg_read_header(&cinfo, TRUE);
+        cinfo.out_color_space = JCS_RGB;
         jpeg_calc_output_dimensions(&cinfo);
         if (debug) printf("Got image %dx%d\n", cinfo.output_width, cinfo.output_height);
         img.resize(cinfo.output_width,cinfo.output_height);
         jpeg_start_decompress(&cinfo);
         //int row_stride = cinfo.output_width * cinfo.output_components;
 
-        int at = 0;
+        // decode straight into the rows of the image, as many
+        // at a time as the decoder can deliver
+        JSAMPLE *lines[MJPEG_MAX_ROWS];
         while (cinfo.output_scanline < cinfo.output_height) {
-            JSAMPLE *lines[1];
-            lines[0] = (JSAMPLE*)(&img.pixel(0,at));
-            jpeg_read_scanlines(&cinfo, lines, 1);
-            at++;
+            int at = cinfo.output_scanline;
+            int n = cinfo.output_height-at;
+            if (n>MJPEG_MAX_ROWS) {
+                n = MJPEG_MAX_ROWS;
+            }
+            for (int i=0; i<n; i++) {
+                lines[i] = (JSAMPLE*)(img.getRow(at+i));
+            }
+            jpeg_read_scanlines(&cinfo, lines, n);
         }
         if(readEnvelopeCallback && cinfo.marker_list && cinfo.marker_list->data_length > 0) {
             Bytes envelope(reinterpret_cast<char*>(cinfo.marker_list->data), cinfo.marker_list->data_length);
@@ -76,9 +76,11 @@ YARP_SSIZE_T MjpegStream::read(const Bytes& b) {
             }
         } while (s.length()>0);
         if (autocompress) {
-            cimg.allocate(len);
-            delegate->getInputStream().readFull(cimg.bytes());
-            if (!decompression.decompress(cimg.bytes(), img)) {
+            // the buffer is kept across frames, and only grows
+            cimg.allocateOnNeed(len,len);
+            cimg.setUsed(len);
+            delegate->getInputStream().readFull(cimg.usedBytes());
+            if (!decompression.decompress(cimg.usedBytes(), img)) {
                 if (delegate->getInputStream().isOk()) {
                     yError("Skipping a problematic JPEG frame");
                 }
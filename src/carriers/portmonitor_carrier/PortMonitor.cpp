@@ -31,8 +31,11 @@ bool PortMonitor::configure(yarp::os::ConnectionState& proto)
     Property options;
     options.fromString(proto.getSenderSpecifier().c_str());
 
+    PortMonitor::lock();
+    bReady = false;
     if(binder) delete binder;
     binder = NULL;
+    PortMonitor::unlock();
 
     ConstString script = options.check("type", Value("lua")).asString();
     ConstString filename = options.check("file", Value("modifier")).asString();
@@ -41,14 +44,15 @@ bool PortMonitor::configure(yarp::os::ConnectionState& proto)
     ConstString context = options.check("context", Value("")).asString();
 
     // check which monitor should be used
-    if((binder = MonitorBinding::create(script.c_str())) == NULL)
+    MonitorBinding* newBinder = MonitorBinding::create(script.c_str());
+    if(newBinder == NULL)
     {
          yError("Currently only \'lua\' script and \'dll\' object is supported by portmonitor");
          return false;
     }
 
     // set the acceptance constraint
-    binder->setAcceptConstraint(constraint.c_str());
+    newBinder->setAcceptConstraint(constraint.c_str());
 
     ConstString strFile = filename;
 
@@ -76,8 +80,10 @@ bool PortMonitor::configure(yarp::os::ConnectionState& proto)
     info.put("destination", portName);
     info.put("carrier", proto.getRoute().getCarrierName());
 
+    bool loaded = newBinder->load(info);
     PortMonitor::lock();
-    bReady =  binder->load(info);
+    binder = newBinder;
+    bReady = loaded;
     PortMonitor::unlock();
     return bReady;
 }
@@ -106,17 +112,21 @@ yarp::os::ConnectionReader& PortMonitor::modifyIncomingData(yarp::os::Connection
     // When we are here,
     // the incoming data should be accessed using localReader.
     // The reader passed to this function is infact empty.
-    // first check if we need to call the update callback
-    if(!binder->hasUpdate())
+    // inThing still refers to it and, if the accept callback has
+    // already read the data, holds the typed object as well.
+    yarp::os::Things* result = &inThing;
+    if(binder->hasUpdate())
+        result = &binder->updateData(inThing);
+
+    // nothing has been read or replaced, the data goes through as it is
+    if(result == &inThing && !inThing.hasBeenRead())
         return *localReader;
 
-    PortMonitor::lock();
-    yarp::os::Things thing;    
-    thing.setConnectionReader(*localReader);
-    yarp::os::Things& result = binder->updateData(thing);
-    PortMonitor::unlock();
+    // The port reads the result directly from the buffers it is
+    // written to, so it must stay alive until the next message;
+    // inThing and the binding's own Things do.
     con.reset();
-    if(result.write(con.getWriter()))
+    if(result->write(con.getWriter()))
         return con.getReader();
     return *localReader;
 }
@@ -127,33 +137,26 @@ bool PortMonitor::acceptIncomingData(yarp::os::ConnectionReader& reader)
 
     bool result;
     localReader = &reader;
-    // If no accept callback avoid calling the binder
+    inThing.reset();
+    // set the reference connection reader
+    inThing.setConnectionReader(reader);
+
+    // If no accept callback avoid calling the binder.
+    // When data is read by the accept callback, it wont be available
+    // from the reader anymore; the typed object is kept in inThing
+    // and passed to modifyIncomingData().
     if(binder->hasAccept())
     {
-        PortMonitor::lock();
-        Things thing;
-        // set the reference connection reader
-        thing.setConnectionReader(reader);
-        result = binder->acceptData(thing);
-        PortMonitor::unlock();
-        if(!result)
+        if(!binder->acceptData(inThing))
             return false;
-
-        // When data is read here using the reader passed to this functions,
-        // then it wont be available for modifyIncomingData(). Thus, we write
-        // it to a dumy connection and pass it to the modifyOutgoingData() using
-        // localReader.
-        // localReader points to a connection reader which contains
-        // either the original or modified data.
-        if(thing.hasBeenRead()) {
-            con.reset();
-            if(thing.write(con.getWriter()))
-                localReader = &con.getReader();
-        }
     }
 
-    getPeers().lock();
+    // a monitor alone on its port has no peers to trigger
     yAssert(group);
+    if(group->getMemberCount() < 2)
+        return binder->canAccept();
+
+    getPeers().lock();
     result = group->acceptIncomingData(this);
     getPeers().unlock();
     return result;
@@ -168,11 +171,9 @@ yarp::os::PortWriter& PortMonitor::modifyOutgoingData(yarp::os::PortWriter& writ
     if(!binder->hasUpdate())
         return writer;
 
-    PortMonitor::lock();
     thing.reset();
     thing.setPortWriter(&writer);
     yarp::os::Things& result = binder->updateData(thing);
-    PortMonitor::unlock();
     return *result.getPortWriter();
 }
 
@@ -184,12 +185,9 @@ bool PortMonitor::acceptOutgoingData(yarp::os::PortWriter& writer)
     if(!binder->hasAccept())
         return true;
 
-    PortMonitor::lock();
     yarp::os::Things thing;
     thing.setPortWriter(&writer);
-    bool result = binder->acceptData(thing);
-    PortMonitor::unlock();
-    return result;
+    return binder->acceptData(thing);
 }
 
 yarp::os::PortReader& PortMonitor::modifyReply(yarp::os::PortReader& reader) {
@@ -200,11 +198,9 @@ yarp::os::PortReader& PortMonitor::modifyReply(yarp::os::PortReader& reader) {
     if(!binder->hasUpdateReply())
         return reader;
 
-    PortMonitor::lock();
     thing.reset();
     thing.setPortReader(&reader);
     yarp::os::Things& result = binder->updateReply(thing);
-    PortMonitor::unlock();
     return *result.getPortReader();
 }
 
@@ -14,6 +14,7 @@
 #include <yarp/os/NullConnectionReader.h>
 #include <yarp/os/Semaphore.h>
 #include <yarp/os/Things.h>
+#include <yarp/os/impl/AtomicCounter.h>
 
 #include "MonitorBinding.h"
 #include "MonitorEvent.h"
@@ -33,8 +34,36 @@ namespace yarp {
 
 class yarp::os::PortMonitorGroup : public PeerRecord<PortMonitor> {
 public:
+    PortMonitorGroup() {}
+    PortMonitorGroup(const PortMonitorGroup& alt) : PeerRecord<PortMonitor>(alt) {}
+    const PortMonitorGroup& operator=(const PortMonitorGroup& alt) {
+        return *this;
+    }
     virtual ~PortMonitorGroup() {}
     virtual bool acceptIncomingData(PortMonitor *source);
+
+    // called with the election locked
+    void add(PortMonitor *entity) {
+        PeerRecord<PortMonitor>::add(entity);
+        members.set((int)peerSet.size());
+    }
+
+    void remove(PortMonitor *entity) {
+        PeerRecord<PortMonitor>::remove(entity);
+        members.set((int)peerSet.size());
+    }
+
+    /**
+     * Number of monitors on connections to the same port.  Can be
+     * read without locking the election, so that a lone monitor
+     * does not need to.
+     */
+    int getMemberCount() {
+        return members.get();
+    }
+
+private:
+    yarp::os::impl::AtomicCounter members;
 };
 
 
@@ -46,6 +75,13 @@ public:
  *
  * Examples: tcp+recv.portmonitor+type.lua+file.my_lua_script_file
  *
+ * On the receiving side the data is deserialized at most once: the
+ * typed object built by the accept callback is handed to the update
+ * callback, and the result is read by the port straight out of the
+ * buffers it was serialized into.  The bindings serialize their own
+ * callbacks, so the monitor lock is only taken to configure the
+ * binding and to trigger peers.
+ *
  */
 
 /**
@@ -127,6 +163,7 @@ private:
     yarp::os::DummyConnector con;
     yarp::os::ConnectionReader* localReader;
     yarp::os::Things thing;
+    yarp::os::Things inThing;
     MonitorBinding* binder;
     PortMonitorGroup *group;    
     yarp::os::Semaphore mutex; 
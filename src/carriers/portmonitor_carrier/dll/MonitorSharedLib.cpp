@@ -8,6 +8,7 @@
 #include <yarp/os/Network.h>
 #include <yarp/os/Log.h>
 #include <yarp/os/YarpPlugin.h>
+#include <yarp/os/LockGuard.h>
 
 #include "MonitorSharedLib.h"
 
@@ -68,33 +69,39 @@ bool MonitorSharedLib::load(const yarp::os::Property& options)
 
 bool MonitorSharedLib::setParams(const Property &params)
 {
+    LockGuard guard(mutex);
     return monitor->setparam(params);
 }
 
 bool MonitorSharedLib::getParams(yarp::os::Property& params)
 {
+    LockGuard guard(mutex);
     return monitor->getparam(params);
 }
 
 bool MonitorSharedLib::acceptData(yarp::os::Things& thing)
 {
+    LockGuard guard(mutex);
     return monitor->accept(thing);
 }
 
 
 yarp::os::Things& MonitorSharedLib::updateData(Things &thing)
 {
+    LockGuard guard(mutex);
     return monitor->update(thing);
 }
 
 yarp::os::Things& MonitorSharedLib::updateReply(Things &thing)
 {
+    LockGuard guard(mutex);
     return monitor->updateReply(thing);
 }
 
 
 bool MonitorSharedLib::peerTrigged(void)
 {
+    LockGuard guard(mutex);
     monitor->trig();
     return true;
 }
@@ -13,6 +13,7 @@
 #include <yarp/os/SharedLibraryClass.h>
 #include <yarp/os/SharedLibrary.h>
 #include <yarp/os/YarpPlugin.h>
+#include <yarp/os/Mutex.h>
 
 #include <yarp/os/MonitorObject.h>
 #include "MonitorBinding.h"
@@ -55,6 +56,9 @@ private:
     yarp::os::YarpPluginSettings settings;
     yarp::os::YarpPlugin<yarp::os::MonitorObject> plugin;
     yarp::os::SharedLibraryClass<yarp::os::MonitorObject> monitor;
+    // the monitor object is called from its connection and, via
+    // trig() and the parameters, from other threads
+    yarp::os::Mutex mutex;
 };
 
 #endif //_MONITOR_SHAREDLIB_INC_
@@ -11,10 +11,13 @@
 
 #include <string>
 #include <map>
+#include <cstring>
 
 #include <yarp/os/Bytes.h>
 #include <yarp/os/NetType.h>
 #include <yarp/os/Name.h>
+#include <yarp/os/Mutex.h>
+#include <yarp/os/LockGuard.h>
 
 using namespace yarp::os;
 using namespace yarp::sig;
@@ -22,6 +25,73 @@ using namespace std;
 
 #define dbg_printf if (0) printf
 
+/*
+ *
+ * A message translated to the ROS format, kept so that the other
+ * tcpros connections of the same port carrying the same kind of
+ * data can send it without translating it again.
+ *
+ */
+class TcpRosTranslation {
+public:
+    int id;         // the message, see SizedWriter::getMessageId
+    int users;      // the cache and the connections writing it out
+    ManagedBytes data;
+    size_t len;
+
+    TcpRosTranslation() : id(0), users(0), len(0) {}
+};
+
+class TcpRosTranslationCache {
+public:
+    Mutex mutex;
+    int carriers;   // connections registered with this cache
+    TcpRosTranslation *current;
+    TcpRosTranslation *spare;
+
+    TcpRosTranslationCache() : carriers(0), current(NULL), spare(NULL) {}
+
+    ~TcpRosTranslationCache() {
+        if (current!=NULL) {
+            release(current);
+        }
+        delete spare;
+    }
+
+    // call with mutex held
+    void release(TcpRosTranslation *translation) {
+        translation->users--;
+        if (translation->users>0) return;
+        if (spare==NULL) {
+            spare = translation;
+        } else {
+            delete translation;
+        }
+    }
+};
+
+// one cache for each port and kind of data, guarded by translationMutex
+static Mutex translationMutex;
+static map<string,TcpRosTranslationCache *> translationCaches;
+
+TcpRosCarrier::~TcpRosCarrier() {
+    if (sharedKey=="") return;
+    LockGuard guard(translationMutex);
+    map<string,TcpRosTranslationCache *>::iterator it =
+        translationCaches.find(sharedKey.c_str());
+    if (it==translationCaches.end()) return;
+    it->second->carriers--;
+    if (it->second->carriers>0) return;
+    delete it->second;
+    translationCaches.erase(it);
+}
+
+void TcpRosCarrier::getCarrierParams(Property& params) {
+    params.put("translated",translateCount);
+    params.put("shared",sharedCount);
+    params.put("translation_time",translateTime);
+}
+
 void TcpRosCarrier::setParameters(const Bytes& header) {
     if (header.length()!=8) {
         return;
@@ -196,6 +266,7 @@ bool TcpRosCarrier::expectReplyToHeader(ConnectionState& proto) {
     if (rosname!="" && (user_type != wire_type || user_type == "")) {
         kind = TcpRosStream::rosToKind(rosname.c_str()).c_str();
         TcpRosStream::configureTwiddler(twiddler,kind.c_str(),rosname.c_str(),false,false);
+        replyLayout = false;
         translate = TCPROS_TRANSLATE_TWIDDLER;
     } else {
         rosname = "";
@@ -299,6 +370,7 @@ bool TcpRosCarrier::expectSenderSpecifier(ConnectionState& proto) {
         if (wire_type!="sensor_msgs/Image") { // currently using a custom method for images
             kind = TcpRosStream::rosToKind(rosname.c_str()).c_str();
             TcpRosStream::configureTwiddler(twiddler,kind.c_str(),rosname.c_str(),true,true);
+            replyLayout = true;
             translate = TCPROS_TRANSLATE_TWIDDLER;
         }
     } else {
@@ -321,8 +393,89 @@ bool TcpRosCarrier::expectSenderSpecifier(ConnectionState& proto) {
     return true;
 }
 
+TcpRosTranslation *TcpRosCarrier::translateShared(ConnectionState& proto,
+                                                  SizedWriter& writer) {
+    int id = writer.getMessageId();
+    if (id==0 || proto.getContactable()==NULL) return NULL;
+
+    translationMutex.lock();
+    if (sharedKey=="") {
+        char buf[64];
+        // the twiddler of a reply adds a prefix and only uses the part
+        // of the kind after "---", so it gets a cache of its own
+        sprintf(buf,"%p %s ",(void*)proto.getContactable(),
+                replyLayout?"reply":"main");
+        sharedKey = ConstString(buf) + kind;
+        TcpRosTranslationCache *& entry = translationCaches[sharedKey.c_str()];
+        if (entry==NULL) {
+            entry = new TcpRosTranslationCache;
+        }
+        entry->carriers++;
+        // the cache lives as long as this carrier is registered with it
+        sharedCache = entry;
+    }
+    TcpRosTranslationCache& cache = *sharedCache;
+    bool alone = (cache.carriers<2);
+    translationMutex.unlock();
+    if (alone) {
+        // nobody to share with, translate in place
+        return NULL;
+    }
+
+    LockGuard guard(cache.mutex);
+    if (cache.current!=NULL && cache.current->id==id) {
+        cache.current->users++;
+        sharedCount++;
+        translateCount++;
+        return cache.current;
+    }
+
+    // first connection to see this message, translate it into a buffer
+    // the others can pick up; connections still writing out an older
+    // message keep their own reference to it
+    TcpRosTranslation *translation = cache.spare;
+    cache.spare = NULL;
+    if (translation==NULL) {
+        translation = new TcpRosTranslation;
+    }
+    if (cache.current!=NULL) {
+        cache.release(cache.current);
+        cache.current = NULL;
+    }
+
+    double start = Time::now();
+    twiddler_output.attach(writer,twiddler);
+    bool ok = twiddler_output.update();
+    if (ok) {
+        size_t len = 0;
+        for (size_t i=0; i<twiddler_output.length(); i++) {
+            len += twiddler_output.length(i);
+        }
+        translation->data.allocateOnNeed(len,len);
+        char *at = translation->data.get();
+        for (size_t i=0; i<twiddler_output.length(); i++) {
+            memcpy(at,twiddler_output.data(i),twiddler_output.length(i));
+            at += twiddler_output.length(i);
+        }
+        translation->len = len;
+        translation->id = id;
+    }
+    translateTime += Time::now()-start;
+    translateCount++;
+
+    if (!ok) {
+        translation->users = 1;
+        cache.release(translation);
+        return NULL;
+    }
+    translation->users = 2; // the cache and us
+    cache.current = translation;
+    return translation;
+}
+
 bool TcpRosCarrier::write(ConnectionState& proto, SizedWriter& writer) {
     SizedWriter *flex_writer = &writer;
+    TcpRosTranslation *translation = NULL;
 
 
     ConstString typ = "";
@@ -383,12 +536,19 @@ bool TcpRosCarrier::write(ConnectionState& proto, SizedWriter& writer) {
     case TCPROS_TRANSLATE_TWIDDLER:
         {
             dbg_printf("* TCPROS_TRANSLATE_TWIDDLER\n");
+            translation = translateShared(proto,writer);
+            if (translation!=NULL) {
+                break;
+            }
+            double start = Time::now();
             twiddler_output.attach(writer,twiddler);
             if (twiddler_output.update()) {
                 flex_writer = &twiddler_output;
             } else {
                 flex_writer = NULL;
             }
+            translateTime += Time::now()-start;
+            translateCount++;
         }
         break;
     case TCPROS_TRANSLATE_INHIBIT:
@@ -399,24 +559,36 @@ bool TcpRosCarrier::write(ConnectionState& proto, SizedWriter& writer) {
         break;
     }
 
-    if (flex_writer == NULL) {
-        return false;
-    }
+    if (translation!=NULL) {
+        string header_len(4,'\0');
+        char *at = (char*)header_len.c_str();
+        RosHeader::appendInt(at,(int)translation->len);
+        Bytes b1((char*)header_len.c_str(),header_len.length());
+        proto.os().write(b1);
+        Bytes b2(translation->data.get(),translation->len);
+        proto.os().write(b2);
+        LockGuard guard(sharedCache->mutex);
+        sharedCache->release(translation);
+    } else {
+        if (flex_writer == NULL) {
+            return false;
+        }
 
-    int len = 0;
-    for (size_t i=0; i<flex_writer->length(); i++) {
-        len += (int)flex_writer->length(i);
-    }
-    dbg_printf("Prepping to write %d blocks (%d bytes)\n", 
-               (int)flex_writer->length(),
-               len);
+        int len = 0;
+        for (size_t i=0; i<flex_writer->length(); i++) {
+            len += (int)flex_writer->length(i);
+        }
+        dbg_printf("Prepping to write %d blocks (%d bytes)\n", 
+                   (int)flex_writer->length(),
+                   len);
 
-    string header_len(4,'\0');
-    char *at = (char*)header_len.c_str();
-    RosHeader::appendInt(at,len);
-    Bytes b1((char*)header_len.c_str(),header_len.length());
-    proto.os().write(b1);
-    flex_writer->write(proto.os());
+        string header_len(4,'\0');
+        char *at = (char*)header_len.c_str();
+        RosHeader::appendInt(at,len);
+        Bytes b1((char*)header_len.c_str(),header_len.length());
+        proto.os().write(b1);
+        flex_writer->write(proto.os());
+    }
 
     dbg_printf("done sending\n");
     
@@ -23,6 +23,9 @@ namespace yarp {
     }
 }
 
+class TcpRosTranslation;
+class TcpRosTranslationCache;
+
 #define TCPROS_TRANSLATE_INHIBIT (-1)
 #define TCPROS_TRANSLATE_UNKNOWN (0)
 #define TCPROS_TRANSLATE_IMAGE (1)
@@ -44,14 +47,23 @@ private:
     WireTwiddler twiddler;
     WireTwiddlerWriter twiddler_output;
     yarp::os::ConstString kind;
+    bool replyLayout;
     bool persistent;
     ConstString wire_type;
     ConstString user_type;
     ConstString md5sum;
     ConstString message_definition;
+    ConstString sharedKey;
+    TcpRosTranslationCache *sharedCache;
+    int translateCount;
+    int sharedCount;
+    double translateTime;
 
     ConstString getRosType(ConnectionState& proto);
 
+    TcpRosTranslation *translateShared(ConnectionState& proto,
+                                       SizedWriter& writer);
+
 protected:
     bool isService;
 public:
@@ -64,9 +76,16 @@ public:
         raw = -1;
         translate = TCPROS_TRANSLATE_UNKNOWN;
         seq = 0;
+        replyLayout = false;
         persistent = true;
+        sharedCache = NULL;
+        translateCount = 0;
+        sharedCount = 0;
+        translateTime = 0;
     }
 
+    virtual ~TcpRosCarrier();
+
     virtual Carrier *create() {
         return new TcpRosCarrier();
     }
@@ -182,6 +201,14 @@ public:
 
     virtual ConstString getBootstrapCarrierName() { return ""; }
 
+    /**
+     * Reports how many messages were translated to the ROS format
+     * ("translated"), how many of those reused the translation made
+     * for another connection of the same port ("shared"), and the
+     * total time spent translating in seconds ("translation_time").
+     */
+    virtual void getCarrierParams(Property& params);
+
     virtual int connect(const yarp::os::Contact& src,
                         const yarp::os::Contact& dest,
                         const yarp::os::ContactStyle& style,
@@ -305,7 +305,7 @@ bool RosTypeCodeGenYarp::readField(bool bare, const RosField& field) {
             fprintf(out,"    %s.resize(%s);\n",
                    field.rosName.c_str(),
                    len.c_str());
-            if (!bare) {
+            if (!bare && !t.yarpBlock) {
                 fprintf(out,"    for (int i=0; i<%s; i++) {\n", len.c_str());
                 fprintf(out,"      %s[i] = (%s)connection.%s();\n",
                         field.rosName.c_str(),
@@ -313,7 +313,8 @@ bool RosTypeCodeGenYarp::readField(bool bare, const RosField& field) {
                         t.yarpReader.c_str());
                 fprintf(out,"    }\n");
             } else {
-                fprintf(out,"    if (!connection.expectBlock((char*)&%s[0],sizeof(%s)*%s)) return false;\n",
+                fprintf(out,"    if (%s>0 && !connection.expectBlock((char*)&%s[0],sizeof(%s)*%s)) return false;\n",
+                        len.c_str(),
                         field.rosName.c_str(),
                         t.yarpType.c_str(),
                         len.c_str());
@@ -437,6 +438,11 @@ bool RosTypeCodeGenYarp::writeField(bool bare, const RosField& field) {
                         t.yarpTag.c_str());
                 fprintf(out,"    connection.appendInt(%s.size());\n",
                         field.rosName.c_str());
+            } else if (field.arrayLength==-1) {
+                fprintf(out,"    connection.appendInt(%s.size());\n",
+                        field.rosName.c_str());
+            }
+            if (!bare && !t.yarpBlock) {
                 fprintf(out,"    for (size_t i=0; i<%s.size(); i++) {\n",
                         field.rosName.c_str());
                 fprintf(out,"      connection.%s(%s%s[i]);\n",
@@ -445,11 +451,8 @@ bool RosTypeCodeGenYarp::writeField(bool bare, const RosField& field) {
                         field.rosName.c_str());
                 fprintf(out,"    }\n");
             } else {
-                if (field.arrayLength==-1) {
-                    fprintf(out,"    connection.appendInt(%s.size());\n",
-                            field.rosName.c_str());
-                }
-                fprintf(out,"    connection.appendExternalBlock((char*)&%s[0],sizeof(%s)*%s.size());\n",
+                fprintf(out,"    if (%s.size()>0) {connection.appendExternalBlock((char*)&%s[0],sizeof(%s)*%s.size());}\n",
+                        field.rosName.c_str(),
                         field.rosName.c_str(),
                         t.yarpType.c_str(),
                         field.rosName.c_str());
@@ -642,11 +645,13 @@ RosYarpType RosTypeCodeGenYarp::mapPrimitive(const RosField& field) {
         ry.writer = "appendInt";
         ry.reader = "expectInt";
         flavor = "int";
+        ry.yarpBlock = true;
     } else if (name=="uint32") {
         ry.yarpType = "yarp::os::NetUint32";
         ry.writer = "appendInt";
         ry.reader = "expectInt";
         flavor = "int";
+        ry.yarpBlock = true;
     } else if (name=="int64") {
         ry.yarpType = "yarp::os::NetInt64";
         ry.writer = "appendBlock";
@@ -670,6 +675,7 @@ RosYarpType RosTypeCodeGenYarp::mapPrimitive(const RosField& field) {
         ry.writer = "appendDouble";
         ry.reader = "expectDouble";
         flavor = "double";
+        ry.yarpBlock = true;
     } else if (name=="string") {
         // ignore
     } else {
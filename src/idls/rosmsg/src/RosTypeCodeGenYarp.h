@@ -24,9 +24,11 @@ public:
     std::string yarpWireReader;
     std::string yarpDefaultValue;
     int len;
+    bool yarpBlock; // elements of a bottle list have the same layout
 
     RosYarpType() {
         len = 0;
+        yarpBlock = false;
     }
 };
 
@@ -139,6 +139,31 @@ public:
     }
 
 
+    /**
+     * @brief caps the rate of messages sent on the connection.
+     * Messages written too soon after the last one sent on the
+     * connection are skipped on it, without delaying the writer.
+     * @param rate the most messages per second, 0 for no limit
+     */
+    void setMaxRate(double rate) {
+        maxRate = rate;
+    }
+
+
+    /**
+     * @brief skips messages on the connection while the previous one
+     * is still being sent, rather than making the writer wait for it.
+     * Ports writing in the background (e.g. BufferedPort) always skip
+     * busy connections; this makes a single connection of a port
+     * writing in the foreground behave the same way, at the cost of a
+     * copy of each message it sends.
+     * @param drop true to skip messages on a busy connection
+     */
+    void setDropWhenBusy(bool drop) {
+        dropWhenBusy = drop;
+    }
+
+
     /**
      * @brief returns the packet TOS value
      * @return the TOS
@@ -180,6 +205,24 @@ public:
     }
 
 
+    /**
+     * @brief returns the cap on the rate of messages sent
+     * @return the most messages per second, 0 for no limit
+     */
+    double getMaxRate() const {
+        return maxRate;
+    }
+
+
+    /**
+     * @brief returns whether messages are skipped on a busy connection
+     * @return true if messages are skipped rather than waited for
+     */
+    bool getDropWhenBusy() const {
+        return dropWhenBusy;
+    }
+
+
     /**
      * @brief returns the IPV4/6 DSCP value given as DSCP code
      * @param vocab a DSCP code (e.g., CS0)
@@ -200,6 +243,8 @@ private:
     int threadPriority;
     int threadPolicy;
     int packetPriority;
+    double maxRate;
+    bool dropWhenBusy;
 
 };
 
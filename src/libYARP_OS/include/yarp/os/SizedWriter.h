@@ -74,6 +74,18 @@ public:
     virtual void stopWrite() = 0;
 
     virtual void clear() {}
+
+    /**
+     *
+     * An identifier of the message being written, shared by all the
+     * connections of a port the message is sent on.  Carriers can use
+     * it to reuse work already done on the same message for another
+     * connection of the same port.
+     *
+     * @return the identifier, or 0 if there is none
+     *
+     */
+    virtual int getMessageId() { return 0; }
 };
 
 #endif // YARP_OS_SIZEDWRITER_H
@@ -10,6 +10,8 @@
 #include <yarp/os/Portable.h>
 #include <yarp/os/ConnectionReader.h>
 
+#include <typeinfo>
+
 namespace yarp {
     namespace os {
         class Things;
@@ -57,9 +59,7 @@ public:
      */
     bool setConnectionReader(yarp::os::ConnectionReader& reader) {
         conReader = &reader;
-        if(portable)
-            delete portable;
-        portable = NULL;
+        recycle();
         return true;
     }
 
@@ -75,8 +75,7 @@ public:
     }
 
     void reset() {
-        if(portable)
-            delete portable;
+        recycle();
         conReader = NULL;
         writer = NULL;
         reader = NULL;
@@ -97,11 +96,21 @@ public:
         {
             if(!this->conReader)
                 return NULL;
-            this->portable = new T();
+            // the object of the previous message is reused when it
+            // has the same type, so that a stream of messages does not
+            // allocate one object each
+            T* obj = NULL;
+            if(this->spare && typeid(*this->spare) == typeid(T))
+            {
+                obj = static_cast<T*>(this->spare);
+                this->spare = NULL;
+            }
+            else
+                obj = new T();
+            this->portable = obj;
             if(!this->portable->read(*this->conReader))
             {
-                delete this->portable;
-                this->portable = NULL;
+                recycle();
                 return NULL;
             }
             beenRead = true;
@@ -114,11 +123,22 @@ public:
     }
 
 private:
+    void recycle() {
+        if(portable)
+        {
+            if(spare)
+                delete spare;
+            spare = portable;
+        }
+        portable = NULL;
+    }
+
     bool beenRead;
     yarp::os::ConnectionReader* conReader;
     yarp::os::PortWriter* writer;
     yarp::os::PortReader* reader;
     yarp::os::Portable* portable;
+    yarp::os::Portable* spare;
 
 };
 
@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2016 iCub Facility
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ */
+
+#ifndef YARP_OS_TYPEDMONITOROBJECT_H
+#define YARP_OS_TYPEDMONITOROBJECT_H
+
+#include <yarp/os/MonitorObject.h>
+
+namespace yarp {
+    namespace os {
+        template <class T> class TypedMonitorObject;
+    }
+}
+
+/**
+ * A MonitorObject for connections carrying a single known type, such
+ * as a Bottle, a yarp::sig::Vector or a yarp::sig::ImageOf.
+ *
+ * The data is cast from the Things once per message and handed to
+ * acceptData() and updateData() as a T, so the code working on the
+ * individual elements is compiled for the concrete type.  On the
+ * receiving side the object read for a message is reused for the
+ * next one.  Messages of any other type are rejected.
+ *
+ * A monitor derived from it is built and loaded as a "dll" portmonitor
+ * like any other MonitorObject (see example/portmonitor/benchmark).
+ */
+template <class T>
+class yarp::os::TypedMonitorObject : public yarp::os::MonitorObject
+{
+public:
+    /**
+     * Called when data of type T reaches the monitor.
+     *
+     * @param data the data
+     * @return returning false will avoid delivering data to an input
+     *         port or transmitting through the output port
+     */
+    virtual bool acceptData(T& data) { return true; }
+
+    /**
+     * Called on data accepted by acceptData(), which may be
+     * modified in place.
+     *
+     * @param data the data
+     */
+    virtual void updateData(T& data) { }
+
+    virtual bool accept(yarp::os::Things& thing) {
+        T* data = thing.cast_as<T>();
+        if(data == NULL)
+            return false;
+        return acceptData(*data);
+    }
+
+    virtual yarp::os::Things& update(yarp::os::Things& thing) {
+        T* data = thing.cast_as<T>();
+        if(data != NULL)
+            updateData(*data);
+        return thing;
+    }
+};
+
+#endif // YARP_OS_TYPEDMONITOROBJECT_H
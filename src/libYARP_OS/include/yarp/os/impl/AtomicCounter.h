@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2016 iCub Facility - Istituto Italiano di Tecnologia
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ *
+ */
+
+#ifndef YARP2_ATOMICCOUNTER
+#define YARP2_ATOMICCOUNTER
+
+#include <yarp/conf/system.h>
+
+#if defined(YARP_HAS_CXX11)
+#  include <atomic>
+#  define YARP_ATOMIC_COUNTER_CXX11
+#elif defined(__GNUC__)
+#  define YARP_ATOMIC_COUNTER_GCC
+#elif defined(_MSC_VER)
+#  include <intrin.h>
+#  define YARP_ATOMIC_COUNTER_MSVC
+#else
+#  include <yarp/os/impl/SemaphoreImpl.h>
+#  define YARP_ATOMIC_COUNTER_LOCKED
+#endif
+
+namespace yarp {
+    namespace os {
+        namespace impl {
+            class AtomicCounter;
+        }
+    }
+}
+
+/**
+ *
+ * An integer counter that can be incremented and decremented from
+ * several threads without external locking.  Every operation is a
+ * full memory barrier.  Where no atomic primitive is available, the
+ * counter falls back on a private semaphore.
+ *
+ */
+class yarp::os::impl::AtomicCounter {
+public:
+    AtomicCounter(int value = 0)
+#ifdef YARP_ATOMIC_COUNTER_LOCKED
+        : mutex(1)
+#endif
+    {
+        set(value);
+    }
+
+    /**
+     *
+     * @return the current value of the counter
+     *
+     */
+    int get() {
+#if defined(YARP_ATOMIC_COUNTER_CXX11)
+        return value.load();
+#elif defined(YARP_ATOMIC_COUNTER_GCC)
+        return __sync_add_and_fetch(&value, 0);
+#elif defined(YARP_ATOMIC_COUNTER_MSVC)
+        return (int)_InterlockedExchangeAdd(&value, 0);
+#else
+        mutex.wait();
+        int result = value;
+        mutex.post();
+        return result;
+#endif
+    }
+
+    /**
+     *
+     * Overwrite the counter.
+     *
+     * @param x the new value of the counter
+     *
+     */
+    void set(int x) {
+#if defined(YARP_ATOMIC_COUNTER_CXX11)
+        value.store(x);
+#elif defined(YARP_ATOMIC_COUNTER_GCC)
+        __sync_lock_test_and_set(&value, x);
+        __sync_synchronize();
+#elif defined(YARP_ATOMIC_COUNTER_MSVC)
+        _InterlockedExchange(&value, (long)x);
+#else
+        mutex.wait();
+        value = x;
+        mutex.post();
+#endif
+    }
+
+    /**
+     *
+     * Increment the counter.
+     *
+     * @return the value of the counter after the increment
+     *
+     */
+    int inc() {
+#if defined(YARP_ATOMIC_COUNTER_CXX11)
+        return ++value;
+#elif defined(YARP_ATOMIC_COUNTER_GCC)
+        return __sync_add_and_fetch(&value, 1);
+#elif defined(YARP_ATOMIC_COUNTER_MSVC)
+        return (int)_InterlockedIncrement(&value);
+#else
+        mutex.wait();
+        int result = ++value;
+        mutex.post();
+        return result;
+#endif
+    }
+
+    /**
+     *
+     * Decrement the counter.
+     *
+     * @return the value of the counter after the decrement
+     *
+     */
+    int dec() {
+#if defined(YARP_ATOMIC_COUNTER_CXX11)
+        return --value;
+#elif defined(YARP_ATOMIC_COUNTER_GCC)
+        return __sync_sub_and_fetch(&value, 1);
+#elif defined(YARP_ATOMIC_COUNTER_MSVC)
+        return (int)_InterlockedDecrement(&value);
+#else
+        mutex.wait();
+        int result = --value;
+        mutex.post();
+        return result;
+#endif
+    }
+
+private:
+    // not copyable
+    AtomicCounter(const AtomicCounter&);
+    const AtomicCounter& operator=(const AtomicCounter&);
+
+#if defined(YARP_ATOMIC_COUNTER_CXX11)
+    std::atomic<int> value;
+#elif defined(YARP_ATOMIC_COUNTER_MSVC)
+    volatile long value;
+#else
+    volatile int value;
+#  ifdef YARP_ATOMIC_COUNTER_LOCKED
+    SemaphoreImpl mutex;
+#  endif
+#endif
+};
+
+#endif
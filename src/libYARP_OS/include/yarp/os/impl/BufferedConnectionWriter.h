@@ -82,6 +82,7 @@ public:
         target = &lst;
         target_used = &lst_used;
         ref = NULL;
+        messageId = 0;
         initialPoolSize = BUFFERED_CONNECTION_INITIAL_POOL_SIZE;
         stopPool();
         shouldDrop = false;
@@ -415,6 +416,21 @@ public:
         ref = obj;
     }
 
+    // defined by yarp::os::SizedWriter
+    virtual int getMessageId() {
+        return messageId;
+    }
+
+    /**
+     *
+     * Identify the message being written, see
+     * yarp::os::SizedWriter::getMessageId
+     *
+     */
+    void setMessageId(int id) {
+        messageId = id;
+    }
+
     // defined by yarp::os::ConnectionWriter
     virtual bool isValid() {
         return true;
@@ -502,6 +518,7 @@ private:
     bool bareMode;     ///< should we be writing without including type info
     bool convertTextModePending; ///< will we need to do an automatic textmode conversion
     yarp::os::Portable *ref; ///< object reference for when serialization can be skipped
+    int messageId;     ///< port-wide identifier of the message, or 0
     bool shouldDrop;   ///< should the connection drop after writes
     size_t lst_used;   ///< how many payload buffers are in use for the current message
     size_t header_used;///< how many header buffers are in use for the current message
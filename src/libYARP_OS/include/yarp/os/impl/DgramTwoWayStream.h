@@ -11,6 +11,7 @@
 #include <yarp/os/TwoWayStream.h>
 #include <yarp/os/ManagedBytes.h>
 #include <yarp/os/Semaphore.h>
+#include <yarp/os/impl/AtomicCounter.h>
 
 #include <yarp/os/impl/PlatformStdlib.h>
 
@@ -42,6 +43,7 @@ public:
         dgram = NULL;
         mgram = NULL;
         happy = true;
+        crc = true;
         bufferAlerted = bufferAlertNeeded = false;
         multiMode = false;
         errCount = 0;
@@ -122,6 +124,40 @@ public:
 
     virtual int getTypeOfService();
 
+    /**
+     * Choose whether datagrams carry a checksum of their content.  The
+     * header of each datagram is the same either way, but a peer that
+     * checks the checksum rejects the datagrams sent without it, so both
+     * sides have to agree, see UdpCarrier.  Packet loss and reordering
+     * are detected in both cases.
+     */
+    void setCrc(bool crc) {
+        this->crc = crc;
+    }
+
+    bool getCrc() {
+        return crc;
+    }
+
+    /**
+     * Number of datagrams received so far.
+     */
+    int getDgramCount() {
+        return dgramCount.get();
+    }
+
+    /**
+     * Number of datagrams received so far that were discarded because
+     * they were corrupted or out of sequence.  Each such datagram means
+     * that at least one message was lost.  The counts are only reported,
+     * through the port administration interface; acting on them, e.g.
+     * moving a receiver to a lighter mcast group, is left to whoever polls
+     * them.
+     */
+    int getDropCount() {
+        return dropCount.get();
+    }
+
     void setMonitor(const yarp::os::Bytes& data) {
         monitor = yarp::os::ManagedBytes(data,false);
         monitor.copy();
@@ -152,6 +188,10 @@ private:
     YARP_SSIZE_T readAt, readAvail, writeAvail;
     int pct;
     bool happy;
+    bool crc;
+    // written by the reading thread, read by the administration one
+    AtomicCounter dgramCount;
+    AtomicCounter dropCount;
     bool bufferAlertNeeded;
     bool bufferAlerted;
     bool multiMode;
@@ -29,12 +29,21 @@ namespace yarp {
 
 /**
  * Communicating between two ports via MCAST.
+ *
+ * All the mcast connections from a port with the same carrier string
+ * share one group and are served by a single sender.  Connections with
+ * different modifiers, such as "mcast+send.imgscale+w.320", form
+ * separate groups, so that the same stream can be published in lighter
+ * layers for receivers that cannot keep up with the full one.  Choosing
+ * the layer of each receiver is left to a supervisor, see the "stats" of
+ * the port administration interface.
  */
 class yarp::os::impl::McastCarrier : public UdpCarrier {
 protected:
     Contact mcastAddress;
     String mcastName;
     String key;
+    String owner;
 
     static ElectionOf<PeerRecord<McastCarrier> > *caster;
 
@@ -56,6 +65,8 @@ public:
     virtual bool respondToHeader(ConnectionState& proto);
     virtual bool expectReplyToHeader(ConnectionState& proto);
 
+    String getLayer(ConnectionState& proto);
+
     void addSender(const String& key);
     void addRemove(const String& key);
     bool isElect();
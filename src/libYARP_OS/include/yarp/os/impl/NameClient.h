@@ -16,11 +16,14 @@
 #include <yarp/os/Property.h>
 #include <yarp/os/Nodes.h>
 #include <yarp/os/Network.h>
+#include <yarp/os/OutputProtocol.h>
+#include <yarp/os/Mutex.h>
 
 namespace yarp {
     namespace os {
         namespace impl {
             class NameClient;
+            class NameClientCache;
             class NameServer;
         }
     }
@@ -68,6 +71,13 @@ public:
         return new NameClient();
     }
 
+    /**
+     * Shut down the cache of port contacts shared by all name clients
+     * (see queryName).  This closes a port, so it must be called
+     * while the network is still usable.
+     */
+    static void removeCache();
+
     /**
      * The address of the name server.
      * @return the address of the name server
@@ -87,6 +97,12 @@ public:
 
     /**
      * Look up the address of a named port.
+     *
+     * If the YARP_NAME_CACHE environment variable is set to a positive
+     * number of seconds, successful lookups are cached for that long.
+     * A cached entry is dropped earlier if the name server reports that
+     * the port was registered or unregistered again.
+     *
      * @param name the name of the port
      * @return the address associated with the port
      */
@@ -141,6 +157,8 @@ public:
 
     /**
      * Send a text message to the nameserver, and return the result.
+     * Commands expecting a reply share a single connection to the
+     * name server, which is kept open between calls.
      *
      * @param cmd the message to send.
      * @param multi whether to expect a multi-line response.
@@ -270,6 +288,12 @@ private:
 
     NameServer& getServer();
 
+    bool sendOnConnection(const ConstString& cmd, ConstString& result);
+
+    NameClientCache *getCache();
+
+    void forget(const ConstString& name);
+
 
     Contact address;
     ConstString host;
@@ -285,6 +309,8 @@ private:
     yarp::os::ResourceFinder resourceFinder;
     yarp::os::Property pluginState;
     yarp::os::Nodes nodes;
+    OutputProtocol *connection;
+    yarp::os::Mutex connectionMutex;
 
     static NameClient *instance;
     static bool instanceClosed;
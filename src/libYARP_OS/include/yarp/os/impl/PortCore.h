@@ -131,6 +131,7 @@ public:
         adminReader = NULL;
         readableCreator = NULL;
         outputCount = inputCount = 0;
+        messageCounter = 0;
         dataOutputCount = 0;
         controlRegistration = true;
         interruptible = true;
@@ -521,6 +522,7 @@ private:
     String envelope;///< user-defined wrapping data
     float timeout;  ///< a timeout to apply to all network operations
     int counter;    ///< port-unique ids for connections
+    int messageCounter; ///< port-unique ids for messages, see PortCorePacket::getId
     yarp::os::Property *prop;  ///< optional unstructured properties associated with port
     yarp::os::Contactable *contactable;  ///< user-facing object that contains this PortCore
     yarp::os::Mutex *mutex; ///< callback optional access control lock
@@ -533,6 +535,12 @@ private:
     // get IP packet TOS
     int  getTypeOfService(PortCoreUnit *unit);
 
+    // mcast connections with the same carrier string share one group, sent
+    // by whichever of them is elected, so they must have the same sending
+    // QoS; give the rate and drop settings of unit to the others of its
+    // group or, if adopt is set, take them from one of the others
+    void shareLayerQos(PortCoreUnit *unit, bool adopt);
+
     // set the scheduling properties of all threads
     // whithin the process scope.
     bool setProcessSchedulingParam(int priority=-1, int policy=-1);
@@ -557,6 +565,9 @@ private:
     // only called in "running" phase
     void addInput(InputProtocol *ip);
 
+    // drop one use of a packet, recycling it if that was the last use
+    void releasePacket(PortCorePacket *packet);
+
     bool removeUnit(const Route& route, bool synch = false,
                     bool *except = NULL);
 
@@ -12,15 +12,43 @@
 #include <yarp/os/impl/PortCoreUnit.h>
 #include <yarp/os/impl/Logger.h>
 #include <yarp/os/OutputProtocol.h>
+#include <yarp/os/ManagedBytes.h>
 
 namespace yarp {
     namespace os {
         namespace impl {
             class PortCoreOutputUnit;
+            class PortCoreMessageCopy;
         }
     }
 }
 
+/**
+ * A serialized copy of a message, which can be sent after the object
+ * it was made from has changed or gone.
+ */
+class yarp::os::impl::PortCoreMessageCopy : public yarp::os::PortWriter {
+public:
+    PortCoreMessageCopy() : dropRequested(false) {}
+
+    /**
+     *
+     * Serialize a message and keep a copy of the result.
+     * @param writer the message
+     * @param textMode should the message be serialized as text
+     * @param bareMode should the message be serialized without type information
+     * @return true on success
+     *
+     */
+    bool copy(yarp::os::PortWriter& writer, bool textMode, bool bareMode);
+
+    virtual bool write(yarp::os::ConnectionWriter& connection);
+
+private:
+    yarp::os::ManagedBytes data; ///< the serialized message
+    bool dropRequested;          ///< did the message ask to drop the connection
+};
+
 /**
  * Manager for a single output from a port.  Associated
  * with a PortCore object.
@@ -47,6 +75,11 @@ public:
         cachedWriter = NULL;
         cachedReader = NULL;
         cachedTracker = NULL;
+        cachedMessageId = 0;
+        cachedModified = false;
+        maxRate = 0;
+        dropWhenBusy = false;
+        nextSend = 0;
     }
 
     /**
@@ -127,6 +160,38 @@ public:
     // return the protocol object
     OutputProtocol* getOutPutProtocol() { return op; }
 
+    /**
+     *
+     * Cap the rate of messages sent on this connection; messages
+     * offered sooner are skipped.
+     * @param rate the most messages per second, 0 for no limit
+     *
+     */
+    void setMaxRate(double rate) { maxRate = rate; }
+
+    /**
+     *
+     * @return the most messages per second sent, 0 for no limit
+     *
+     */
+    double getMaxRate() { return maxRate; }
+
+    /**
+     *
+     * Skip messages while this connection is busy sending, even if
+     * the port waits for its writes to complete.
+     * @param drop true to skip messages on a busy connection
+     *
+     */
+    void setDropWhenBusy(bool drop) { dropWhenBusy = drop; }
+
+    /**
+     *
+     * @return true if messages are skipped on a busy connection
+     *
+     */
+    bool getDropWhenBusy() { return dropWhenBusy; }
+
 private:
     OutputProtocol *op; ///< protocol object for writing/reading
     bool closing;       ///< should this connection close
@@ -143,6 +208,12 @@ private:
                                           ///< completion events
     void *cachedTracker;        ///< memory tracker for current message
     String cachedEnvelope;      ///< some text to pass along with the message
+    int cachedMessageId;        ///< port-wide id of the message, or 0
+    bool cachedModified;        ///< has the sender modifier already been applied
+    double maxRate;             ///< most messages per second, 0 for no limit
+    bool dropWhenBusy;          ///< skip messages rather than wait for this connection
+    double nextSend;            ///< earliest time for the next message, with maxRate
+    PortCoreMessageCopy copied; ///< message copied for sending after the writer returns
 
     /**
      *
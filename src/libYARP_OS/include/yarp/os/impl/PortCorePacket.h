@@ -10,6 +10,7 @@
 
 #include <yarp/os/PortWriter.h>
 #include <yarp/os/NetType.h>
+#include <yarp/os/impl/AtomicCounter.h>
 
 namespace yarp {
     namespace os {
@@ -28,13 +29,14 @@ namespace yarp {
 class yarp::os::impl::PortCorePacket {
 public:
     PortCorePacket *prev_; ///< this packet will be in a list of active packets
-    PortCorePacket *next_; ///< this packet will be in a list of active packets
+    PortCorePacket *next_; ///< this packet will be in a list of active or free packets
     yarp::os::PortWriter *content;  ///< the object being sent
     yarp::os::PortWriter *callback; ///< where to send event notifications
-    int ct;                ///< number of uses of the messagae
+    AtomicCounter ct;      ///< number of uses of the messagae
     bool owned;            ///< should we memory-manage the content object
     bool ownedCallback;    ///< should we memory-manage the callback object
     bool completed;        ///< has a notification of completion been sent
+    int id;                ///< port-wide identifier of the message, or 0
 
     /**
      *
@@ -47,6 +49,7 @@ public:
         callback = NULL;
         owned = false;
         ownedCallback = false;
+        id = 0;
         reset();
     }
 
@@ -66,25 +69,33 @@ public:
      *
      */
     int getCount() {
-        return ct;
+        return ct.get();
     }
 
     /**
      *
-     * Increment the usage count for this messagae.
+     * Increment the usage count for this messagae.  Safe to call
+     * without holding any lock.
+     *
+     * @return the number of users after the increment
      *
      */
-    void inc() {
-        ct++;
+    int inc() {
+        return ct.inc();
     }
 
     /**
      *
-     * Decrement the usage count for this messagae.
+     * Decrement the usage count for this messagae.  Safe to call
+     * without holding any lock.  Exactly one caller will see the
+     * count drop to zero, and that caller is responsible for
+     * recycling the packet.
+     *
+     * @return the number of users after the decrement
      *
      */
-    void dec() {
-        ct--;
+    int dec() {
+        return ct.dec();
     }
 
     /**
@@ -105,6 +116,25 @@ public:
         return (callback!=0/*NULL*/)?callback:content;
     }
 
+    /**
+     *
+     * @return the identifier given to the message by the port, shared
+     * by all the connections carrying it (0 if none)
+     *
+     */
+    int getId() {
+        return id;
+    }
+
+    /**
+     *
+     * Identify the message, see getId().
+     *
+     */
+    void setId(int id) {
+        this->id = id;
+    }
+
     /**
      *
      * Configure the object being sent and where to send notifications.
@@ -120,7 +150,7 @@ public:
                     bool ownedCallback = false) {
         content = writable;
         this->callback = callback;
-        ct = 1;
+        ct.set(1);
         this->owned = owned;
         this->ownedCallback = ownedCallback;
         completed = false;
@@ -140,10 +170,11 @@ public:
         }
         content = NULL;
         callback = NULL;
-        ct = 0;
+        ct.set(0);
         owned = false;
         ownedCallback = false;
         completed = false;
+        id = 0;
     }
 
     /**
@@ -9,12 +9,7 @@
 #define YARP2_PORTCOREPACKETS
 
 #include <yarp/os/impl/PortCorePacket.h>
-#include <yarp/os/impl/PlatformList.h>
-#ifdef YARP_HAS_ACE
-#  include <ace/config.h>
-#  include <ace/String_Base.h>
-#endif
-#include <stdio.h>
+#include <yarp/os/Log.h>
 
 namespace yarp {
     namespace os {
@@ -30,16 +25,50 @@ namespace yarp {
  * This tracks uses of the messages for memory management purposes.
  * We call messages "packets" for no particular reason.
  *
+ * Packets are linked intrusively through their PortCorePacket::prev_ and
+ * PortCorePacket::next_ members, so taking a packet from the pool and
+ * returning it are constant-time and never allocate once the pool has
+ * grown to the number of messages simultaneously in flight.  The
+ * collection itself is not thread-safe; callers serialize access.
+ *
  */
 class yarp::os::impl::PortCorePackets {
 private:
-    PLATFORM_LIST(PortCorePacket) inactive; // unused packets we may reuse
-    PLATFORM_LIST(PortCorePacket) active;   // a list of packets being sent
+    PortCorePacket *inactive; // unused packets we may reuse (singly linked)
+    PortCorePacket *active;   // a list of packets being sent (doubly linked)
+    int activeCount;          // length of the active list
+
+    static void destroyChain(PortCorePacket *head) {
+        while (head!=NULL) {
+            PortCorePacket *next = head->next_;
+            delete head;
+            head = next;
+        }
+    }
+
+    void unlinkActive(PortCorePacket *packet) {
+        if (packet->prev_!=NULL) {
+            packet->prev_->next_ = packet->next_;
+        } else {
+            active = packet->next_;
+        }
+        if (packet->next_!=NULL) {
+            packet->next_->prev_ = packet->prev_;
+        }
+        packet->prev_ = packet->next_ = NULL;
+        activeCount--;
+    }
+
 public:
 
+    PortCorePackets() : inactive(NULL), active(NULL), activeCount(0) {
+    }
+
     virtual ~PortCorePackets() {
-        PLATFORM_LIST_CLEAR(inactive);
-        PLATFORM_LIST_CLEAR(active);
+        destroyChain(inactive);
+        destroyChain(active);
+        inactive = active = NULL;
+        activeCount = 0;
     }
 
     /**
@@ -48,7 +77,7 @@ public:
      *
      */
     int getCount() {
-        return (int)active.size();
+        return activeCount;
     }
 
     /**
@@ -61,32 +90,20 @@ public:
      *
      */
     PortCorePacket *getFreePacket() {
-        if (PLATFORM_LIST_EMPTY(inactive)) {
-            PortCorePacket *obj = NULL;
-#if defined(YARP_HAS_ACE) && !defined(YARP_HAS_CXX11)
-            size_t obj_size = sizeof (PortCorePacket);
-            ACE_NEW_MALLOC_RETURN (obj,
-                                   (PortCorePacket *)
-                                   ACE_Allocator::instance()->malloc(obj_size),
-                                   PortCorePacket(), 0);
-#else
-            obj = new PortCorePacket();
-#endif
-            yAssert(obj!=NULL);
-            PLATFORM_LIST_PUSH_BACK(inactive,obj);
-        }
-        PortCorePacket *next = NULL;
-        PLATFORM_LIST_GET(inactive,next);
-        if (next==NULL) {
-            fprintf(stderr,"*** YARP consistency check failed.\n");
-            fprintf(stderr,"*** There has been a low-level failure in \"PortCorePackets\".\n");
-            fprintf(stderr,"*** This typically occurs when ports are accessed in a non-threadsafe way.\n");
-            fprintf(stderr,"*** For help: https://github.com/robotology/yarp/issues/new\n");
-            yAssert(1==0);
+        PortCorePacket *next = inactive;
+        if (next!=NULL) {
+            inactive = next->next_;
+        } else {
+            next = new PortCorePacket();
         }
         yAssert(next!=NULL);
-        inactive.remove(next);
-        PLATFORM_LIST_PUSH_BACK(active,next);
+        next->prev_ = NULL;
+        next->next_ = active;
+        if (active!=NULL) {
+            active->prev_ = next;
+        }
+        active = next;
+        activeCount++;
         return next;
     }
 
@@ -104,8 +121,9 @@ public:
                 packet->reset();
             }
             packet->completed = true;
-            active.remove(packet);
-            PLATFORM_LIST_PUSH_BACK(inactive,packet);
+            unlinkActive(packet);
+            packet->next_ = inactive;
+            inactive = packet;
         }
     }
 
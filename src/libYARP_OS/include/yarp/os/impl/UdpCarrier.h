@@ -22,6 +22,11 @@ namespace yarp {
 
 /**
  * Communicating between two ports via UDP.
+ *
+ * Connecting with "udp+crc.0" asks the receiver to skip the checksum of
+ * each datagram, for links where the UDP checksum of the network stack is
+ * deemed enough.  A receiver that does not know this option answers as
+ * usual and the checksum is kept.
  */
 class yarp::os::impl::UdpCarrier : public AbstractCarrier {
 public:
@@ -38,8 +43,12 @@ public:
     virtual void setParameters(const Bytes& header);
     virtual bool requireAck();
     virtual bool isConnectionless();
+    virtual bool sendHeader(ConnectionState& proto);
     virtual bool respondToHeader(ConnectionState& proto);
     virtual bool expectReplyToHeader(ConnectionState& proto);
+
+private:
+    bool crc;
 };
 
 #endif
@@ -42,13 +42,16 @@ using namespace yarp::os;
 #define WRITE_SIZE (60000-CRC_SIZE)
 
 
+// without crc the checksum field is sent as 0 and not checked
 static bool checkCrc(char *buf, YARP_SSIZE_T length, YARP_SSIZE_T crcLength, int pct,
-                     int *store_altPct = NULL) {
-    NetInt32 alt =
-        (NetInt32)NetType::getCrc(buf+crcLength,(length>crcLength)?(length-crcLength):0);
+                     int *store_altPct = NULL, bool crc = true) {
     Bytes b(buf,4);
     Bytes b2(buf+4,4);
     NetInt32 curr = NetType::netInt(b);
+    NetInt32 alt = curr;
+    if (crc) {
+        alt = (NetInt32)NetType::getCrc(buf+crcLength,(length>crcLength)?(length-crcLength):0);
+    }
     int altPct = NetType::netInt(b2);
     bool ok = (alt == curr && pct==altPct);
     if (!ok) {
@@ -67,10 +70,13 @@ static bool checkCrc(char *buf, YARP_SSIZE_T length, YARP_SSIZE_T crcLength, int
 }
 
 
-static void addCrc(char *buf, YARP_SSIZE_T length, YARP_SSIZE_T crcLength, int pct) {
-    NetInt32 alt =
-        (NetInt32)NetType::getCrc(buf+crcLength,
-                                           (length>crcLength)?(length-crcLength):0);
+static void addCrc(char *buf, YARP_SSIZE_T length, YARP_SSIZE_T crcLength, int pct,
+                   bool crc = true) {
+    NetInt32 alt = 0;
+    if (crc) {
+        alt = (NetInt32)NetType::getCrc(buf+crcLength,
+                                        (length>crcLength)?(length-crcLength):0);
+    }
     Bytes b(buf,4);
     Bytes b2(buf+4,4);
     NetType::netInt((NetInt32)alt,b);
@@ -598,14 +604,16 @@ YARP_SSIZE_T DgramTwoWayStream::read(const Bytes& b) {
                 return -1;
             }
             readAvail = result;
+            dgramCount.inc();
 
             // deal with CRC
             int altPct = 0;
             bool crcOk = checkCrc(readBuffer.get(),readAvail,CRC_SIZE,pct,
-                                  &altPct);
+                                  &altPct,crc);
             if (altPct!=-1) {
                 pct++;
                 if (!crcOk) {
+                    dropCount.inc();
                     if (bufferAlertNeeded&&!bufferAlerted) {
                         YARP_ERROR(Logger::get(),
                                    "*** Multicast/UDP packet dropped - checksum error ***");
@@ -701,7 +709,7 @@ void DgramTwoWayStream::flush() {
     if (writeAvail<=CRC_SIZE) {
         return;
     }
-    addCrc(writeBuffer.get(),writeAvail,CRC_SIZE,pct);
+    addCrc(writeBuffer.get(),writeAvail,CRC_SIZE,pct,crc);
     pct++;
 
     while (writeAvail>0) {
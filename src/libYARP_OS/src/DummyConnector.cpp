@@ -9,7 +9,9 @@
 #include <yarp/os/DummyConnector.h>
 #include <yarp/os/impl/BufferedConnectionWriter.h>
 #include <yarp/os/impl/StreamConnectionReader.h>
-#include <yarp/os/StringInputStream.h>
+#include <yarp/os/InputStream.h>
+
+#include <cstring>
 
 
 using namespace yarp::os::impl;
@@ -26,11 +28,63 @@ public:
     }
 };
 
+/**
+ * Reads back what has been written to a BufferedConnectionWriter,
+ * straight out of its buffers (including any external blocks)
+ * rather than from a flattened copy of the message.
+ */
+class DummyConnectorInputStream : public InputStream {
+private:
+    BufferedConnectionWriter *writer;
+    size_t index;
+    size_t offset;
+public:
+    using InputStream::read;
+
+    DummyConnectorInputStream() : writer(NULL), index(0), offset(0) {}
+
+    void reset(BufferedConnectionWriter& writer) {
+        this->writer = &writer;
+        index = 0;
+        offset = 0;
+    }
+
+    virtual YARP_SSIZE_T read(const Bytes& b) {
+        if (writer==NULL) return 0;
+        char *dest = b.get();
+        size_t space = b.length();
+        YARP_SSIZE_T ct = 0;
+        while (space>0 && index<writer->length()) {
+            size_t len = writer->length(index);
+            if (offset>=len) {
+                index++;
+                offset = 0;
+                continue;
+            }
+            size_t n = len-offset;
+            if (n>space) n = space;
+            memcpy(dest,writer->data(index)+offset,n);
+            dest += n;
+            space -= n;
+            offset += n;
+            ct += (YARP_SSIZE_T)n;
+        }
+        return ct;
+    }
+
+    virtual void close() {
+    }
+
+    virtual bool isOk() {
+        return true;
+    }
+};
+
 class DummyConnectorHelper {
 private:
     BufferedConnectionWriter writer;
     DummyConnectorReader reader;
-    StringInputStream sis;
+    DummyConnectorInputStream sis;
     bool textMode;
 public:
 
@@ -61,11 +115,9 @@ public:
     ConnectionReader& getReader()
     {
         writer.stopWrite();
-        String s = writer.toString();
-        sis.reset();
-        sis.add(s);
+        sis.reset(writer);
         Route r;
-        reader.reset(sis, NULL, r, s.length(), textMode);
+        reader.reset(sis, NULL, r, writer.dataSize(), textMode);
         return reader;
     }
 
@@ -10,12 +10,45 @@
 #include <stdlib.h>
 #include <yarp/os/impl/Logger.h>
 #include <yarp/os/Network.h>
+#include <yarp/os/Bottle.h>
+#include <yarp/os/Mutex.h>
 
 using namespace yarp::os::impl;
 using namespace yarp::os;
 
 ElectionOf<PeerRecord<McastCarrier> > *McastCarrier::caster = NULL;
 
+static Mutex ownsMutex;
+
+// A port owns one mcast group per layer.  The name server replaces the
+// values of a property on "set", so the whole list is written back
+// each time a group is added or removed.
+static void updateOwnedGroups(const String& port, const String& group,
+                              bool add) {
+    ownsMutex.lock();
+    Bottle cmd, reply;
+    cmd.addString("set");
+    cmd.addString(port.c_str());
+    cmd.addString("owns");
+    Value *owned = NetworkBase::getProperty(port.c_str(),"owns");
+    if (owned!=NULL) {
+        Bottle prev(owned->isString()?owned->asString():owned->toString());
+        for (int i=0; i<prev.size(); i++) {
+            ConstString name = prev.get(i).asString();
+            if (name!="" && name!=group.c_str()) {
+                cmd.addString(name);
+            }
+        }
+        delete owned;
+    }
+    if (add) {
+        cmd.addString(group.c_str());
+    }
+    ContactStyle style;
+    NetworkBase::writeToNameServer(cmd,reply,style);
+    ownsMutex.unlock();
+}
+
 ElectionOf<PeerRecord<McastCarrier> >& McastCarrier::getCaster() {
     NetworkBase::lock();
     if (caster==NULL) {
@@ -45,6 +78,9 @@ yarp::os::impl::McastCarrier::~McastCarrier() {
             if (peer==NULL) {
                 // time to remove registration
                 NetworkBase::unregisterName(mcastName.c_str());
+                if (owner!="") {
+                    updateOwnedGroups(owner,mcastName,false);
+                }
             }
         }
     }
@@ -63,6 +99,17 @@ int yarp::os::impl::McastCarrier::getSpecifierCode() {
 }
 
 
+String yarp::os::impl::McastCarrier::getLayer(ConnectionState& proto) {
+    // connections asking for different modifiers, e.g.
+    // mcast+send.imgscale+w.320, get their own group
+    String name = proto.getRoute().getCarrierName();
+    size_t at = name.find("+");
+    if (at==String::npos) {
+        return "";
+    }
+    return name.substr(at);
+}
+
 bool yarp::os::impl::McastCarrier::sendHeader(ConnectionState& proto) {
     // need to do more than the default
     bool ok = defaultSendHeader(proto);
@@ -73,8 +120,9 @@ bool yarp::os::impl::McastCarrier::sendHeader(ConnectionState& proto) {
     Contact addr;
 
     Contact alt = proto.getStreams().getLocalAddress();
+    owner = proto.getRoute().getFromName();
     String altKey =
-        proto.getRoute().getFromName() +
+        owner + getLayer(proto) +
         "/net=" + alt.getHost();
     McastCarrier *elect = getCaster().getElect(altKey);
     if (elect!=NULL) {
@@ -88,10 +136,9 @@ bool yarp::os::impl::McastCarrier::sendHeader(ConnectionState& proto) {
         addr = NetworkBase::registerContact(target);
         mcastName = addr.getRegName();
         if (addr.isValid()) {
-            // mark owner of mcast address
-            NetworkBase::setProperty(proto.getRoute().getFromName().c_str(),
-                                     "owns",
-                                     Value(mcastName.c_str()));
+            // mark owner of mcast address, so that the group is freed
+            // with the port
+            updateOwnedGroups(owner,mcastName,true);
         }
     }
 
@@ -187,7 +234,7 @@ bool yarp::os::impl::McastCarrier::becomeMcast(ConnectionState& proto, bool send
             interfaces.  This may or may not always be the case,
             the author doesn't know, so is being cautious.
         */
-        key = proto.getRoute().getFromName();
+        key = proto.getRoute().getFromName() + getLayer(proto);
         if (test) {
             key += "/net=";
             key += local.getHost();
@@ -15,7 +15,12 @@
 #  include <yarp/os/impl/FallbackNameClient.h>
 #endif
 #include <yarp/os/Network.h>
+#include <yarp/os/Port.h>
+#include <yarp/os/PortReader.h>
+#include <yarp/os/Time.h>
+#include <yarp/os/impl/PlatformMap.h>
 #include <yarp/os/impl/PlatformStdio.h>
+#include <yarp/os/impl/PlatformStdlib.h>
 
 using namespace yarp::os::impl;
 using namespace yarp::os;
@@ -100,6 +105,118 @@ public:
 
 
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+/**
+ * Contacts of ports looked up recently, shared by all name clients of
+ * the process.  The name server writes an event ("add" or "del"
+ * followed by a port name) to its own output connections whenever a
+ * port is registered or unregistered, so the cache opens a port and
+ * connects the name server to it in order to drop stale entries.
+ * Entries also expire after a fixed lifetime, since nothing is
+ * reported when a port dies without unregistering or when the name
+ * server restarts.
+ */
+class yarp::os::impl::NameClientCache : public PortReader {
+private:
+    class Entry {
+    public:
+        Contact contact;
+        double stamp;
+    };
+
+    PLATFORM_MAP(String,Entry) entries;
+    Mutex mutex;
+    Port listener;
+    Contact server;
+    double lifetime;
+
+public:
+    NameClientCache(const Contact& server, double lifetime) :
+        server(server),
+        lifetime(lifetime) {
+    }
+
+    bool open() {
+        listener.setReader(*this);
+        listener.setVerbosity(-1);
+        if (!listener.open("...")) {
+            return false;
+        }
+        ContactStyle style;
+        style.quiet = true;
+        style.carrier = "tcp";
+        if (!NetworkBase::connect(NetworkBase::getNameServerName(),
+                                  listener.getName(),style)) {
+            YARP_INFO(Logger::get(),
+                      "Name server does not report changes, no cache used");
+            listener.close();
+            return false;
+        }
+        return true;
+    }
+
+    void close() {
+        listener.close();
+    }
+
+    bool serves(const Contact& address) {
+        return address.getHost()==server.getHost() &&
+            address.getPort()==server.getPort();
+    }
+
+    bool lookup(const String& name, Contact& contact) {
+        Entry entry;
+        mutex.lock();
+        bool found = (PLATFORM_MAP_FIND_RAW(entries,name,entry)!=-1);
+        mutex.unlock();
+        if (!found||Time::now()-entry.stamp>lifetime) {
+            return false;
+        }
+        contact = entry.contact;
+        return true;
+    }
+
+    void store(const String& name, const Contact& contact) {
+        Entry entry;
+        entry.contact = contact;
+        entry.stamp = Time::now();
+        mutex.lock();
+        PLATFORM_MAP_SET(entries,name,entry);
+        mutex.unlock();
+    }
+
+    void forget(const String& name) {
+        mutex.lock();
+        PLATFORM_MAP_UNSET(entries,name);
+        mutex.unlock();
+    }
+
+    virtual bool read(ConnectionReader& reader) {
+        Bottle event;
+        if (!event.read(reader)) {
+            return false;
+        }
+        if (event.size()>=2) {
+            forget(event.get(1).asString().c_str());
+        }
+        return true;
+    }
+};
+
+#define NAME_CACHE_IDLE 0
+#define NAME_CACHE_STARTING 1
+#define NAME_CACHE_ACTIVE 2
+#define NAME_CACHE_DISABLED 3
+
+static NameClientCache *__name_cache = NULL;
+static int __name_cache_state = NAME_CACHE_IDLE;
+static Mutex __name_cache_mutex;
+
+#endif /*DOXYGEN_SHOULD_SKIP_THIS*/
+
+
+
 
 
 Contact NameClient::extractAddress(const String& txt) {
@@ -149,6 +266,12 @@ String NameClient::send(const String& cmd, bool multi) {
         }
         return so.c_str();
     }
+    if (multi&&!isFakeMode()) {
+        String result;
+        if (sendOnConnection(cmd,result)) {
+            return result;
+        }
+    }
     bool retried = false;
     bool retry = false;
     String result;
@@ -253,6 +376,26 @@ bool NameClient::send(Bottle& cmd, Bottle& reply) {
         return getServer().apply(cmd,reply,
                                  Contact::bySocket("tcp","127.0.0.1",NetworkBase::getDefaultPortRange()));
     } else {
+        if (cmd.get(0).asString()!="bot") {
+            // the reply to an old-style command is a list of lines;
+            // name_ser only ever delivers the first one, as a Bottle.
+            String txt = "NAME_SERVER";
+            ConstString si = cmd.toString();
+            if (si.length()>0) {
+                txt += " ";
+            }
+            for (size_t i=0; i<si.length(); i++) {
+                if (si[i]!='\"') {
+                    txt += si[i];
+                }
+            }
+            String result;
+            if (sendOnConnection(txt,result)) {
+                size_t eol = result.find("\n");
+                reply.fromString(result.substr(0,eol).c_str());
+                return true;
+            }
+        }
         Contact server = getAddress();
         ContactStyle style;
         style.carrier = "name_ser";
@@ -261,6 +404,60 @@ bool NameClient::send(Bottle& cmd, Bottle& reply) {
 }
 
 
+bool NameClient::sendOnConnection(const String& cmd, String& result) {
+    bool ok = false;
+    connectionMutex.lock();
+    for (int attempt=0; attempt<2 && !ok; attempt++) {
+        bool fresh = false;
+        if (connection==NULL) {
+            Contact server = getAddress();
+            server.setTimeout(10);
+            TcpFace face;
+            connection = face.write(server);
+            if (connection==NULL) {
+                break;
+            }
+            fresh = true;
+        }
+        YARP_DEBUG(Logger::get(),String("sending to nameserver: ") + cmd);
+        result = "";
+        String cmdn = cmd + "\n";
+        Bytes b((char*)cmdn.c_str(),cmdn.length());
+        connection->getOutputStream().write(b);
+        while (connection->isOk()) {
+            String line = connection->getInputStream().readLine();
+            if (!connection->isOk()) {
+                break;
+            }
+            result += line + "\n";
+            if (line.length()>1) {
+                if (line[0] == '*'||line[0] == '[') {
+                    ok = true;
+                    break;
+                }
+            }
+        }
+        if (!ok) {
+            // the server may have dropped an idle connection; a fresh
+            // one is tried once before falling back to the caller
+            connection->close();
+            delete connection;
+            connection = NULL;
+            if (fresh) {
+                break;
+            }
+        }
+    }
+    connectionMutex.unlock();
+    if (ok) {
+        YARP_SPRINTF1(Logger::get(),
+                      debug,
+                      "<<< received from nameserver: %s",result.c_str());
+    }
+    return ok;
+}
+
+
 
 Contact NameClient::queryName(const String& name) {
     String np = getNamePart(name);
@@ -277,9 +474,18 @@ Contact NameClient::queryName(const String& name) {
         return c;
     }
 
+    NameClientCache *cache = getCache();
+    Contact c;
+    if (cache!=NULL && cache->lookup(np,c)) {
+        return c;
+    }
     String q("NAME_SERVER query ");
     q += np;
-    return probe(q);
+    c = probe(q);
+    if (cache!=NULL && c.isValid()) {
+        cache->store(np,c);
+    }
+    return c;
 }
 
 Contact NameClient::registerName(const String& name) {
@@ -329,6 +535,7 @@ Contact NameClient::registerName(const String& name, const Contact& suggest) {
         }
     }
     Bottle reply;
+    forget(np);
     send(cmd,reply);
 
     Contact address = extractAddress(reply);
@@ -369,11 +576,79 @@ Contact NameClient::unregisterName(const String& name) {
     String np = getNamePart(name);
     String q("NAME_SERVER unregister ");
     q += np;
+    forget(np);
     return probe(q);
 }
 
 
+NameClientCache *NameClient::getCache() {
+    if (fake||altStore!=NULL||NetworkBase::getQueryBypass()) {
+        return NULL;
+    }
+    NameClientCache *cache = NULL;
+    __name_cache_mutex.lock();
+    if (__name_cache_state==NAME_CACHE_IDLE) {
+        double lifetime = atof(NetworkBase::getEnvironment("YARP_NAME_CACHE").c_str());
+        if (lifetime>0) {
+            // opening the cache port goes through the name client,
+            // which must not try to use the cache in the meantime
+            __name_cache_state = NAME_CACHE_STARTING;
+            __name_cache_mutex.unlock();
+            cache = new NameClientCache(getAddress(),lifetime);
+            yAssert(cache!=NULL);
+            bool ok = cache->open();
+            if (!ok) {
+                delete cache;
+                cache = NULL;
+            }
+            __name_cache_mutex.lock();
+            __name_cache = cache;
+            __name_cache_state = ok?NAME_CACHE_ACTIVE:NAME_CACHE_DISABLED;
+        } else {
+            __name_cache_state = NAME_CACHE_DISABLED;
+        }
+    }
+    if (__name_cache_state==NAME_CACHE_ACTIVE) {
+        if (__name_cache->serves(getAddress())) {
+            cache = __name_cache;
+        }
+    }
+    __name_cache_mutex.unlock();
+    return cache;
+}
+
+
+void NameClient::forget(const String& name) {
+    __name_cache_mutex.lock();
+    if (__name_cache_state==NAME_CACHE_ACTIVE) {
+        __name_cache->forget(name);
+    }
+    __name_cache_mutex.unlock();
+}
+
+
+void NameClient::removeCache() {
+    __name_cache_mutex.lock();
+    NameClientCache *cache = __name_cache;
+    __name_cache = NULL;
+    __name_cache_state = NAME_CACHE_DISABLED;
+    __name_cache_mutex.unlock();
+    if (cache!=NULL) {
+        cache->close();
+        delete cache;
+    }
+    __name_cache_mutex.lock();
+    __name_cache_state = NAME_CACHE_IDLE;
+    __name_cache_mutex.unlock();
+}
+
+
 NameClient::~NameClient() {
+    if (connection!=NULL) {
+        connection->close();
+        delete connection;
+        connection = NULL;
+    }
     if (fakeServer!=NULL) {
         delete fakeServer;
         fakeServer = NULL;
@@ -422,6 +697,7 @@ NameClient::NameClient() {
     fake = false;
     fakeServer = NULL;
     altStore = NULL;
+    connection = NULL;
 }
 
 void NameClient::setup() {
@@ -66,8 +66,10 @@ int NetType::toInt(const ConstString& x) {
   (from http://www.w3.org/TR/PNG-CRCAppendix.html)
 */
 
-/* Table of CRCs of all 8-bit messages. */
-static unsigned long crc_table[256];
+/* Table of CRCs of all 8-bit messages, followed by the tables for
+   "slicing by 8": crc_table[k][n] is the CRC of byte n followed by k
+   zero bytes, so that 8 bytes at a time are folded with 8 lookups. */
+static unsigned long crc_table[8][256];
 
 /* Flag: has the table been computed? Initially false. */
 static int crc_table_computed = 0;
@@ -85,7 +87,14 @@ static void make_crc_table(void) {
             else
                 c = c >> 1;
         }
-        crc_table[n] = c;
+        crc_table[0][n] = c;
+    }
+    for (n = 0; n < 256; n++) {
+        c = crc_table[0][n];
+        for (k = 1; k < 8; k++) {
+            c = crc_table[0][c & 0xff] ^ (c >> 8);
+            crc_table[k][n] = c;
+        }
     }
     crc_table_computed = 1;
 }
@@ -97,14 +106,26 @@ static void make_crc_table(void) {
 
 static unsigned long update_crc(unsigned long crc, unsigned char *buf,
                                 size_t len) {
-
     unsigned long c = crc;
-    size_t n;
   
     if (!crc_table_computed)
         make_crc_table();
-    for (n = 0; n < len; n++) {
-        c = crc_table[(c ^ buf[n]) & 0xff] ^ (c >> 8);
+    // the bytes are combined explicitly, so this does not depend on
+    // the alignment of buf nor on the byte order of the machine
+    while (len >= 8) {
+        c ^= (unsigned long)buf[0] | ((unsigned long)buf[1] << 8) |
+            ((unsigned long)buf[2] << 16) | ((unsigned long)buf[3] << 24);
+        c = crc_table[7][c & 0xff] ^ crc_table[6][(c >> 8) & 0xff] ^
+            crc_table[5][(c >> 16) & 0xff] ^ crc_table[4][(c >> 24) & 0xff] ^
+            crc_table[3][buf[4]] ^ crc_table[2][buf[5]] ^
+            crc_table[1][buf[6]] ^ crc_table[0][buf[7]];
+        buf += 8;
+        len -= 8;
+    }
+    while (len > 0) {
+        c = crc_table[0][(c ^ *buf) & 0xff] ^ (c >> 8);
+        buf++;
+        len--;
     }
     return c;
 }
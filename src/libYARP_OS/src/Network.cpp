@@ -636,6 +636,7 @@ void NetworkBase::initMinimum() {
 void NetworkBase::finiMinimum() {
     if (__yarp_is_initialized==1) {
         Time::useSystemClock();
+        NameClient::removeCache();
         Carriers::removeInstance();
         NameClient::removeNameClient();
         removeNameSpace();
@@ -718,6 +719,22 @@ ConstString NetworkBase::readString(bool *eof) {
     return ConstString(Companion::readString(eof).c_str());
 }
 
+static bool hasQos(const QosStyle& style) {
+    return style.getPacketPriorityAsTOS()!=-1 || style.getThreadPolicy()!=-1 ||
+        style.getMaxRate()>0 || style.getDropWhenBusy();
+}
+
+static void addQos(Property& qos_prop, const QosStyle& style) {
+    // the tos is left alone if only the rate or dropping is set
+    bool sending = style.getMaxRate()>0 || style.getDropWhenBusy();
+    if(style.getPacketPriorityAsTOS()!=-1 || !sending)
+        qos_prop.put("tos", style.getPacketPriorityAsTOS());
+    if(style.getMaxRate()>0)
+        qos_prop.put("rate", style.getMaxRate());
+    if(style.getDropWhenBusy())
+        qos_prop.put("drop", 1);
+}
+
 bool NetworkBase::setConnectionQos(const ConstString& src, const ConstString& dest,
                                    const QosStyle& style, bool quiet) {
     return setConnectionQos(src, dest, style, style, quiet);
@@ -728,10 +745,11 @@ bool NetworkBase::setConnectionQos(const ConstString& src, const ConstString& de
                                    bool quiet) {
 
     //e.g.,  prop set /portname (sched ((priority 30) (policy 1))) (qos ((tos 0)))
+    //       prop set /portname (qos ((rate 10) (drop 1)))
     yarp::os::Bottle cmd, reply;
 
     // ignore if everything left as default
-    if(srcStyle.getPacketPriorityAsTOS()!=-1 || srcStyle.getThreadPolicy() !=-1) {
+    if(hasQos(srcStyle)) {
         // set the source Qos
         cmd.addString("prop");
         cmd.addString("set");
@@ -744,7 +762,7 @@ bool NetworkBase::setConnectionQos(const ConstString& src, const ConstString& de
         Bottle& qos = cmd.addList();
         qos.addString("qos");
         Property& qos_prop = qos.addDict();
-        qos_prop.put("tos", srcStyle.getPacketPriorityAsTOS());
+        addQos(qos_prop, srcStyle);
         Contact srcCon = Contact::fromString(src);
         bool ret = write(srcCon, cmd, reply, true, true, 2.0);
         if(!ret) {
@@ -761,7 +779,7 @@ bool NetworkBase::setConnectionQos(const ConstString& src, const ConstString& de
     }
 
     // ignore if everything left as default
-    if(destStyle.getPacketPriorityAsTOS()!=-1 || destStyle.getThreadPolicy() !=-1) {
+    if(hasQos(destStyle)) {
         // set the destination Qos
         cmd.clear();
         reply.clear();
@@ -776,7 +794,7 @@ bool NetworkBase::setConnectionQos(const ConstString& src, const ConstString& de
         Bottle& qos2 = cmd.addList();
         qos2.addString("qos");
         Property& qos_prop2 = qos2.addDict();
-        qos_prop2.put("tos", destStyle.getPacketPriorityAsTOS());
+        addQos(qos_prop2, destStyle);
         Contact destCon = Contact::fromString(dest);
         bool ret = write(destCon, cmd, reply, true, true, 2.0);
         if(!ret) {
@@ -825,6 +843,10 @@ static bool getPortQos(const ConstString& port, const ConstString& unit,
     Bottle& qos = reply.findGroup("qos");
     Bottle* qos_prop = qos.find("qos").asList();
     style.setPacketPrioritybyTOS(qos_prop->find("tos").asInt());
+    if(qos_prop->check("rate"))
+        style.setMaxRate(qos_prop->find("rate").asDouble());
+    if(qos_prop->check("drop"))
+        style.setDropWhenBusy(qos_prop->find("drop").asInt()!=0);
 
     return true;
 }
@@ -10,6 +10,7 @@
 #include <yarp/os/impl/Logger.h>
 #include <yarp/os/impl/PortCore.h>
 #include <yarp/os/impl/BufferedConnectionWriter.h>
+#include <yarp/os/impl/DgramTwoWayStream.h>
 #include <yarp/os/impl/PortCoreInputUnit.h>
 #include <yarp/os/impl/PortCoreOutputUnit.h>
 #include <yarp/os/impl/StreamConnectionReader.h>
@@ -689,6 +690,7 @@ void PortCore::addOutput(OutputProtocol *op) {
     if (!finished) {
         PortCoreUnit *unit = new PortCoreOutputUnit(*this,getNextIndex(),op);
         yAssert(unit!=NULL);
+        shareLayerQos(unit,true);
         unit->start();
         units.push_back(unit);
     }
@@ -1289,6 +1291,12 @@ bool PortCore::sendHelper(PortWriter& writer,
     PortCorePacket *packet = packets.getFreePacket();
     yAssert(packet!=NULL);
     packet->setContent(&writer,false,callback);
+    // Connections can recognize the message by this id and share work
+    // on it (e.g. the tcpros carrier's translation to the ROS format).
+    // 0 is reserved for "unknown".
+    messageCounter++;
+    if (messageCounter<=0) messageCounter = 1;
+    packet->setId(messageCounter);
     packetMutex.post();
 
     // Scan connections, placing message everyhere we can.
@@ -1305,9 +1313,8 @@ bool PortCore::sendHelper(PortWriter& writer,
             if (!ok) continue;
             bool waiter = waitAfterSend||(mode==PORTCORE_SEND_LOG);
             YMSG(("------- -- inc\n"));
-            packetMutex.wait();
             packet->inc();  // One more connection carrying message.
-            packetMutex.post();
+                            // No lock needed, we hold a reference.
             YMSG(("------- -- presend\n"));
             bool gotReplyOne = false;
             // Send the message off on this connection.
@@ -1321,11 +1328,8 @@ bool PortCore::sendHelper(PortWriter& writer,
             YMSG(("------- -- send\n"));
             if (out!=NULL) {
                 // We got back a report of a message already sent.
-                packetMutex.wait();
-                ((PortCorePacket *)out)->dec();  // Message on one
-                                                 // fewer connections.
-                packets.checkPacket((PortCorePacket *)out);
-                packetMutex.post();
+                releasePacket((PortCorePacket *)out);  // Message on one
+                                                       // fewer connections.
             }
             if (waiter) {
                 if (unit->isFinished()) {
@@ -1336,12 +1340,10 @@ bool PortCore::sendHelper(PortWriter& writer,
         }
     }
     YMSG(("------- pack check\n"));
-    packetMutex.wait();
-    packet->dec();  // We no longer concern ourselves with the message.
-                    // It may or may not be traveling on some connections.
-                    // But that is not our problem anymore.
-    packets.checkPacket(packet);
-    packetMutex.post();
+    releasePacket(packet);  // We no longer concern ourselves with the
+                            // message.  It may or may not be traveling
+                            // on some connections.  But that is not our
+                            // problem anymore.
     YMSG(("------- packed\n"));
     YMSG(("------- send out\n"));
     if (mode==PORTCORE_SEND_LOG) {
@@ -1409,16 +1411,24 @@ int PortCore::getOutputCount() {
 
 void PortCore::notifyCompletion(void *tracker) {
     YMSG(("starting notifyCompletion\n"));
-    packetMutex.wait();
     if (tracker!=NULL) {
-        ((PortCorePacket *)tracker)->dec();
-        packets.checkPacket((PortCorePacket *)tracker);
+        releasePacket((PortCorePacket *)tracker);
     }
-    packetMutex.post();
     YMSG(("stopping notifyCompletion\n"));
 }
 
 
+void PortCore::releasePacket(PortCorePacket *packet) {
+    // The usage count is atomic, so only the last user of a packet
+    // needs to touch the shared pool.
+    if (packet->dec()<=0) {
+        packetMutex.wait();
+        packets.checkPacket(packet);
+        packetMutex.post();
+    }
+}
+
+
 bool PortCore::setEnvelope(PortWriter& envelope) {
     envelopeWriter.restart();
     bool ok = envelope.write(envelopeWriter);
@@ -2029,6 +2039,28 @@ bool PortCore::adminBlock(ConnectionReader& reader, void *id,
                                                 qos.addString("qos");
                                                 Property& qos_prop = qos.addDict();
                                                 qos_prop.put("tos", tos);
+                                                if (unit->isOutput()) {
+                                                    PortCoreOutputUnit *out = dynamic_cast<PortCoreOutputUnit*>(unit);
+                                                    qos_prop.put("rate", out->getMaxRate());
+                                                    qos_prop.put("drop", out->getDropWhenBusy()?1:0);
+                                                }
+                                                // reception statistics of datagram
+                                                // connections, e.g. for a sender to
+                                                // check how its receivers keep up
+                                                if (unit->isInput()) {
+                                                    InputProtocol *ip = dynamic_cast<PortCoreInputUnit*>(unit)->getInPutProtocol();
+                                                    DgramTwoWayStream *dgram = NULL;
+                                                    if (ip) {
+                                                        dgram = dynamic_cast<DgramTwoWayStream*>(&ip->getInputStream());
+                                                    }
+                                                    if (dgram) {
+                                                        Bottle& stats = result.addList();
+                                                        stats.addString("stats");
+                                                        Property& stats_prop = stats.addDict();
+                                                        stats_prop.put("dgrams", dgram->getDgramCount());
+                                                        stats_prop.put("dropped", dgram->getDropCount());
+                                                    }
+                                                }
                                             }
                                         } // end isFinished()
                                     } // end for loop
@@ -2164,6 +2196,22 @@ bool PortCore::adminBlock(ConnectionReader& reader, void *id,
                                                     // set the TOS value (backward compatibility)
                                                     bOk = setTypeOfService(unit, tos);
                                                 }
+                                                // e.g., "prop set /portname (qos ((rate 10) (drop 1)))"
+                                                // these only concern the sending side
+                                                if(qos_prop->check("rate") || qos_prop->check("drop")) {
+                                                    if(!qos_prop->check("priority") &&
+                                                       !qos_prop->check("dscp") &&
+                                                       !qos_prop->check("tos"))
+                                                        bOk = true;
+                                                    if(unit->isOutput()) {
+                                                        PortCoreOutputUnit *out = dynamic_cast<PortCoreOutputUnit*>(unit);
+                                                        if(qos_prop->check("rate"))
+                                                            out->setMaxRate(qos_prop->find("rate").asDouble());
+                                                        if(qos_prop->check("drop"))
+                                                            out->setDropWhenBusy(qos_prop->find("drop").asInt()!=0);
+                                                        shareLayerQos(unit,false);
+                                                    }
+                                                }
                                             }
                                             else
                                                 bOk = false;
@@ -2261,6 +2309,40 @@ int PortCore::getTypeOfService(PortCoreUnit *unit) {
     return -1;
 }
 
+static bool isLayer(PortCoreUnit *unit, const String& carrier) {
+    if (unit==NULL || !unit->isOutput() || unit->isFinished()) {
+        return false;
+    }
+    OutputProtocol *op = dynamic_cast<PortCoreOutputUnit*>(unit)->getOutPutProtocol();
+    return op!=NULL && op->getConnection().isBroadcast() &&
+        op->getRoute().getCarrierName()==carrier;
+}
+
+void PortCore::shareLayerQos(PortCoreUnit *unit, bool adopt) {
+    PortCoreOutputUnit *out = dynamic_cast<PortCoreOutputUnit*>(unit);
+    if (out==NULL || out->getOutPutProtocol()==NULL) {
+        return;
+    }
+    OutputProtocol *op = out->getOutPutProtocol();
+    if (!op->getConnection().isBroadcast()) {
+        return;
+    }
+    String carrier = op->getRoute().getCarrierName();
+    for (unsigned int i=0; i<units.size(); i++) {
+        if (units[i]==unit || !isLayer(units[i],carrier)) {
+            continue;
+        }
+        PortCoreOutputUnit *peer = dynamic_cast<PortCoreOutputUnit*>(units[i]);
+        if (adopt) {
+            out->setMaxRate(peer->getMaxRate());
+            out->setDropWhenBusy(peer->getDropWhenBusy());
+            return;
+        }
+        peer->setMaxRate(out->getMaxRate());
+        peer->setDropWhenBusy(out->getDropWhenBusy());
+    }
+}
+
 void PortCore::reportUnit(PortCoreUnit *unit, bool active) {
     if (unit!=NULL) {
         bool isLog = (unit->getMode()!="");
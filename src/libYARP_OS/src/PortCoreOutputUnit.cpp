@@ -14,9 +14,12 @@
 #include <yarp/os/impl/PortCommand.h>
 #include <yarp/os/impl/Logger.h>
 #include <yarp/os/impl/BufferedConnectionWriter.h>
+#include <yarp/os/impl/PortCorePacket.h>
 #include <yarp/os/Name.h>
 #include <yarp/os/impl/Companion.h>
 
+#include <string.h>
+
 
 #define YMSG(x) ACE_OS::printf x;
 #define YTRACE(x) YMSG(("at %s\n",x))
@@ -25,6 +28,31 @@
 using namespace yarp::os::impl;
 using namespace yarp::os;
 
+bool PortCoreMessageCopy::copy(PortWriter& writer, bool textMode,
+                               bool bareMode) {
+    BufferedConnectionWriter buf(textMode,bareMode);
+    if (!writer.write(buf)) return false;
+    buf.stopWrite();
+    dropRequested = buf.dropRequested();
+    size_t len = buf.dataSize();
+    data.allocateOnNeed(len,len);
+    size_t at = 0;
+    for (size_t i=0; i<buf.length(); i++) {
+        memcpy(data.get()+at,buf.data(i),buf.length(i));
+        at += buf.length(i);
+    }
+    data.setUsed(len);
+    return true;
+}
+
+bool PortCoreMessageCopy::write(ConnectionWriter& connection) {
+    connection.appendExternalBlock(data.get(),data.used());
+    if (dropRequested) {
+        connection.requestDrop();
+    }
+    return !connection.isError();
+}
+
 bool PortCoreOutputUnit::start() {
 
     phase.wait();
@@ -242,7 +270,7 @@ bool PortCoreOutputUnit::sendHelper() {
             buf.setReplyHandler(*cachedReader);
         }
 
-        if(op->getSender().modifiesOutgoingData())
+        if(op->getSender().modifiesOutgoingData() && !cachedModified)
         {
             if(op->getSender().acceptOutgoingData(*cachedWriter))
                 cachedWriter = &op->getSender().modifyOutgoingData(*cachedWriter);
@@ -250,6 +278,11 @@ bool PortCoreOutputUnit::sendHelper() {
                return (done = true); 
         }
 
+        // a modified message is specific to this connection
+        if (!op->getSender().modifiesOutgoingData()) {
+            buf.setMessageId(cachedMessageId);
+        }
+
         if (op->getConnection().isLocal()) {
             buf.setReference(dynamic_cast<yarp::os::Portable *>
                              (cachedWriter));
@@ -353,6 +386,14 @@ void *PortCoreOutputUnit::send(yarp::os::PortWriter& writer,
         }
     }
 
+    // A connection that should not hold up the writer sends a copy of
+    // the message in the background.  Replies need the writer to wait.
+    bool detach = dropWhenBusy && waitAfter && waitBefore && reader==NULL &&
+        op!=NULL && !op->getConnection().isLocal();
+    if (detach) {
+        waitAfter = false;
+    }
+
     if (!waitBefore || !waitAfter) {
         if (running == false) {
             // we must have a thread if we're going to be skipping waits
@@ -367,22 +408,61 @@ void *PortCoreOutputUnit::send(yarp::os::PortWriter& writer,
         YARP_ERROR(Logger::get(), "chosen port wait combination not yet implemented");
     }
     if (!sending) {
+        // only a message that is actually sent uses up a rate slot
+        if (maxRate>0) {
+            double now = Time::now();
+            if (now<nextSend) {
+                // too soon after the last message sent on this connection
+                return tracker;
+            }
+            nextSend += 1.0/maxRate;
+            if (nextSend<=now) {
+                nextSend = now+1.0/maxRate;
+            }
+        }
+
         cachedWriter = &writer;
         cachedReader = reader;
         cachedCallback = callback;
         cachedEnvelope = envelopeString;
-
-        sending = true;
-        if (waitAfter==true) {
-            replied = sendHelper();
-            sending = false;
-        } else {
-            trackerMutex.wait();
-            void *nextTracker = tracker;
-            tracker = cachedTracker;
-            cachedTracker = nextTracker;
+        cachedMessageId = (tracker!=NULL)?
+            ((PortCorePacket *)tracker)->getId():0;
+        cachedModified = false;
+
+        if (detach) {
+            // the writer may change the message as soon as we return,
+            // so the modifier (which may need the original object) is
+            // applied and the result serialized here
+            PortWriter *w = &writer;
+            if (op->getSender().modifiesOutgoingData()) {
+                if (!op->getSender().acceptOutgoingData(*w)) {
+                    return tracker;
+                }
+                w = &op->getSender().modifyOutgoingData(*w);
+            }
+            if (!copied.copy(*w,op->getConnection().isTextMode(),
+                             op->getConnection().isBareMode())) {
+                return tracker;
+            }
+            cachedWriter = &copied;
+            cachedCallback = NULL;
+            cachedModified = true;
+            sending = true;
+            // the packet can be released now, nothing refers to it
             activate.post();
-            trackerMutex.post();
+        } else {
+            sending = true;
+            if (waitAfter==true) {
+                replied = sendHelper();
+                sending = false;
+            } else {
+                trackerMutex.wait();
+                void *nextTracker = tracker;
+                tracker = cachedTracker;
+                cachedTracker = nextTracker;
+                activate.post();
+                trackerMutex.post();
+            }
         }
     } else {
         YARP_DEBUG(Logger::get(),
@@ -14,7 +14,9 @@
 yarp::os::QosStyle::QosStyle() :
         threadPriority(-1),
         threadPolicy(-1),
-        packetPriority(-1) {
+        packetPriority(-1),
+        maxRate(0),
+        dropWhenBusy(false) {
 }
 
 void yarp::os::QosStyle::setPacketPriorityByDscp(PacketPriorityDSCP dscp) {
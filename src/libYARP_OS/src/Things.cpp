@@ -15,10 +15,13 @@ Things::Things() {
     writer = NULL;
     reader = NULL;
     portable = NULL;
+    spare = NULL;
     beenRead = false;
 }
 
 Things::~Things() {
     if (portable) delete portable;
     portable = NULL;
+    if (spare) delete spare;
+    spare = NULL;
 }
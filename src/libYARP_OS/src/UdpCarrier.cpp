@@ -7,11 +7,19 @@
 
 #include <yarp/os/impl/UdpCarrier.h>
 #include <yarp/os/impl/String.h>
+#include <yarp/os/Name.h>
 
 using namespace yarp::os;
 using namespace yarp::os::impl;
 
+// added to the specifier by a sender asking to skip the checksum
+#define NO_CRC_SPECIFIER 64
+// added to the port number by a receiver that agrees, port numbers
+// being smaller than this
+#define NO_CRC_REPLY 65536
+
 yarp::os::impl::UdpCarrier::UdpCarrier() {
+    crc = true;
 }
 
 yarp::os::Carrier *yarp::os::impl::UdpCarrier::create() {
@@ -31,10 +39,11 @@ bool yarp::os::impl::UdpCarrier::checkHeader(const Bytes& header) {
 }
 
 void yarp::os::impl::UdpCarrier::getHeader(const Bytes& header) {
-    createStandardHeader(getSpecifierCode(), header);
+    createStandardHeader(getSpecifierCode()+(crc?0:NO_CRC_SPECIFIER), header);
 }
 
 void yarp::os::impl::UdpCarrier::setParameters(const Bytes& header) {
+    crc = (getSpecifier(header)&NO_CRC_SPECIFIER)==0;
 }
 
 bool yarp::os::impl::UdpCarrier::requireAck() {
@@ -46,6 +55,12 @@ bool yarp::os::impl::UdpCarrier::isConnectionless() {
 }
 
 
+bool yarp::os::impl::UdpCarrier::sendHeader(ConnectionState& proto) {
+    Name n(proto.getRoute().getCarrierName() + "://test");
+    crc = n.getCarrierModifier("crc")!="0";
+    return defaultSendHeader(proto);
+}
+
 bool yarp::os::impl::UdpCarrier::respondToHeader(ConnectionState& proto) {
     // I am the receiver
 
@@ -60,8 +75,9 @@ bool yarp::os::impl::UdpCarrier::respondToHeader(ConnectionState& proto) {
         return false;
     }
 
+    stream->setCrc(crc);
     int myPort = stream->getLocalAddress().getPort();
-    writeYarpInt(myPort,proto);
+    writeYarpInt(myPort+(crc?0:NO_CRC_REPLY),proto);
     proto.takeStreams(stream);
 
     return true;
@@ -78,6 +94,11 @@ bool yarp::os::impl::UdpCarrier::expectReplyToHeader(ConnectionState& proto) {
     if (altPort==-1) {
         return false;
     }
+    if (altPort>=NO_CRC_REPLY) {
+        altPort -= NO_CRC_REPLY;
+    } else {
+        crc = true;
+    }
 
     DgramTwoWayStream *stream = new DgramTwoWayStream();
     yAssert(stream!=NULL);
@@ -89,6 +110,7 @@ bool yarp::os::impl::UdpCarrier::expectReplyToHeader(ConnectionState& proto) {
         delete stream;
         return false;
     }
+    stream->setCrc(crc);
     proto.takeStreams(stream);
     return true;
 }
@@ -53,6 +53,22 @@ public:
      * @return true/false upon success/failure
      */
     virtual bool stopRecording() = 0;
+
+    /**
+     * Get the number of samples lost while recording, since the
+     * device was opened.
+     *
+     * @param overruns samples dropped because the device buffer was
+     * full, i.e. the sound was not read fast enough
+     * @param underruns samples missing from the returned sounds (and
+     * replaced by silence) because the device did not provide them in
+     * time
+     * @return true if the device keeps these counters
+     */
+    virtual bool getRecordingCounters(int& overruns, int& underruns) {
+        overruns = underruns = 0;
+        return false;
+    }
 };
 
 
@@ -71,6 +87,21 @@ public:
      * @return true/false upon success/failure
      */
     virtual bool renderSound(yarp::sig::Sound& sound) = 0;
+
+    /**
+     * Get the number of samples lost while rendering, since the
+     * device was opened.
+     *
+     * @param overruns samples dropped because the device buffer was
+     * full, i.e. the sounds were sent faster than they are played
+     * @param underruns silent samples played because no data was
+     * available, including the padding of the last period of a sound
+     * @return true if the device keeps these counters
+     */
+    virtual bool getRenderingCounters(int& overruns, int& underruns) {
+        overruns = underruns = 0;
+        return false;
+    }
 };
 
 
@@ -278,14 +278,14 @@ public:
 
     virtual bool getEncoderSpeed(int j, double *sp) {
         if (j<njoints) {
-            (*sp) = 0;
+            (*sp) = posMode?0:vel[j];
         }
         return true;
     }
 
     virtual bool getEncoderSpeeds(double *spds) {
         for (int i=0; i<njoints; i++) {
-            spds[i] = 0;
+            spds[i] = posMode?0:vel[i];
         }
         return true;
     }
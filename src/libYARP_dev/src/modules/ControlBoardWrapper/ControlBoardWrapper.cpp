@@ -57,6 +57,7 @@ void ControlBoardWrapper::cleanup_yarpPorts()
 
     inputStreamingPort.interrupt();
     inputStreamingPort.close();
+    streaming_parser.close();
 
     outputPositionStatePort.interrupt();
     outputPositionStatePort.close();
@@ -326,6 +327,14 @@ bool ControlBoardWrapper::initialize_YARP(yarp::os::Searchable &prop)
         {
             yInfo() << partName << " initting YARP initialization";
             // initialize callback
+            ConstString streamingMode = prop.check("streaming_mode", Value("direct"), "direct or latest").asString();
+            if (streamingMode!="direct" && streamingMode!="latest")
+            {
+                yError() << "streaming_mode must be direct or latest, not" << streamingMode;
+                success = false;
+                break;
+            }
+            streaming_parser.setLatestMode(streamingMode=="latest");
             if (!streaming_parser.initialize())
             {
                 yError() <<"Error could not initialize callback object";
@@ -847,25 +856,80 @@ void ControlBoardWrapper::run()
         yarp::sig::Vector& v = outputPositionStatePort.prepare();
         v.size(controlledJoints);
 
-        //getEncoders for all subdevices
-        double *joint_encoders=v.data();
-        double joint_timeStamp=0.0;
+        jointData &yarp_struct = extendedOutputState_buffer.get();
 
+        yarp_struct.jointPosition.resize(controlledJoints);
+        yarp_struct.jointVelocity.resize(controlledJoints);
+        yarp_struct.jointAcceleration.resize(controlledJoints);
+        yarp_struct.motorPosition.resize(controlledJoints);
+        yarp_struct.motorVelocity.resize(controlledJoints);
+        yarp_struct.motorAcceleration.resize(controlledJoints);
+        yarp_struct.torque.resize(controlledJoints);
+        yarp_struct.pidOutput.resize(controlledJoints);
+        yarp_struct.controlMode.resize(controlledJoints);
+        yarp_struct.interactionMode.resize(controlledJoints);
+
+        double *doubles[SubDevice::STATE_DOUBLE_FIELDS] = {
+            yarp_struct.jointPosition.data(),
+            yarp_struct.jointVelocity.data(),
+            yarp_struct.jointAcceleration.data(),
+            yarp_struct.motorPosition.data(),
+            yarp_struct.motorVelocity.data(),
+            yarp_struct.motorAcceleration.data(),
+            yarp_struct.torque.data(),
+            yarp_struct.pidOutput.data()
+        };
+        int *ints[SubDevice::STATE_FIELDS-SubDevice::STATE_DOUBLE_FIELDS] = {
+            yarp_struct.controlMode.data(),
+            yarp_struct.interactionMode.data()
+        };
+        bool valid[SubDevice::STATE_FIELDS];
+        for (int f=0; f<SubDevice::STATE_FIELDS; f++)
+            valid[f] = true;
+
+        // one reading of each field per subdevice, so the joints of a part
+        // are coherent with each other even when the parts are remote
+        double joint_timeStamp=0.0;
+        int first=0;
         for(unsigned int k=0;k<device.subdevices.size();k++)
         {
-            int axes=device.subdevices[k].axes;
+            SubDevice &s=device.subdevices[k];
+            s.refreshState();
 
-            device.subdevices[k].refreshJointEncoders();
-            device.subdevices[k].refreshMotorEncoders();
+            for (int f=0; f<SubDevice::STATE_DOUBLE_FIELDS; f++)
+            {
+                valid[f] = valid[f] && s.stateValid[f];
+                if (s.stateValid[f])
+                    memcpy(doubles[f]+first, &s.state[f][s.base], s.axes*sizeof(double));
+            }
+            for (int f=SubDevice::STATE_DOUBLE_FIELDS; f<SubDevice::STATE_FIELDS; f++)
+            {
+                valid[f] = valid[f] && s.stateValid[f];
+                if (s.stateValid[f])
+                    memcpy(ints[f-SubDevice::STATE_DOUBLE_FIELDS]+first, &s.stateModes[f-SubDevice::STATE_DOUBLE_FIELDS][s.base], s.axes*sizeof(int));
+            }
 
-            for(int l=0;l<axes;l++)
+            if (s.stateValid[SubDevice::STATE_ENCODERS])
             {
-                joint_encoders[l]=device.subdevices[k].subDev_joint_encoders[l];
-                joint_timeStamp+=device.subdevices[k].jointEncodersTimes[l];
+                for(int l=0;l<s.axes;l++)
+                    joint_timeStamp+=s.stateEncoderTimes[s.base+l];
             }
-            joint_encoders+=device.subdevices[k].axes; //jump to next group
+            first+=s.axes; //jump to next group
         }
 
+        yarp_struct.jointPosition_isValid       = valid[SubDevice::STATE_ENCODERS];
+        yarp_struct.jointVelocity_isValid       = valid[SubDevice::STATE_ENCODER_SPEEDS];
+        yarp_struct.jointAcceleration_isValid   = valid[SubDevice::STATE_ENCODER_ACCELERATIONS];
+        yarp_struct.motorPosition_isValid       = valid[SubDevice::STATE_MOTOR_ENCODERS];
+        yarp_struct.motorVelocity_isValid       = valid[SubDevice::STATE_MOTOR_ENCODER_SPEEDS];
+        yarp_struct.motorAcceleration_isValid   = valid[SubDevice::STATE_MOTOR_ENCODER_ACCELERATIONS];
+        yarp_struct.torque_isValid              = valid[SubDevice::STATE_TORQUES];
+        yarp_struct.pidOutput_isValid           = valid[SubDevice::STATE_OUTPUTS];
+        yarp_struct.controlMode_isValid         = valid[SubDevice::STATE_CONTROL_MODES];
+        yarp_struct.interactionMode_isValid     = valid[SubDevice::STATE_INTERACTION_MODES];
+
+        memcpy(v.data(), yarp_struct.jointPosition.data(), controlledJoints*sizeof(double));
+
         //joint_timeStamp =  yarp::os::Time::now();
         timeMutex.wait();
         time.update(joint_timeStamp/controlledJoints);
@@ -874,39 +938,16 @@ void ControlBoardWrapper::run()
         outputPositionStatePort.setEnvelope(time);
         outputPositionStatePort.write();
 
-        jointData &yarp_struct = extendedOutputState_buffer.get();
-
-        yarp_struct.jointPosition.resize(controlledJoints);
-        yarp_struct.jointVelocity.resize(controlledJoints);
-        yarp_struct.jointAcceleration.resize(controlledJoints);
-        yarp_struct.motorPosition.resize(controlledJoints);
-        yarp_struct.motorVelocity.resize(controlledJoints);
-        yarp_struct.motorAcceleration.resize(controlledJoints);
-        yarp_struct.torque.resize(controlledJoints);
-        yarp_struct.pidOutput.resize(controlledJoints);
-        yarp_struct.controlMode.resize(controlledJoints);
-        yarp_struct.interactionMode.resize(controlledJoints);
-
-        yarp_struct.jointPosition_isValid       = getEncoders(yarp_struct.jointPosition.data());
-        yarp_struct.jointVelocity_isValid       = getEncoderSpeeds(yarp_struct.jointVelocity.data());
-        yarp_struct.jointAcceleration_isValid   = getEncoderAccelerations(yarp_struct.jointAcceleration.data());
-        yarp_struct.motorPosition_isValid       = getMotorEncoders(yarp_struct.motorPosition.data());
-        yarp_struct.motorVelocity_isValid       = getMotorEncoderSpeeds(yarp_struct.motorVelocity.data());
-        yarp_struct.motorAcceleration_isValid   = getMotorEncoderAccelerations(yarp_struct.motorAcceleration.data());
-        yarp_struct.torque_isValid              = getTorques(yarp_struct.torque.data());
-        yarp_struct.pidOutput_isValid           = getOutputs(yarp_struct.pidOutput.data());
-        yarp_struct.controlMode_isValid         = getControlModes(yarp_struct.controlMode.data());
-        yarp_struct.interactionMode_isValid     = getInteractionModes((yarp::dev::InteractionModeEnum* ) yarp_struct.interactionMode.data());
-
         extendedOutputStatePort.setEnvelope(time);
         extendedOutputState_buffer.write();
     }
 
     if(useROS != ROS_disabled)
     {
-        sensor_msgs_JointState ros_struct;
+        // the messages handed out by prepare() are recycled, so after the
+        // first cycles the resizes and the names cost nothing
+        sensor_msgs_JointState& ros_struct = rosPublisherPort.prepare();
 
-        ros_struct.name.resize(controlledJoints);
         ros_struct.position.resize(controlledJoints);
         ros_struct.velocity.resize(controlledJoints);
         ros_struct.effort.resize(controlledJoints);
@@ -917,12 +958,13 @@ void ControlBoardWrapper::run()
 
         convertDegreesToRadians(ros_struct.position);
         convertDegreesToRadians(ros_struct.velocity);
-        ros_struct.name=jointNames;
+        if (ros_struct.name != jointNames)
+            ros_struct.name=jointNames;
 
         ros_struct.header.seq = rosMsgCounter++;
         ros_struct.header.stamp = normalizeSecNSec(yarp::os::Time::now());
 
-        rosPublisherPort.write(ros_struct);
+        rosPublisherPort.write();
     }
 }
 
@@ -157,6 +157,11 @@ public:
  * It can merge toghether more than one control board device, or use only a
  * portion of it by remapping functionality.
  * Allows also deferred attach/detach of a subdevice.
+ * The state of all the merged parts is published in one message per period
+ * on the stateExt:o port, each part being read with one call per field, so
+ * that a client reading several parts (e.g. a whole-body controller
+ * attaching the remote_controlboard of each part to one wrapper) receives
+ * them together, with a single stamp.
  *
  *
  *  Parameters required by this device are:
@@ -164,6 +169,7 @@ public:
  * |:--------------:|:--------------:|:-------:|:--------------:|:-------------:|:--------------------------: |:-----------------------------------------------------------------:|:-----:|
  * | name           |      -         | string  | -              |   -           | Yes                         | full name of the port opened by the device, like /robotName/part/ | MUST start with a '/' character |
  * | period         |      -         | int     | ms             |   20          | No                          | refresh period of the broadcasted values in ms                    | optional, default 20ms |
+ * | streaming_mode |      -         | string  | direct/latest  |   direct      | No                          | 'direct' applies each message of the command:i port as it is read, 'latest' keeps only the newest position direct, velocity, torque and open loop setpoint of each joint and applies them from a dedicated thread, in one call for all the joints | use 'latest' when commands are streamed faster than the subdevices accept them |
  * | subdevice      |      -         | string  | -              |   -           | alternative to netwok group | name of the subdevice to instantiate                              | when used, parameters for the subdevice must be provided as well |
  * | networks       |      -         | group   | -              |   -           | alternative to subdevice    | this is expected to be a group parameter in xml format, a list in .ini file format. SubParameter are mandatory if this is used| - |
  * | -              | networkName_1  | 4 * int | joint number   |   -           |   if networks is used       | describe how to match subdevice_1 joints with the wrapper joints. First 2 numbers indicate first/last wrapper joint, last 2 numbers are subdevice first/last joint | The joints are intended to be consequent |
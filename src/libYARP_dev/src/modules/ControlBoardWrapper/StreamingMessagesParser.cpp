@@ -12,13 +12,70 @@
 #include <yarp/os/LogStream.h>
 
 using namespace yarp::os;
+using namespace yarp::os::impl;
 using namespace yarp::dev;
 using namespace yarp::dev::impl;
 using namespace yarp::sig;
 using namespace std;
 
 
-StreamingMessagesParser::StreamingMessagesParser() {}
+StreamingCommandSlots::StreamingCommandSlots() :
+    nJoints(0)
+{
+    for (int k=0; k<KINDS; k++)
+        seq[k] = NULL;
+}
+
+StreamingCommandSlots::~StreamingCommandSlots()
+{
+    for (int k=0; k<KINDS; k++)
+        delete[] seq[k];
+}
+
+void StreamingCommandSlots::resize(int joints)
+{
+    nJoints = joints;
+    for (int k=0; k<KINDS; k++)
+    {
+        delete[] seq[k];
+        seq[k] = new AtomicCounter[joints];
+        slot[k].assign(joints, 0.0);
+        taken[k].assign(joints, 0);
+    }
+}
+
+void StreamingCommandSlots::set(int kind, int j, double value)
+{
+    seq[kind][j].inc();
+    slot[kind][j] = value;
+    seq[kind][j].inc();
+}
+
+int StreamingCommandSlots::take(int kind, int *joints, double *values)
+{
+    int n = 0;
+    for (int j=0; j<nJoints; j++)
+    {
+        int s = seq[kind][j].get();
+        if (s==taken[kind][j] || (s&1))
+            continue;
+        double v = slot[kind][j];
+        if (seq[kind][j].get()!=s)
+            continue;   // being written, the writer will wake us again
+        taken[kind][j] = s;
+        joints[n] = j;
+        values[n] = v;
+        n++;
+    }
+    return n;
+}
+
+
+StreamingMessagesParser::StreamingMessagesParser() :
+    stream_nJoints(0),
+    latest(false),
+    wake(0)
+{}
 
 void StreamingMessagesParser::init(ControlBoardWrapper *x) {
     stream_nJoints = 0;
@@ -38,6 +95,202 @@ bool StreamingMessagesParser::initialize()
     if (stream_IPosCtrl)
         stream_IPosCtrl->getAxes(&stream_nJoints);
 
+    if (latest && stream_nJoints>0)
+    {
+        slots.resize(stream_nJoints);
+        batchJoints.resize(stream_nJoints);
+        batchValues.resize(stream_nJoints);
+        awake.set(0);
+        if (!start())
+        {
+            yError("Cannot start the thread applying the streamed commands");
+            return false;
+        }
+    }
+    return true;
+}
+
+void StreamingMessagesParser::close()
+{
+    if (isRunning())
+        stop();
+}
+
+void StreamingMessagesParser::onStop()
+{
+    wake.post();
+}
+
+void StreamingMessagesParser::run()
+{
+    while (!isStopping())
+    {
+        wake.wait();
+        if (isStopping())
+            break;
+        awake.set(0);
+        applyLatest();
+    }
+}
+
+void StreamingMessagesParser::applyLatest()
+{
+    int *joints = &batchJoints[0];
+    double *values = &batchValues[0];
+    int n;
+
+    n = slots.take(StreamingCommandSlots::POSITION_DIRECT, joints, values);
+    if (n>0 && !stream_IPosDirect->setPositions(n, joints, values))
+        yError("Error while trying to command a streaming position direct message on %d joints\n", n);
+
+    n = slots.take(StreamingCommandSlots::VELOCITY, joints, values);
+    if (n>0 && !stream_IVel2->velocityMove(n, joints, values))
+        yError("Error while trying to command a velocity move on %d joints\n", n);
+
+    n = slots.take(StreamingCommandSlots::TORQUE, joints, values);
+    if (n>0 && !stream_ITorque->setRefTorques(n, joints, values))
+        yError("Error while trying to command a streaming torque direct message on %d joints\n", n);
+
+    n = slots.take(StreamingCommandSlots::OPENLOOP, joints, values);
+    if (n==stream_nJoints)
+    {
+        if (!stream_IOpenLoop->setRefOutputs(values))
+            yError("Errors while trying to command an open loop message");
+    }
+    else
+    {
+        for (int i=0; i<n; i++)
+        {
+            if (!stream_IOpenLoop->setRefOutput(joints[i], values[i]))
+                yError("Errors while trying to command an open loop message on joint %d", joints[i]);
+        }
+    }
+}
+
+bool StreamingMessagesParser::storeGroup(int kind, Bottle& b, Vector& cmdVector)
+{
+    int n_joints = b.get(1).asInt();
+    Bottle *jlut = b.get(2).asList();
+    if (jlut==NULL || (int)jlut->size()!=n_joints || (int)cmdVector.size()!=n_joints)
+    {
+        yarp::os::ConstString str = yarp::os::Vocab::decode(b.get(0).asVocab());
+        yError("Received %s size of joints vector or values vector does not match the selected joint number\n", str.c_str());
+        return false;
+    }
+    for (int i=0; i<n_joints; i++)
+    {
+        int j = jlut->get(i).asInt();
+        if (j<0 || j>=stream_nJoints)
+        {
+            yError("Received streaming command for joint %d out of range\n", j);
+            return false;
+        }
+    }
+    for (int i=0; i<n_joints; i++)
+        slots.set(kind, jlut->get(i).asInt(), cmdVector[i]);
+    return true;
+}
+
+// Store the setpoints of the messages applied by run() in latest mode.
+// Returns false if the message has to be handled directly.
+bool StreamingMessagesParser::storeLatest(Bottle& b, Vector& cmdVector)
+{
+    int kind;
+    int vocab = b.get(0).asVocab();
+    int j = b.get(1).asInt();
+    bool single = false;
+    bool all = false;
+    bool group = false;
+
+    switch (vocab)
+    {
+        case VOCAB_OPENLOOP_INTERFACE:
+            if (!stream_IOpenLoop)
+                return false;
+            kind = StreamingCommandSlots::OPENLOOP;
+            switch (b.get(1).asVocab())
+            {
+                case VOCAB_OPENLOOP_REF_OUTPUT:
+                    j = b.get(2).asVocab();
+                    single = true;
+                    break;
+                case VOCAB_OPENLOOP_REF_OUTPUTS:
+                    all = true;
+                    break;
+                default:
+                    return false;
+            }
+            break;
+
+        case VOCAB_POSITION_DIRECT:
+        case VOCAB_POSITION_DIRECTS:
+        case VOCAB_POSITION_DIRECT_GROUP:
+            if (!stream_IPosDirect)
+                return false;
+            kind = StreamingCommandSlots::POSITION_DIRECT;
+            single = (vocab==VOCAB_POSITION_DIRECT);
+            all = (vocab==VOCAB_POSITION_DIRECTS);
+            group = (vocab==VOCAB_POSITION_DIRECT_GROUP);
+            break;
+
+        case VOCAB_VELOCITY_MOVE:
+        case VOCAB_VELOCITY_MOVES:
+        case VOCAB_VELOCITY_MOVE_GROUP:
+            if (!stream_IVel2)
+                return false;
+            kind = StreamingCommandSlots::VELOCITY;
+            single = (vocab==VOCAB_VELOCITY_MOVE);
+            all = (vocab==VOCAB_VELOCITY_MOVES);
+            group = (vocab==VOCAB_VELOCITY_MOVE_GROUP);
+            break;
+
+        case VOCAB_TORQUES_DIRECT:
+        case VOCAB_TORQUES_DIRECTS:
+        case VOCAB_TORQUES_DIRECT_GROUP:
+            if (!stream_ITorque)
+                return false;
+            kind = StreamingCommandSlots::TORQUE;
+            single = (vocab==VOCAB_TORQUES_DIRECT);
+            all = (vocab==VOCAB_TORQUES_DIRECTS);
+            group = (vocab==VOCAB_TORQUES_DIRECT_GROUP);
+            break;
+
+        default:
+            return false;
+    }
+
+    bool ok = true;
+    if (single)
+    {
+        if (j<0 || j>=stream_nJoints)
+        {
+            yError("Received streaming command for joint %d out of range\n", j);
+            ok = false;
+        }
+        else
+            slots.set(kind, j, cmdVector[0]);
+    }
+    else if (all)
+    {
+        if ((int)cmdVector.size()!=stream_nJoints)
+        {
+            yError("Received streaming command for %d joints instead of %d\n", (int)cmdVector.size(), stream_nJoints);
+            ok = false;
+        }
+        else
+        {
+            for (int i=0; i<stream_nJoints; i++)
+                slots.set(kind, i, cmdVector[i]);
+        }
+    }
+    else if (group)
+        ok = storeGroup(kind, b, cmdVector);
+
+    if (ok && awake.get()==0)
+    {
+        awake.set(1);
+        wake.post();
+    }
     return true;
 }
 
@@ -63,6 +316,9 @@ void StreamingMessagesParser::onRead(CommandMessage& v)
          return;
     }
 
+    if (latest && isRunning() && storeLatest(b, cmdVector))
+        return;
+
     switch (b.get(0).asVocab())
     {
         // manage commands with interface name as first
@@ -25,6 +25,8 @@
 #include <yarp/dev/PreciselyTimed.h>
 #include <yarp/sig/Vector.h>
 #include <yarp/os/Semaphore.h>
+#include <yarp/os/Thread.h>
+#include <yarp/os/impl/AtomicCounter.h>
 #include <yarp/dev/Wrapper.h>
 
 #include <string>
@@ -49,6 +51,7 @@ namespace yarp {
         class ControlBoardWrapper;
         namespace impl {
             class StreamingMessagesParser;
+            class StreamingCommandSlots;
             class SubDevice;
             class WrappedDevice;
         }
@@ -68,10 +71,54 @@ typedef yarp::os::PortablePair<yarp::os::Bottle, yarp::sig::Vector> CommandMessa
 
 
 
+/*
+* The latest setpoint streamed for each joint, one slot per kind of
+* setpoint, written by the streaming port thread and taken by the thread
+* applying them.  A value not yet taken is overwritten by a newer one.
+* Neither side locks: the sequence number of a slot is odd while it is
+* being written, and a slot found in that state is taken on the next pass.
+*/
+class yarp::dev::impl::StreamingCommandSlots {
+public:
+    enum {
+        POSITION_DIRECT,
+        VELOCITY,
+        TORQUE,
+        OPENLOOP,
+        KINDS
+    };
+
+    StreamingCommandSlots();
+    ~StreamingCommandSlots();
+
+    void resize(int joints);
+
+    int size() { return nJoints; }
+
+    /* writer side */
+    void set(int kind, int j, double value);
+
+    /*
+    * Reader side: collect the joints with a new value of the given kind
+    * and their values, both arrays must have room for size() elements.
+    * Returns the number of joints collected.
+    */
+    int take(int kind, int *joints, double *values);
+
+private:
+    int nJoints;
+    std::vector<double> slot[KINDS];
+    std::vector<int> taken[KINDS];
+    yarp::os::impl::AtomicCounter *seq[KINDS];
+};
+
+
+
 /**
 * Callback implementation after buffered input.
 */
-class  yarp::dev::impl::StreamingMessagesParser : public yarp::os::TypedReaderCallback<CommandMessage> {
+class  yarp::dev::impl::StreamingMessagesParser : public yarp::os::TypedReaderCallback<CommandMessage>,
+                                                   public yarp::os::Thread {
 protected:
     yarp::dev::IPositionControl     *stream_IPosCtrl;
     yarp::dev::IPositionControl2    *stream_IPosCtrl2;
@@ -82,6 +129,18 @@ protected:
     yarp::dev::ITorqueControl       *stream_ITorque;
     int                              stream_nJoints;
 
+    // latest-wins mode: the callback only fills the slots, run() applies them
+    bool                             latest;
+    StreamingCommandSlots            slots;
+    yarp::os::Semaphore              wake;
+    yarp::os::impl::AtomicCounter    awake;
+    std::vector<int>                 batchJoints;
+    std::vector<double>              batchValues;
+
+    bool storeLatest(yarp::os::Bottle& b, yarp::sig::Vector& cmdVector);
+    bool storeGroup(int kind, yarp::os::Bottle& b, yarp::sig::Vector& cmdVector);
+    void applyLatest();
+
 public:
     /**
     * Constructor.
@@ -102,6 +161,23 @@ public:
     virtual void onRead(CommandMessage& v);
 
     bool initialize();
+
+    /**
+    * Keep only the latest position direct, velocity, torque and open loop
+    * setpoints of each joint and apply them from a thread of this object,
+    * in one call per kind, instead of calling the device from the port
+    * thread for every message.  Takes effect at initialize().
+    */
+    void setLatestMode(bool latest) { this->latest = latest; }
+
+    /**
+    * Stop applying the latest setpoints, call after the port is closed.
+    */
+    void close();
+
+    virtual void run();
+
+    virtual void onStop();
 };
 
 
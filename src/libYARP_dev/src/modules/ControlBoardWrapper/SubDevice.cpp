@@ -52,6 +52,8 @@ SubDevice::SubDevice()
     configuredF=false;
     attachedF=false;
     _subDevVerbose = false;
+    for (int f=0; f<STATE_FIELDS; f++)
+        stateValid[f] = false;
 }
 
 bool SubDevice::configure(int b, int t, int n, const std::string &key)
@@ -81,11 +83,6 @@ bool SubDevice::configure(int b, int t, int n, const std::string &key)
             return false;
         }
 
-    subDev_joint_encoders.resize(axes);
-    jointEncodersTimes.resize(axes);
-    subDev_motor_encoders.resize(axes);
-    motorEncodersTimes.resize(axes);
-
     configuredF=true;
     return true;
 }
@@ -259,6 +256,38 @@ bool SubDevice::attach(yarp::dev::PolyDriver *d, const std::string &k)
         yError("ControlBoarWrapper: check device configuration, number of joints of attached device '%d' less than the one specified during configuration '%d' for %s.", deviceJoints, axes, k.c_str());
         return false;
     }
+
+    int size = deviceJoints;
+    int motors = 0;
+    if (iMotEnc && iMotEnc->getNumberOfMotorEncoders(&motors) && motors>size)
+        size = motors;
+    for (int f=0; f<STATE_DOUBLE_FIELDS; f++)
+        state[f].resize(size);
+    for (int f=STATE_DOUBLE_FIELDS; f<STATE_FIELDS; f++)
+        stateModes[f-STATE_DOUBLE_FIELDS].resize(size);
+    stateEncoderTimes.resize(size);
+
     attachedF=true;
     return true;
 }
+
+void SubDevice::refreshState()
+{
+    if (!attachedF)
+    {
+        for (int f=0; f<STATE_FIELDS; f++)
+            stateValid[f] = false;
+        return;
+    }
+
+    stateValid[STATE_ENCODERS] = iJntEnc && iJntEnc->getEncodersTimed(&state[STATE_ENCODERS][0], &stateEncoderTimes[0]);
+    stateValid[STATE_ENCODER_SPEEDS] = iJntEnc && iJntEnc->getEncoderSpeeds(&state[STATE_ENCODER_SPEEDS][0]);
+    stateValid[STATE_ENCODER_ACCELERATIONS] = iJntEnc && iJntEnc->getEncoderAccelerations(&state[STATE_ENCODER_ACCELERATIONS][0]);
+    stateValid[STATE_MOTOR_ENCODERS] = iMotEnc && iMotEnc->getMotorEncoders(&state[STATE_MOTOR_ENCODERS][0]);
+    stateValid[STATE_MOTOR_ENCODER_SPEEDS] = iMotEnc && iMotEnc->getMotorEncoderSpeeds(&state[STATE_MOTOR_ENCODER_SPEEDS][0]);
+    stateValid[STATE_MOTOR_ENCODER_ACCELERATIONS] = iMotEnc && iMotEnc->getMotorEncoderAccelerations(&state[STATE_MOTOR_ENCODER_ACCELERATIONS][0]);
+    stateValid[STATE_TORQUES] = iTorque && iTorque->getTorques(&state[STATE_TORQUES][0]);
+    stateValid[STATE_OUTPUTS] = pid && pid->getOutputs(&state[STATE_OUTPUTS][0]);
+    stateValid[STATE_CONTROL_MODES] = iMode && iMode->getControlModes(&stateModes[STATE_CONTROL_MODES-STATE_DOUBLE_FIELDS][0]);
+    stateValid[STATE_INTERACTION_MODES] = iInteract && iInteract->getInteractionModes((yarp::dev::InteractionModeEnum*)&stateModes[STATE_INTERACTION_MODES-STATE_DOUBLE_FIELDS][0]);
+}
@@ -102,10 +102,28 @@ public:
     yarp::dev::IMotor                *imotor;
     yarp::dev::IRemoteVariables      *iVar;
 
-    yarp::sig::Vector subDev_joint_encoders;
-    yarp::sig::Vector jointEncodersTimes;
-    yarp::sig::Vector subDev_motor_encoders;
-    yarp::sig::Vector motorEncodersTimes;
+    // whole state of the attached device, read by refreshState() with one
+    // call per field so that all the joints of a field come from the same
+    // reading; the wrapper joints are those from base to top
+    enum
+    {
+        STATE_ENCODERS,
+        STATE_ENCODER_SPEEDS,
+        STATE_ENCODER_ACCELERATIONS,
+        STATE_MOTOR_ENCODERS,
+        STATE_MOTOR_ENCODER_SPEEDS,
+        STATE_MOTOR_ENCODER_ACCELERATIONS,
+        STATE_TORQUES,
+        STATE_OUTPUTS,
+        STATE_CONTROL_MODES,
+        STATE_INTERACTION_MODES,
+        STATE_FIELDS,
+        STATE_DOUBLE_FIELDS = STATE_CONTROL_MODES
+    };
+    std::vector<double> state[STATE_DOUBLE_FIELDS];
+    std::vector<int> stateModes[STATE_FIELDS-STATE_DOUBLE_FIELDS];
+    std::vector<double> stateEncoderTimes;
+    bool stateValid[STATE_FIELDS];
 
     SubDevice();
 
@@ -115,25 +133,7 @@ public:
 
     bool configure(int base, int top, int axes, const std::string &id);
 
-    inline void refreshJointEncoders()
-    {
-        for(int j=base, idx=0; j<(base+axes); j++, idx++)
-        {
-            if(iJntEnc)
-                iJntEnc->getEncoderTimed(j, &subDev_joint_encoders[idx], &jointEncodersTimes[idx]);
-        }
-    }
-
-    inline void refreshMotorEncoders()
-    {
-        for(int j=base, idx=0; j<(base+axes); j++, idx++)
-        {
-            if(iMotEnc)
-                iMotEnc->getMotorEncoderTimed(j, &subDev_motor_encoders[idx], &motorEncodersTimes[idx]);
-        }
-    }
-
-
+    void refreshState();
 
     bool isAttached()
     { return attachedF; }
@@ -536,6 +536,8 @@ void Rangefinder2DWrapper::run()
                 rosData.scan_time = 0;
                 rosData.range_max = 0;
                 rosData.range_min = 0;
+                rosData.ranges.resize(ranges_size);
+                rosData.intensities.resize(ranges_size);
                 for (int i = 0; i < ranges_size; i++)
                 {
                     rosData.ranges[i] = ranges[i];
@@ -248,6 +248,14 @@ public:
 * @ingroup dev_impl_wrapper
 *
 * The client side of the control board, connects to a ServerControlBoard.
+*
+* Besides 'remote', 'local' and 'carrier' it accepts 'timeout', the age in
+* seconds after which the streamed state is considered stale and the
+* getters fail (0.5 by default for the encoders only), and
+* 'extrapolation', the maximum time in seconds over which joint and motor
+* positions are extrapolated with the streamed velocities to the time of
+* the call (0, no extrapolation, by default).  Extrapolation lets clients
+* poll faster than the wrapper publishes.
 */
 class yarp::dev::RemoteControlBoard :
     public IPidControl,
@@ -291,14 +299,14 @@ protected:
 //  yarp::os::PortReaderBuffer<jointData>           extendedInputState_buffer;  // Buffer storing new data
     StateExtendedInputPort                          extendedIntputStatePort;  // Buffered port storing new data
     Semaphore extendedPortMutex;
-    jointData last_singleJoint;     // tmp to store last received data for a particular joint
 //    yarp::os::Port extendedIntputStatePort;         // Port /stateExt:i reading the state of the joints
-    jointData last_wholePart;         // tmp to store last received data for whole part
+    jointData last_wholePart;         // tmp to store modes of the whole part when only some joints are asked
 
     bool controlBoardWrapper1_compatibility;
     ConstString remote;
     ConstString local;
     mutable Stamp lastStamp;  //this is shared among all calls that read encoders
+    double stateTimeout;
     // Semaphore mutex;
     int nj;
     bool njIsKnown;
@@ -317,6 +325,11 @@ protected:
         return njIsKnown;
     }
 
+    // true if the state received at localArrivalTime is too old
+    bool isStale(double localArrivalTime) {
+        return stateTimeout>0 && Time::now()-localArrivalTime>stateTimeout;
+    }
+
     bool send1V(int v)
     {
         Bottle cmd, response;
@@ -1014,6 +1027,7 @@ public:
         writeStrict_singleJoint = true;
         writeStrict_moreJoints  = false;
         controlBoardWrapper1_compatibility = false;
+        stateTimeout = TIMEOUT;
     }
 
     /**
@@ -1093,6 +1107,15 @@ public:
             Value("udp"),
             "default carrier for streaming robot state").asString().c_str();
 
+        if (config.check("timeout"))
+        {
+            stateTimeout = config.find("timeout").asDouble();
+            extendedIntputStatePort.setTimeout(stateTimeout);
+        }
+        extendedIntputStatePort.setExtrapolation(config.check("extrapolation",
+            Value(0.0),
+            "maximum time (s) positions are extrapolated over").asDouble());
+
         bool portProblem = false;
         if (local != "") {
             ConstString s1 = local;
@@ -1219,6 +1242,9 @@ public:
             }
         }
 
+        // the state cache has a fixed size, data received until now is dropped
+        extendedIntputStatePort.init(nj);
+
         if (config.check("diagnostic"))
         {
             diagnosticThread = new DiagnosticThread(DIAGNOSTIC_THREAD_RATE);
@@ -1229,27 +1255,7 @@ public:
             diagnosticThread=0;
 
         // allocate memory for helper struct
-        // single joint
-        last_singleJoint.jointPosition.resize(1);
-        last_singleJoint.jointVelocity.resize(1);
-        last_singleJoint.jointAcceleration.resize(1);
-        last_singleJoint.motorPosition.resize(1);
-        last_singleJoint.motorVelocity.resize(1);
-        last_singleJoint.motorAcceleration.resize(1);
-        last_singleJoint.torque.resize(1);
-        last_singleJoint.pidOutput.resize(1);
-        last_singleJoint.controlMode.resize(1);
-        last_singleJoint.interactionMode.resize(1);
-
         // whole part  (safe here because we already got the nj
-        last_wholePart.jointPosition.resize(nj);
-        last_wholePart.jointVelocity.resize(nj);
-        last_wholePart.jointAcceleration.resize(nj);
-        last_wholePart.motorPosition.resize(nj);
-        last_wholePart.motorVelocity.resize(nj);
-        last_wholePart.motorAcceleration.resize(nj);
-        last_wholePart.torque.resize(nj);
-        last_wholePart.pidOutput.resize(nj);
         last_wholePart.controlMode.resize(nj);
         last_wholePart.interactionMode.resize(nj);
         return true;
@@ -1610,15 +1616,10 @@ public:
         else
         {
             extendedPortMutex.wait();
-            ret = extendedIntputStatePort.getLast(j, last_singleJoint, lastStamp, localArrivalTime);
+            ret = extendedIntputStatePort.getLastSingle(j, VOCAB_ENCODER, v, lastStamp, localArrivalTime);
             extendedPortMutex.post();
-
-            if(ret && last_singleJoint.jointPosition_isValid)
-                *v = last_singleJoint.jointPosition[0];
-            else
-                ret = false;
         }
-        if (ret && Time::now()-localArrivalTime>TIMEOUT)
+        if (ret && isStale(localArrivalTime))
             ret=false;
 
         return ret;
@@ -1641,17 +1642,12 @@ public:
         else
         {
             extendedPortMutex.wait();
-            ret = extendedIntputStatePort.getLast(j, last_singleJoint, lastStamp, localArrivalTime);
+            ret = extendedIntputStatePort.getLastSingle(j, VOCAB_ENCODER, v, lastStamp, localArrivalTime);
             extendedPortMutex.post();
-
-            if(ret && last_singleJoint.jointPosition_isValid)
-                *v = last_singleJoint.jointPosition[0];
-            else
-                ret = false;
         }
         *t=lastStamp.getTime();
 
-        if (ret && Time::now()-localArrivalTime>TIMEOUT)
+        if (ret && isStale(localArrivalTime))
             ret=false;
 
         return ret;
@@ -1690,20 +1686,15 @@ public:
 
                 ////////////////////////// HANDLE TIMEOUT
                 // fill the vector anyway
-                if (Time::now()-localArrivalTime>TIMEOUT)
+                if (isStale(localArrivalTime))
                     ret=false;
             }
         }
         else
         {
             extendedPortMutex.wait();
-            ret = extendedIntputStatePort.getLast(last_wholePart, lastStamp, localArrivalTime);
+            ret = extendedIntputStatePort.getLastVector(VOCAB_ENCODER, encs, lastStamp, localArrivalTime);
             extendedPortMutex.post();
-
-            if(ret && last_wholePart.jointPosition_isValid)
-                std::copy(last_wholePart.jointPosition.begin(), last_wholePart.jointPosition.end(), encs);
-            else
-                ret = false;
         }
         return ret;
     }
@@ -1743,20 +1734,14 @@ public:
         else
         {
             extendedPortMutex.wait();
-            ret = extendedIntputStatePort.getLast(last_wholePart, lastStamp, localArrivalTime);
-            extendedPortMutex.post();
-
-            if(ret && last_wholePart.jointPosition_isValid)
-            {
-                std::copy(last_wholePart.jointPosition.begin(), last_wholePart.jointPosition.end(), encs);
+            ret = extendedIntputStatePort.getLastVector(VOCAB_ENCODER, encs, lastStamp, localArrivalTime);
+            if (ret)
                 std::fill_n(ts, nj, lastStamp.getTime());
-            }
-            else
-                ret = false;
+            extendedPortMutex.post();
         }
 
         ////////////////////////// HANDLE TIMEOUT
-        if (Time::now()-localArrivalTime>TIMEOUT)
+        if (isStale(localArrivalTime))
             ret=false;
 
         return ret;
@@ -1777,16 +1762,9 @@ public:
         {
             double localArrivalTime=0.0;
             extendedPortMutex.wait();
-            bool ret = extendedIntputStatePort.getLast(j, last_singleJoint, lastStamp, localArrivalTime);
+            bool ret = extendedIntputStatePort.getLastSingle(j, VOCAB_ENCODER_SPEED, sp, lastStamp, localArrivalTime);
             extendedPortMutex.post();
 
-            if(ret && last_singleJoint.jointVelocity_isValid)
-            {
-                *sp = last_singleJoint.jointVelocity[0];
-            }
-            else
-                ret = false;
-
             return ret;
         }
     }
@@ -1807,16 +1785,9 @@ public:
         {
             double localArrivalTime=0.0;
             extendedPortMutex.wait();
-            bool ret = extendedIntputStatePort.getLast(last_wholePart, lastStamp, localArrivalTime);
+            bool ret = extendedIntputStatePort.getLastVector(VOCAB_ENCODER_SPEED, spds, lastStamp, localArrivalTime);
             extendedPortMutex.post();
 
-            if(ret && last_wholePart.jointVelocity_isValid)
-            {
-                std::copy(last_wholePart.jointVelocity.begin(), last_wholePart.jointVelocity.end(), spds);
-            }
-            else
-                ret = false;
-
             return ret;
         }
     }
@@ -1837,15 +1808,8 @@ public:
         {
             double localArrivalTime=0.0;
             extendedPortMutex.wait();
-            bool ret = extendedIntputStatePort.getLast(j, last_singleJoint, lastStamp, localArrivalTime);
+            bool ret = extendedIntputStatePort.getLastSingle(j, VOCAB_ENCODER_ACCELERATION, acc, lastStamp, localArrivalTime);
             extendedPortMutex.post();
-
-            if(ret && last_singleJoint.jointAcceleration_isValid)
-            {
-                *acc = last_singleJoint.jointAcceleration[0];
-            }
-            else
-                ret = false;
             return ret;
         }
     }
@@ -1865,16 +1829,9 @@ public:
         {
             double localArrivalTime=0.0;
             extendedPortMutex.wait();
-            bool ret = extendedIntputStatePort.getLast(last_wholePart, lastStamp, localArrivalTime);
+            bool ret = extendedIntputStatePort.getLastVector(VOCAB_ENCODER_ACCELERATION, accs, lastStamp, localArrivalTime);
             extendedPortMutex.post();
 
-            if(ret && last_wholePart.jointAcceleration_isValid)
-            {
-                std::copy(last_wholePart.jointAcceleration.begin(), last_wholePart.jointAcceleration.end(), accs);
-            }
-            else
-                ret = false;
-
             return ret;
         }
     }
@@ -2027,17 +1984,10 @@ public:
         else
         {
             extendedPortMutex.wait();
-            ret = extendedIntputStatePort.getLast(j, last_singleJoint, lastStamp, localArrivalTime);
+            ret = extendedIntputStatePort.getLastSingle(j, VOCAB_MOTOR_ENCODER, v, lastStamp, localArrivalTime);
             extendedPortMutex.post();
-
-            if(ret && last_singleJoint.motorPosition_isValid)
-            {
-                *v = last_singleJoint.motorPosition[0];
-            }
-            else
-                ret = false;
         }
-        if (ret && Time::now()-localArrivalTime>TIMEOUT)
+        if (ret && isStale(localArrivalTime))
             ret=false;
 
         return ret;
@@ -2059,20 +2009,13 @@ public:
         else
         {
             extendedPortMutex.wait();
-            ret = extendedIntputStatePort.getLast(j, last_singleJoint, lastStamp, localArrivalTime);
+            ret = extendedIntputStatePort.getLastSingle(j, VOCAB_MOTOR_ENCODER, v, lastStamp, localArrivalTime);
             extendedPortMutex.post();
-
-            if(ret && last_singleJoint.motorPosition_isValid)
-            {
-                *v = last_singleJoint.motorPosition[0];
-            }
-            else
-                ret = false;
         }
 
         *t=lastStamp.getTime();
 
-        if (ret && Time::now()-localArrivalTime>TIMEOUT)
+        if (ret && isStale(localArrivalTime))
             ret=false;
 
         return ret;
@@ -2112,22 +2055,15 @@ public:
 
                 ////////////////////////// HANDLE TIMEOUT
                 // fill the vector anyway
-                if (Time::now()-localArrivalTime>TIMEOUT)
+                if (isStale(localArrivalTime))
                     ret=false;
             }
         }
         else
         {
             extendedPortMutex.wait();
-            ret = extendedIntputStatePort.getLast(last_wholePart, lastStamp, localArrivalTime);
+            ret = extendedIntputStatePort.getLastVector(VOCAB_MOTOR_ENCODER, encs, lastStamp, localArrivalTime);
             extendedPortMutex.post();
-
-            if(ret && last_wholePart.motorPosition_isValid)
-            {
-                std::copy(last_wholePart.motorPosition.begin(), last_wholePart.motorPosition.end(), encs);
-            }
-            else
-                ret = false;
         }
         return ret;
     }
@@ -2168,20 +2104,14 @@ public:
         else
         {
             extendedPortMutex.wait();
-            ret = extendedIntputStatePort.getLast(last_wholePart, lastStamp, localArrivalTime);
-            extendedPortMutex.post();
-
-            if(ret && last_wholePart.motorPosition_isValid)
-            {
-                std::copy(last_wholePart.motorPosition.begin(), last_wholePart.motorPosition.end(), encs);
+            ret = extendedIntputStatePort.getLastVector(VOCAB_MOTOR_ENCODER, encs, lastStamp, localArrivalTime);
+            if (ret)
                 std::fill_n(ts, nj, lastStamp.getTime());
-            }
-            else
-                ret = false;
+            extendedPortMutex.post();
         }
 
         ////////////////////////// HANDLE TIMEOUT
-        if (Time::now()-localArrivalTime>TIMEOUT)
+        if (isStale(localArrivalTime))
             ret=false;
 
         return ret;
@@ -2200,15 +2130,8 @@ public:
         {
             double localArrivalTime=0.0;
             extendedPortMutex.wait();
-            bool ret = extendedIntputStatePort.getLast(j, last_singleJoint, lastStamp, localArrivalTime);
+            bool ret = extendedIntputStatePort.getLastSingle(j, VOCAB_MOTOR_ENCODER_SPEED, sp, lastStamp, localArrivalTime);
             extendedPortMutex.post();
-
-            if(ret && last_singleJoint.motorVelocity_isValid)
-            {
-                *sp = last_singleJoint.motorVelocity[0];
-            }
-            else
-                ret = false;
             return ret;
         }
     }
@@ -2225,15 +2148,8 @@ public:
         {
             double localArrivalTime=0.0;
             extendedPortMutex.wait();
-            bool ret = extendedIntputStatePort.getLast(last_wholePart, lastStamp, localArrivalTime);
+            bool ret = extendedIntputStatePort.getLastVector(VOCAB_MOTOR_ENCODER_SPEED, spds, lastStamp, localArrivalTime);
             extendedPortMutex.post();
-
-            if(ret && last_wholePart.motorVelocity_isValid)
-            {
-                std::copy(last_wholePart.motorVelocity.begin(), last_wholePart.motorVelocity.end(), spds);
-            }
-            else
-                ret = false;
             return ret;
         }
         else
@@ -2254,15 +2170,8 @@ public:
         {
             double localArrivalTime=0.0;
             extendedPortMutex.wait();
-            bool ret = extendedIntputStatePort.getLast(j, last_singleJoint, lastStamp, localArrivalTime);
+            bool ret = extendedIntputStatePort.getLastSingle(j, VOCAB_MOTOR_ENCODER_ACCELERATION, acc, lastStamp, localArrivalTime);
             extendedPortMutex.post();
-
-            if(ret && last_singleJoint.motorAcceleration_isValid)
-            {
-                *acc = last_singleJoint.motorAcceleration[0];
-            }
-            else
-                ret = false;
             return ret;
         }
         else
@@ -2282,15 +2191,8 @@ public:
         {
             double localArrivalTime=0.0;
             extendedPortMutex.wait();
-            bool ret = extendedIntputStatePort.getLast(last_wholePart, lastStamp, localArrivalTime);
+            bool ret = extendedIntputStatePort.getLastVector(VOCAB_MOTOR_ENCODER_ACCELERATION, accs, lastStamp, localArrivalTime);
             extendedPortMutex.post();
-
-            if(ret && last_wholePart.motorAcceleration_isValid)
-            {
-                std::copy(last_wholePart.motorAcceleration.begin(), last_wholePart.motorAcceleration.end(), accs);
-            }
-            else
-                ret = false;
             return ret;
         }
         else
@@ -3097,16 +2999,9 @@ public:
         {
             double localArrivalTime=0.0;
             extendedPortMutex.wait();
-            bool ret = extendedIntputStatePort.getLast(j, last_singleJoint, lastStamp, localArrivalTime);
+            bool ret = extendedIntputStatePort.getLastSingle(j, VOCAB_TRQ, t, lastStamp, localArrivalTime);
             extendedPortMutex.post();
 
-            if(ret && last_singleJoint.torque_isValid)
-            {
-                *t = last_singleJoint.torque[0];
-            }
-            else
-                ret = false;
-
             return ret;
         }
     }
@@ -3121,15 +3016,8 @@ public:
         {
             double localArrivalTime=0.0;
             extendedPortMutex.wait();
-            bool ret = extendedIntputStatePort.getLast(last_wholePart, lastStamp, localArrivalTime);
+            bool ret = extendedIntputStatePort.getLastVector(VOCAB_TRQ, t, lastStamp, localArrivalTime);
             extendedPortMutex.post();
-
-            if(ret && last_wholePart.torque_isValid)
-            {
-                std::copy(last_wholePart.torque.begin(), last_wholePart.torque.end(), t);
-            }
-            else
-                ret = false;
             return ret;
         }
     }
@@ -3388,15 +3276,8 @@ public:
         {
             double localArrivalTime=0.0;
             extendedPortMutex.wait();
-            ok = extendedIntputStatePort.getLast(j, last_singleJoint, lastStamp, localArrivalTime);
+            ok = extendedIntputStatePort.getLastSingle(j, VOCAB_CM_CONTROL_MODE, mode, lastStamp, localArrivalTime);
             extendedPortMutex.post();
-
-            if(ok && last_singleJoint.controlMode_isValid)
-            {
-                *mode = last_singleJoint.controlMode[0];
-            }
-            else
-                ok = false;
         }
         return ok;
 
@@ -3440,16 +3321,13 @@ public:
         {
             double localArrivalTime=0.0;
             extendedPortMutex.wait();
-            ok = extendedIntputStatePort.getLast(last_wholePart, lastStamp, localArrivalTime);
-            extendedPortMutex.post();
-
-            if(ok && last_wholePart.controlMode_isValid)
+            ok = extendedIntputStatePort.getLastVector(VOCAB_CM_CONTROL_MODE, last_wholePart.controlMode.data(), lastStamp, localArrivalTime);
+            if (ok)
             {
                 for (int i = 0; i < n_joint; i++)
                     modes[i] = last_wholePart.controlMode[joints[i]];
             }
-            else
-                ok = false;
+            extendedPortMutex.post();
         }
         return ok;
     }
@@ -3483,15 +3361,8 @@ public:
         {
             double localArrivalTime=0.0;
             extendedPortMutex.wait();
-            ok = extendedIntputStatePort.getLast(last_wholePart, lastStamp, localArrivalTime);
+            ok = extendedIntputStatePort.getLastVector(VOCAB_CM_CONTROL_MODE, modes, lastStamp, localArrivalTime);
             extendedPortMutex.post();
-
-            if(ok && last_wholePart.controlMode_isValid)
-            {
-                std::copy(last_wholePart.controlMode.begin(), last_wholePart.controlMode.end(), modes);
-            }
-            else
-                ok = false;
         }
         return ok;
     }
@@ -3789,15 +3660,8 @@ public:
         {
             double localArrivalTime=0.0;
             extendedPortMutex.wait();
-            ok = extendedIntputStatePort.getLast(axis, last_singleJoint, lastStamp, localArrivalTime);
+            ok = extendedIntputStatePort.getLastSingle(axis, VOCAB_INTERACTION_MODE, (int*)mode, lastStamp, localArrivalTime);
             extendedPortMutex.post();
-
-            if(ok && last_singleJoint.interactionMode_isValid)
-            {
-                *mode = (yarp::dev::InteractionModeEnum)last_singleJoint.interactionMode[0];
-            }
-            else
-                ok = false;
         }
         return ok;
     }
@@ -3847,16 +3711,13 @@ public:
         {
             double localArrivalTime=0.0;
             extendedPortMutex.wait();
-            ok = extendedIntputStatePort.getLast(last_wholePart, lastStamp, localArrivalTime);
-            extendedPortMutex.post();
-
-            if(ok && last_wholePart.interactionMode_isValid)
+            ok = extendedIntputStatePort.getLastVector(VOCAB_INTERACTION_MODE, last_wholePart.interactionMode.data(), lastStamp, localArrivalTime);
+            if (ok)
             {
                 for (int i = 0; i < n_joints; i++)
                     modes[i] = (yarp::dev::InteractionModeEnum)last_wholePart.interactionMode[joints[i]];
             }
-            else
-                ok = false;
+            extendedPortMutex.post();
         }
         return ok;
     }
@@ -3868,15 +3729,8 @@ public:
         {
             double localArrivalTime=0.0;
             extendedPortMutex.wait();
-            ret = extendedIntputStatePort.getLast(last_wholePart, lastStamp, localArrivalTime);
+            ret = extendedIntputStatePort.getLastVector(VOCAB_INTERACTION_MODE, (int*)modes, lastStamp, localArrivalTime);
             extendedPortMutex.post();
-
-            if(ret && last_wholePart.interactionMode_isValid)
-            {
-                std::copy(last_wholePart.interactionMode.begin(), last_wholePart.interactionMode.end(), (int*)modes);
-            }
-            else
-                ret = false;
         }
         else
         {
@@ -4060,15 +3914,8 @@ public:
         {
             double localArrivalTime=0.0;
             extendedPortMutex.wait();
-            bool ret = extendedIntputStatePort.getLast(j, last_singleJoint, lastStamp, localArrivalTime);
+            bool ret = extendedIntputStatePort.getLastSingle(j, VOCAB_OUTPUT, out, lastStamp, localArrivalTime);
             extendedPortMutex.post();
-
-            if(ret && last_singleJoint.pidOutput_isValid)
-            {
-                *out = last_singleJoint.pidOutput[0];
-            }
-            else
-                ret = false;
             return ret;
         }
         else
@@ -4105,15 +3952,8 @@ public:
         {
             double localArrivalTime=0.0;
             extendedPortMutex.wait();
-            bool ret = extendedIntputStatePort.getLast(last_wholePart, lastStamp, localArrivalTime);
+            bool ret = extendedIntputStatePort.getLastVector(VOCAB_OUTPUT, outs, lastStamp, localArrivalTime);
             extendedPortMutex.post();
-
-            if(ret && last_wholePart.pidOutput_isValid)
-            {
-                std::copy(last_wholePart.pidOutput.begin(), last_wholePart.pidOutput.end(), outs);
-            }
-            else
-                ret = false;
             return ret;
         }
         else
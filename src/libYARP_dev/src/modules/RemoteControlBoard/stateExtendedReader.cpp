@@ -1,4 +1,5 @@
 #include <string.h>
+#include <algorithm>
 
 #include <yarp/os/PortablePair.h>
 #include <yarp/os/BufferedPort.h>
@@ -24,6 +25,42 @@ using namespace yarp::os;
 using namespace yarp::dev;
 using namespace yarp::sig;
 
+// position of a field in StateExtendedBuffer, -1 if unknown
+static int fieldIndex(int field)
+{
+    switch (field)
+    {
+    case VOCAB_ENCODER:                     return 0;
+    case VOCAB_ENCODER_SPEED:               return 1;
+    case VOCAB_ENCODER_ACCELERATION:        return 2;
+    case VOCAB_MOTOR_ENCODER:               return 3;
+    case VOCAB_MOTOR_ENCODER_SPEED:         return 4;
+    case VOCAB_MOTOR_ENCODER_ACCELERATION:  return 5;
+    case VOCAB_TRQ:                         return 6;
+    case VOCAB_OUTPUT:                      return 7;
+    case VOCAB_CM_CONTROL_MODE:             return 8;
+    case VOCAB_INTERACTION_MODE:            return 9;
+    default:                                return -1;
+    }
+}
+
+template <class T>
+static void copyField(std::vector<T> &dest, const std::vector<T> &src)
+{
+    // the buffers are never resized here, readers may be looking at them
+    size_t n = std::min(dest.size(), src.size());
+    if (n>0)
+        memcpy(&dest[0], &src[0], n*sizeof(T));
+}
+
+StateExtendedBuffer::StateExtendedBuffer()
+{
+    valid=false;
+    for (int i=0; i<STATE_EXTENDED_FIELDS; i++)
+        isValid[i]=false;
+    arrivalTime=0;
+}
+
 void StateExtendedInputPort::resetStat()
 {
     mutex.wait();
@@ -38,22 +75,33 @@ void StateExtendedInputPort::resetStat()
 
 StateExtendedInputPort::StateExtendedInputPort()
 {
-    valid=false;
+    timeout=0;
+    horizon=0;
     resetStat();
 }
 
+void StateExtendedInputPort::setTimeout(double timeout)
+{
+    this->timeout=timeout;
+}
+
+void StateExtendedInputPort::setExtrapolation(double horizon)
+{
+    this->horizon=horizon;
+}
+
 void StateExtendedInputPort::init(int numberOfJoints)
 {
-    last.jointPosition.resize(numberOfJoints);
-    last.jointVelocity.resize(numberOfJoints);
-    last.jointAcceleration.resize(numberOfJoints);
-    last.motorPosition.resize(numberOfJoints);
-    last.motorVelocity.resize(numberOfJoints);
-    last.motorAcceleration.resize(numberOfJoints);
-    last.torque.resize(numberOfJoints);
-    last.pidOutput.resize(numberOfJoints);
-    last.controlMode.resize(numberOfJoints);
-    last.interactionMode.resize(numberOfJoints);
+    // called before any data is accepted, see onRead
+    mutex.wait();
+    for (int b=0; b<2; b++)
+    {
+        for (int i=0; i<STATE_EXTENDED_DOUBLE_FIELDS; i++)
+            buffers[b].doubles[i].assign(numberOfJoints, 0.0);
+        for (int i=0; i<STATE_EXTENDED_FIELDS-STATE_EXTENDED_DOUBLE_FIELDS; i++)
+            buffers[b].ints[i].assign(numberOfJoints, 0);
+    }
+    mutex.post();
 }
 
 void StateExtendedInputPort::onRead(jointData &v)
@@ -74,62 +122,138 @@ void StateExtendedInputPort::onRead(jointData &v)
     prev=now;
     count++;
 
-    valid=true;
-    last=v;
-    getEnvelope(lastStamp);
+    // fill the buffer that is not published, then publish it
+    int next = 1-published.get();
+    StateExtendedBuffer &b = buffers[next];
+    if (b.doubles[0].size()==0)
+    {
+        // not initialized yet
+        mutex.post();
+        return;
+    }
+    b.seq.inc();
+    copyField(b.doubles[0], v.jointPosition);
+    copyField(b.doubles[1], v.jointVelocity);
+    copyField(b.doubles[2], v.jointAcceleration);
+    copyField(b.doubles[3], v.motorPosition);
+    copyField(b.doubles[4], v.motorVelocity);
+    copyField(b.doubles[5], v.motorAcceleration);
+    copyField(b.doubles[6], v.torque);
+    copyField(b.doubles[7], v.pidOutput);
+    copyField(b.ints[0], v.controlMode);
+    copyField(b.ints[1], v.interactionMode);
+    b.isValid[0] = v.jointPosition_isValid;
+    b.isValid[1] = v.jointVelocity_isValid;
+    b.isValid[2] = v.jointAcceleration_isValid;
+    b.isValid[3] = v.motorPosition_isValid;
+    b.isValid[4] = v.motorVelocity_isValid;
+    b.isValid[5] = v.motorAcceleration_isValid;
+    b.isValid[6] = v.torque_isValid;
+    b.isValid[7] = v.pidOutput_isValid;
+    b.isValid[8] = v.controlMode_isValid;
+    b.isValid[9] = v.interactionMode_isValid;
+    b.valid=true;
+    getEnvelope(b.stamp);
     //check that timestamp are available
-    if (!lastStamp.isValid())
-        lastStamp.update(now);
+    if (!b.stamp.isValid())
+        b.stamp.update(now);
+    b.arrivalTime=now;
+    b.seq.inc();
+    published.set(next);
+
     mutex.post();
 }
 
-bool StateExtendedInputPort::getLast(int j, jointData &data, Stamp &stamp, double &localArrivalTime)
+// velocity field used to extrapolate field f, -1 if none
+static int rateIndex(int f)
 {
-    mutex.wait();
-    bool ret=valid;
-    if (ret)
-    {
-        data.jointPosition[0]           = last.jointPosition[j];
-        data.jointPosition_isValid      = last.jointPosition_isValid;
-        data.jointVelocity[0]           = last.jointVelocity[j];
-        data.jointVelocity_isValid      = last.jointVelocity_isValid;
-        data.jointAcceleration[0]       = last.jointAcceleration[j];
-        data.jointAcceleration_isValid  = last.jointAcceleration_isValid;
-        data.motorPosition[0]           = last.motorPosition[j];
-        data.motorPosition_isValid      = last.motorPosition_isValid;
-        data.motorVelocity[0]           = last.motorVelocity[j];
-        data.motorVelocity_isValid      = last.motorVelocity_isValid;
-        data.motorAcceleration[0]       = last.motorAcceleration[j];
-        data.motorAcceleration_isValid  = last.motorAcceleration_isValid;
-        data.torque[0]                  = last.torque[j];
-        data.torque_isValid             = last.torque_isValid;
-        data.pidOutput[0]               = last.pidOutput[j];
-        data.pidOutput_isValid          = last.pidOutput_isValid;
-        data.controlMode[0]             = last.controlMode[j];
-        data.controlMode_isValid        = last.controlMode_isValid;
-        data.interactionMode[0]         = last.interactionMode[j];
-        data.interactionMode_isValid    = last.interactionMode_isValid;
-
-        stamp=lastStamp;
-        localArrivalTime=now;
-    }
-    mutex.post();
-    return ret;
+    if (f==0 || f==3)
+        return f+1;
+    return -1;
 }
 
-bool StateExtendedInputPort::getLast(jointData &lastData, Stamp &stmp, double &localArrivalTime)
+static void extrapolate(double *data, const std::vector<double> &rate, int j, int count, double dt)
 {
-    mutex.wait();
-    bool ret = valid;
-    if (ret)
+    for (int k=0; k<count; k++)
+        data[k]+=rate[j+k]*dt;
+}
+
+static void extrapolate(int *, const std::vector<double> &, int, int, double)
+{
+}
+
+/*
+ * Copy count elements starting from joint j of field f out of the
+ * published buffer, retrying if onRead() overwrote it meanwhile.
+ */
+template <class T>
+static bool readField(StateExtendedBuffer *buffers,
+                      yarp::os::impl::AtomicCounter &published,
+                      double timeout, double horizon,
+                      int f, int j, int count, T *data,
+                      Stamp &stamp, double &localArrivalTime)
+{
+    double now = (timeout>0 || horizon>0) ? Time::now() : 0;
+    int r = (horizon>0) ? rateIndex(f) : -1;
+    for (;;)
     {
-        lastData = last;
-        stmp = lastStamp;
-        localArrivalTime=now;
+        StateExtendedBuffer &b = buffers[published.get()];
+        int seq = b.seq.get();
+        if (seq&1)
+            continue;
+        std::vector<T> &v = b.values(f, data);
+        bool ret = b.valid && b.isValid[f] && j>=0 && count>0 && j+count<=(int)v.size();
+        if (ret && timeout>0 && now-b.arrivalTime>timeout)
+            ret = false;
+        if (ret)
+        {
+            memcpy(data, &v[j], count*sizeof(T));
+            stamp=b.stamp;
+            localArrivalTime=b.arrivalTime;
+            if (r>=0 && b.isValid[r])
+            {
+                double dt = std::min(std::max(now-b.arrivalTime, 0.0), horizon);
+                extrapolate(data, b.doubles[r], j, count, dt);
+                stamp=Stamp(b.stamp.getCount(), b.stamp.getTime()+dt);
+            }
+        }
+        if (b.seq.get()==seq)
+            return ret;
     }
-    mutex.post();
+}
 
-    return ret;
+bool StateExtendedInputPort::getLastSingle(int j, int field, double *data, Stamp &stamp, double &localArrivalTime)
+{
+    int f=fieldIndex(field);
+    if (f<0 || f>=STATE_EXTENDED_DOUBLE_FIELDS)
+        return false;
+    return readField(buffers, published, timeout, horizon, f, j, 1, data, stamp, localArrivalTime);
+}
+
+bool StateExtendedInputPort::getLastSingle(int j, int field, int *data, Stamp &stamp, double &localArrivalTime)
+{
+    int f=fieldIndex(field);
+    if (f<STATE_EXTENDED_DOUBLE_FIELDS)
+        return false;
+    return readField(buffers, published, timeout, horizon, f, j, 1, data, stamp, localArrivalTime);
+}
+
+bool StateExtendedInputPort::getLastVector(int field, double *data, Stamp &stamp, double &localArrivalTime)
+{
+    int f=fieldIndex(field);
+    if (f<0 || f>=STATE_EXTENDED_DOUBLE_FIELDS)
+        return false;
+    int n=(int)buffers[0].doubles[0].size();
+    return readField(buffers, published, timeout, horizon, f, 0, n, data, stamp, localArrivalTime);
+}
+
+bool StateExtendedInputPort::getLastVector(int field, int *data, Stamp &stamp, double &localArrivalTime)
+{
+    int f=fieldIndex(field);
+    if (f<STATE_EXTENDED_DOUBLE_FIELDS)
+        return false;
+    int n=(int)buffers[0].doubles[0].size();
+    return readField(buffers, published, timeout, horizon, f, 0, n, data, stamp, localArrivalTime);
 }
 
 int StateExtendedInputPort::getIterations()
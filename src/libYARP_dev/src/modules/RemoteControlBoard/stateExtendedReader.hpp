@@ -11,6 +11,7 @@
 
 
 #include <string.h>
+#include <vector>
 
 #include <yarp/os/PortablePair.h>
 #include <yarp/os/BufferedPort.h>
@@ -21,6 +22,7 @@
 #include <yarp/os/Stamp.h>
 #include <yarp/os/Semaphore.h>
 #include <yarp/os/Log.h>
+#include <yarp/os/impl/AtomicCounter.h>
 
 #include <yarp/sig/Vector.h>
 
@@ -41,18 +43,64 @@ using namespace yarp::os;
 using namespace yarp::dev;
 using namespace yarp::sig;
 
+// number of fields of jointData kept by StateExtendedInputPort, the
+// first ones hold doubles, the others ints
+#define STATE_EXTENDED_DOUBLE_FIELDS 8
+#define STATE_EXTENDED_FIELDS 10
+
+/*
+ * One copy of the last received state.  seq is odd while the copy is
+ * being written.
+ */
+class StateExtendedBuffer
+{
+public:
+    yarp::os::impl::AtomicCounter seq;
+    bool valid;
+    std::vector<double> doubles[STATE_EXTENDED_DOUBLE_FIELDS];
+    std::vector<int> ints[STATE_EXTENDED_FIELDS-STATE_EXTENDED_DOUBLE_FIELDS];
+    bool isValid[STATE_EXTENDED_FIELDS];
+    Stamp stamp;
+    double arrivalTime;
+
+    StateExtendedBuffer();
+
+    std::vector<double> &values(int f, double *) { return doubles[f]; }
+    std::vector<int> &values(int f, int *) { return ints[f-STATE_EXTENDED_DOUBLE_FIELDS]; }
+};
+
+/*
+ * Receives the state of the joints streamed by a controlBoardWrapper.
+ *
+ * The last state is kept in two preallocated buffers: onRead() fills the
+ * one not being published and then publishes it, getLastSingle() and
+ * getLastVector() copy just the requested field out of the published one
+ * and retry in the rare case it was overwritten meanwhile.  Neither side
+ * takes a lock, so polling the getters does not hold back the network
+ * thread.  Fields are identified by the vocab of the matching getter:
+ * VOCAB_ENCODER, VOCAB_ENCODER_SPEED, VOCAB_ENCODER_ACCELERATION,
+ * VOCAB_MOTOR_ENCODER, VOCAB_MOTOR_ENCODER_SPEED,
+ * VOCAB_MOTOR_ENCODER_ACCELERATION, VOCAB_TRQ, VOCAB_OUTPUT (doubles),
+ * VOCAB_CM_CONTROL_MODE and VOCAB_INTERACTION_MODE (ints).
+ *
+ * Optionally the getters fail once the data is older than a timeout, and
+ * joint and motor positions are extrapolated with the received velocity
+ * to the time of the call, in which case the stamp returned is moved
+ * forward by the same amount.
+ */
 class StateExtendedInputPort:public yarp::os::BufferedPort<jointData>
 {
-    jointData last;
+    StateExtendedBuffer buffers[2];
+    yarp::os::impl::AtomicCounter published;
+    double timeout;
+    double horizon;
     Semaphore mutex;
-    Stamp lastStamp;
     double deltaT;
     double deltaTMax;
     double deltaTMin;
     double prev;
     double now;
 
-    bool valid;
     int count;
 public:
 
@@ -61,11 +109,34 @@ public:
     inline void resetStat();
     void init(int numberOfJoints);
 
+    /*
+     * Make the getters fail when the last data arrived more than timeout
+     * seconds ago, 0 disables the check.
+     */
+    void setTimeout(double timeout);
+
+    /*
+     * Extrapolate positions by at most horizon seconds, 0 disables the
+     * extrapolation.
+     */
+    void setExtrapolation(double horizon);
+
     using yarp::os::BufferedPort<jointData>::onRead;
     virtual void onRead(jointData &v);
 
-    bool getLast(int j, jointData &data, Stamp &stamp, double &localArrivalTime);
-    bool getLast(jointData &data2, Stamp &stmp, double &localArrivalTime);
+    /*
+     * Read one field for joint j, fails if no valid data has been
+     * received for that field.
+     */
+    bool getLastSingle(int j, int field, double *data, Stamp &stamp, double &localArrivalTime);
+    bool getLastSingle(int j, int field, int *data, Stamp &stamp, double &localArrivalTime);
+
+    /*
+     * Read one field for all joints, data must have room for the
+     * number of joints given to init().
+     */
+    bool getLastVector(int field, double *data, Stamp &stamp, double &localArrivalTime);
+    bool getLastVector(int field, int *data, Stamp &stamp, double &localArrivalTime);
     int  getIterations();
 
     // time is in ms
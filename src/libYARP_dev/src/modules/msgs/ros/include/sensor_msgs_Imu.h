@@ -65,7 +65,7 @@ public:
     // *** orientation_covariance ***
     int len = 9;
     orientation_covariance.resize(len);
-    if (!connection.expectBlock((char*)&orientation_covariance[0],sizeof(yarp::os::NetFloat64)*len)) return false;
+    if (len>0 && !connection.expectBlock((char*)&orientation_covariance[0],sizeof(yarp::os::NetFloat64)*len)) return false;
 
     // *** angular_velocity ***
     if (!angular_velocity.read(connection)) return false;
@@ -73,7 +73,7 @@ public:
     // *** angular_velocity_covariance ***
     len = 9;
     angular_velocity_covariance.resize(len);
-    if (!connection.expectBlock((char*)&angular_velocity_covariance[0],sizeof(yarp::os::NetFloat64)*len)) return false;
+    if (len>0 && !connection.expectBlock((char*)&angular_velocity_covariance[0],sizeof(yarp::os::NetFloat64)*len)) return false;
 
     // *** linear_acceleration ***
     if (!linear_acceleration.read(connection)) return false;
@@ -81,7 +81,7 @@ public:
     // *** linear_acceleration_covariance ***
     len = 9;
     linear_acceleration_covariance.resize(len);
-    if (!connection.expectBlock((char*)&linear_acceleration_covariance[0],sizeof(yarp::os::NetFloat64)*len)) return false;
+    if (len>0 && !connection.expectBlock((char*)&linear_acceleration_covariance[0],sizeof(yarp::os::NetFloat64)*len)) return false;
     return !connection.isError();
   }
 
@@ -100,9 +100,7 @@ public:
     if (connection.expectInt()!=(BOTTLE_TAG_LIST|BOTTLE_TAG_DOUBLE)) return false;
     int len = connection.expectInt();
     orientation_covariance.resize(len);
-    for (int i=0; i<len; i++) {
-      orientation_covariance[i] = (yarp::os::NetFloat64)connection.expectDouble();
-    }
+    if (len>0 && !connection.expectBlock((char*)&orientation_covariance[0],sizeof(yarp::os::NetFloat64)*len)) return false;
 
     // *** angular_velocity ***
     if (!angular_velocity.read(connection)) return false;
@@ -111,9 +109,7 @@ public:
     if (connection.expectInt()!=(BOTTLE_TAG_LIST|BOTTLE_TAG_DOUBLE)) return false;
     len = connection.expectInt();
     angular_velocity_covariance.resize(len);
-    for (int i=0; i<len; i++) {
-      angular_velocity_covariance[i] = (yarp::os::NetFloat64)connection.expectDouble();
-    }
+    if (len>0 && !connection.expectBlock((char*)&angular_velocity_covariance[0],sizeof(yarp::os::NetFloat64)*len)) return false;
 
     // *** linear_acceleration ***
     if (!linear_acceleration.read(connection)) return false;
@@ -122,9 +118,7 @@ public:
     if (connection.expectInt()!=(BOTTLE_TAG_LIST|BOTTLE_TAG_DOUBLE)) return false;
     len = connection.expectInt();
     linear_acceleration_covariance.resize(len);
-    for (int i=0; i<len; i++) {
-      linear_acceleration_covariance[i] = (yarp::os::NetFloat64)connection.expectDouble();
-    }
+    if (len>0 && !connection.expectBlock((char*)&linear_acceleration_covariance[0],sizeof(yarp::os::NetFloat64)*len)) return false;
     return !connection.isError();
   }
 
@@ -142,19 +136,19 @@ public:
     if (!orientation.write(connection)) return false;
 
     // *** orientation_covariance ***
-    connection.appendExternalBlock((char*)&orientation_covariance[0],sizeof(yarp::os::NetFloat64)*orientation_covariance.size());
+    if (orientation_covariance.size()>0) {connection.appendExternalBlock((char*)&orientation_covariance[0],sizeof(yarp::os::NetFloat64)*orientation_covariance.size());}
 
     // *** angular_velocity ***
     if (!angular_velocity.write(connection)) return false;
 
     // *** angular_velocity_covariance ***
-    connection.appendExternalBlock((char*)&angular_velocity_covariance[0],sizeof(yarp::os::NetFloat64)*angular_velocity_covariance.size());
+    if (angular_velocity_covariance.size()>0) {connection.appendExternalBlock((char*)&angular_velocity_covariance[0],sizeof(yarp::os::NetFloat64)*angular_velocity_covariance.size());}
 
     // *** linear_acceleration ***
     if (!linear_acceleration.write(connection)) return false;
 
     // *** linear_acceleration_covariance ***
-    connection.appendExternalBlock((char*)&linear_acceleration_covariance[0],sizeof(yarp::os::NetFloat64)*linear_acceleration_covariance.size());
+    if (linear_acceleration_covariance.size()>0) {connection.appendExternalBlock((char*)&linear_acceleration_covariance[0],sizeof(yarp::os::NetFloat64)*linear_acceleration_covariance.size());}
     return !connection.isError();
   }
 
@@ -171,9 +165,7 @@ public:
     // *** orientation_covariance ***
     connection.appendInt(BOTTLE_TAG_LIST|BOTTLE_TAG_DOUBLE);
     connection.appendInt(orientation_covariance.size());
-    for (size_t i=0; i<orientation_covariance.size(); i++) {
-      connection.appendDouble((double)orientation_covariance[i]);
-    }
+    if (orientation_covariance.size()>0) {connection.appendExternalBlock((char*)&orientation_covariance[0],sizeof(yarp::os::NetFloat64)*orientation_covariance.size());}
 
     // *** angular_velocity ***
     if (!angular_velocity.write(connection)) return false;
@@ -181,9 +173,7 @@ public:
     // *** angular_velocity_covariance ***
     connection.appendInt(BOTTLE_TAG_LIST|BOTTLE_TAG_DOUBLE);
     connection.appendInt(angular_velocity_covariance.size());
-    for (size_t i=0; i<angular_velocity_covariance.size(); i++) {
-      connection.appendDouble((double)angular_velocity_covariance[i]);
-    }
+    if (angular_velocity_covariance.size()>0) {connection.appendExternalBlock((char*)&angular_velocity_covariance[0],sizeof(yarp::os::NetFloat64)*angular_velocity_covariance.size());}
 
     // *** linear_acceleration ***
     if (!linear_acceleration.write(connection)) return false;
@@ -191,9 +181,7 @@ public:
     // *** linear_acceleration_covariance ***
     connection.appendInt(BOTTLE_TAG_LIST|BOTTLE_TAG_DOUBLE);
     connection.appendInt(linear_acceleration_covariance.size());
-    for (size_t i=0; i<linear_acceleration_covariance.size(); i++) {
-      connection.appendDouble((double)linear_acceleration_covariance[i]);
-    }
+    if (linear_acceleration_covariance.size()>0) {connection.appendExternalBlock((char*)&linear_acceleration_covariance[0],sizeof(yarp::os::NetFloat64)*linear_acceleration_covariance.size());}
     connection.convertTextMode();
     return !connection.isError();
   }
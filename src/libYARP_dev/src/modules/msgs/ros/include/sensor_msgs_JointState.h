@@ -66,17 +66,17 @@ public:
     // *** position ***
     len = connection.expectInt();
     position.resize(len);
-    if (!connection.expectBlock((char*)&position[0],sizeof(yarp::os::NetFloat64)*len)) return false;
+    if (len>0 && !connection.expectBlock((char*)&position[0],sizeof(yarp::os::NetFloat64)*len)) return false;
 
     // *** velocity ***
     len = connection.expectInt();
     velocity.resize(len);
-    if (!connection.expectBlock((char*)&velocity[0],sizeof(yarp::os::NetFloat64)*len)) return false;
+    if (len>0 && !connection.expectBlock((char*)&velocity[0],sizeof(yarp::os::NetFloat64)*len)) return false;
 
     // *** effort ***
     len = connection.expectInt();
     effort.resize(len);
-    if (!connection.expectBlock((char*)&effort[0],sizeof(yarp::os::NetFloat64)*len)) return false;
+    if (len>0 && !connection.expectBlock((char*)&effort[0],sizeof(yarp::os::NetFloat64)*len)) return false;
     return !connection.isError();
   }
 
@@ -102,25 +102,19 @@ public:
     if (connection.expectInt()!=(BOTTLE_TAG_LIST|BOTTLE_TAG_DOUBLE)) return false;
     len = connection.expectInt();
     position.resize(len);
-    for (int i=0; i<len; i++) {
-      position[i] = (yarp::os::NetFloat64)connection.expectDouble();
-    }
+    if (len>0 && !connection.expectBlock((char*)&position[0],sizeof(yarp::os::NetFloat64)*len)) return false;
 
     // *** velocity ***
     if (connection.expectInt()!=(BOTTLE_TAG_LIST|BOTTLE_TAG_DOUBLE)) return false;
     len = connection.expectInt();
     velocity.resize(len);
-    for (int i=0; i<len; i++) {
-      velocity[i] = (yarp::os::NetFloat64)connection.expectDouble();
-    }
+    if (len>0 && !connection.expectBlock((char*)&velocity[0],sizeof(yarp::os::NetFloat64)*len)) return false;
 
     // *** effort ***
     if (connection.expectInt()!=(BOTTLE_TAG_LIST|BOTTLE_TAG_DOUBLE)) return false;
     len = connection.expectInt();
     effort.resize(len);
-    for (int i=0; i<len; i++) {
-      effort[i] = (yarp::os::NetFloat64)connection.expectDouble();
-    }
+    if (len>0 && !connection.expectBlock((char*)&effort[0],sizeof(yarp::os::NetFloat64)*len)) return false;
     return !connection.isError();
   }
 
@@ -143,15 +137,15 @@ public:
 
     // *** position ***
     connection.appendInt(position.size());
-    connection.appendExternalBlock((char*)&position[0],sizeof(yarp::os::NetFloat64)*position.size());
+    if (position.size()>0) {connection.appendExternalBlock((char*)&position[0],sizeof(yarp::os::NetFloat64)*position.size());}
 
     // *** velocity ***
     connection.appendInt(velocity.size());
-    connection.appendExternalBlock((char*)&velocity[0],sizeof(yarp::os::NetFloat64)*velocity.size());
+    if (velocity.size()>0) {connection.appendExternalBlock((char*)&velocity[0],sizeof(yarp::os::NetFloat64)*velocity.size());}
 
     // *** effort ***
     connection.appendInt(effort.size());
-    connection.appendExternalBlock((char*)&effort[0],sizeof(yarp::os::NetFloat64)*effort.size());
+    if (effort.size()>0) {connection.appendExternalBlock((char*)&effort[0],sizeof(yarp::os::NetFloat64)*effort.size());}
     return !connection.isError();
   }
 
@@ -173,23 +167,17 @@ public:
     // *** position ***
     connection.appendInt(BOTTLE_TAG_LIST|BOTTLE_TAG_DOUBLE);
     connection.appendInt(position.size());
-    for (size_t i=0; i<position.size(); i++) {
-      connection.appendDouble((double)position[i]);
-    }
+    if (position.size()>0) {connection.appendExternalBlock((char*)&position[0],sizeof(yarp::os::NetFloat64)*position.size());}
 
     // *** velocity ***
     connection.appendInt(BOTTLE_TAG_LIST|BOTTLE_TAG_DOUBLE);
     connection.appendInt(velocity.size());
-    for (size_t i=0; i<velocity.size(); i++) {
-      connection.appendDouble((double)velocity[i]);
-    }
+    if (velocity.size()>0) {connection.appendExternalBlock((char*)&velocity[0],sizeof(yarp::os::NetFloat64)*velocity.size());}
 
     // *** effort ***
     connection.appendInt(BOTTLE_TAG_LIST|BOTTLE_TAG_DOUBLE);
     connection.appendInt(effort.size());
-    for (size_t i=0; i<effort.size(); i++) {
-      connection.appendDouble((double)effort[i]);
-    }
+    if (effort.size()>0) {connection.appendExternalBlock((char*)&effort[0],sizeof(yarp::os::NetFloat64)*effort.size());}
     connection.convertTextMode();
     return !connection.isError();
   }
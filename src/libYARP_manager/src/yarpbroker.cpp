@@ -752,6 +752,16 @@ bool YarpBroker::getQosFromString(const char* qos, yarp::os::QosStyle& style) {
                     int policy = strtol(value.c_str(), &p, 10);
                     style.setThreadPolicy(policy);
                 }
+                else if (key == "RATE") {
+                    char* p;
+                    double rate = strtod(value.c_str(), &p);
+                    style.setMaxRate(rate);
+                }
+                else if (key == "DROP") {
+                    char* p;
+                    int drop = strtol(value.c_str(), &p, 10);
+                    style.setDropWhenBusy(drop != 0);
+                }
             }
         }
     }
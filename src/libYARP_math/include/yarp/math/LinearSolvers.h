@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2016 iCub Facility - Istituto Italiano di Tecnologia
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ *
+ */
+
+#ifndef YARP_MATH_LINEARSOLVERS
+#define YARP_MATH_LINEARSOLVERS
+
+#include <yarp/sig/Vector.h>
+#include <yarp/sig/Matrix.h>
+#include <yarp/math/api.h>
+
+namespace yarp
+{
+    namespace math
+    {
+        class LUSolver;
+        class CholeskySolver;
+    }
+}
+
+
+/**
+* LU factorization with partial pivoting of square matrices of a given
+* size, computed in preallocated storage (defined in LinearSolvers.h).
+*
+* Unlike luinv() and det(), which allocate a copy of the matrix and a
+* permutation at each call, a LUSolver keeps them across calls, so that
+* once it has seen a matrix of a given size no further memory is
+* allocated (output vectors and matrices are resized only if needed).
+* A factorization can be reused to solve for several right-hand sides.
+*
+* A LUSolver is not thread safe: use one instance per thread.
+*/
+class YARP_math_API yarp::math::LUSolver
+{
+public:
+    /**
+    * Constructor.
+    * @param n size of the matrices to factorize
+    */
+    LUSolver(int n=0);
+
+    ~LUSolver();
+
+    /**
+    * Preallocate the storage for n-by-n matrices.
+    */
+    void resize(int n);
+
+    /**
+    * Factorize A = P^T L U.
+    * @param A square input matrix; if its size differs from the one
+    *          the solver was built for, the storage is reallocated.
+    * @return true on success, false if A is not square or is singular
+    */
+    bool factorize(const yarp::sig::Matrix &A);
+
+    /**
+    * Solve A x = b with the last factorization.
+    * @param b right-hand side
+    * @param x the solution, resized if needed
+    * @return true on success
+    */
+    bool solve(const yarp::sig::Vector &b, yarp::sig::Vector &x) const;
+
+    /**
+    * Compute the inverse of the last factorized matrix, as luinv()
+    * does.
+    * @param out the inverse, resized if needed
+    * @return true on success
+    */
+    bool inverse(yarp::sig::Matrix &out) const;
+
+    /**
+    * @return the determinant of the last factorized matrix, as det()
+    *         computes it.
+    */
+    double det() const;
+
+private:
+    int n;
+    int sign;
+    bool valid;
+    yarp::sig::Matrix LU;
+    void *permutation;
+
+    // not copyable
+    LUSolver(const LUSolver&);
+    LUSolver &operator=(const LUSolver&);
+};
+
+
+/**
+* Cholesky factorization of symmetric positive definite matrices of a
+* given size, computed in preallocated storage (defined in
+* LinearSolvers.h).
+*
+* Typical uses are the normal equations J*J^T+lambda*I of damped least
+* squares and the inversion of inertia matrices. Only the lower
+* triangle of the input is read.
+*
+* A CholeskySolver is not thread safe: use one instance per thread.
+*/
+class YARP_math_API yarp::math::CholeskySolver
+{
+public:
+    /**
+    * Constructor.
+    * @param n size of the matrices to factorize
+    */
+    CholeskySolver(int n=0);
+
+    /**
+    * Preallocate the storage for n-by-n matrices.
+    */
+    void resize(int n);
+
+    /**
+    * Factorize A = L L^T.
+    * @param A symmetric positive definite matrix; if its size differs
+    *          from the one the solver was built for, the storage is
+    *          reallocated.
+    * @return true on success, false if A is not square or not
+    *         positive definite
+    */
+    bool factorize(const yarp::sig::Matrix &A);
+
+    /**
+    * Solve A x = b with the last factorization.
+    * @param b right-hand side
+    * @param x the solution, resized if needed; it can be b
+    * @return true on success
+    */
+    bool solve(const yarp::sig::Vector &b, yarp::sig::Vector &x) const;
+
+    /**
+    * Compute the inverse of the last factorized matrix.
+    * @param out the inverse, resized if needed
+    * @return true on success
+    */
+    bool inverse(yarp::sig::Matrix &out) const;
+
+private:
+    int n;
+    bool valid;
+    yarp::sig::Matrix L;
+};
+
+#endif
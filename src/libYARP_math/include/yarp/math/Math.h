@@ -615,6 +615,163 @@ namespace yarp
         * @return the inverse of the adjoint matrix  
         */
         YARP_math_API yarp::sig::Matrix adjointInv(const yarp::sig::Matrix &H);
+
+        /**
+        * Sum of vectors computed in preallocated storage (defined in 
+        * Math.h). The result is resized only if its size does not 
+        * match, so no memory is allocated when it is reused. 
+        * @param a first vector. 
+        * @param b second vector. 
+        * @param res the result a+b; it can be a or b. 
+        * @return true iff successful (a and b have the same size). 
+        */
+        YARP_math_API bool add(const yarp::sig::Vector &a, const yarp::sig::Vector &b,
+                               yarp::sig::Vector &res);
+
+        /**
+        * Difference of vectors computed in preallocated storage 
+        * (defined in Math.h). 
+        * @param a first vector. 
+        * @param b second vector. 
+        * @param res the result a-b; it can be a or b. 
+        * @return true iff successful (a and b have the same size). 
+        */
+        YARP_math_API bool sub(const yarp::sig::Vector &a, const yarp::sig::Vector &b,
+                               yarp::sig::Vector &res);
+
+        /**
+        * Scalar-vector product computed in preallocated storage 
+        * (defined in Math.h). 
+        * @param k a scalar. 
+        * @param a a vector. 
+        * @param res the result k*a; it can be a. 
+        * @return true. 
+        */
+        YARP_math_API bool mul(double k, const yarp::sig::Vector &a, yarp::sig::Vector &res);
+
+        /**
+        * Matrix-vector product computed in preallocated storage 
+        * (defined in Math.h). 
+        * @param m a matrix. 
+        * @param a a vector (interpreted as a column). 
+        * @param res the result m*a; it must not be a. 
+        * @return true iff successful. 
+        */
+        YARP_math_API bool mul(const yarp::sig::Matrix &m, const yarp::sig::Vector &a,
+                               yarp::sig::Vector &res);
+
+        /**
+        * Vector-matrix product computed in preallocated storage 
+        * (defined in Math.h). 
+        * @param a a vector (interpreted as a row). 
+        * @param m a matrix. 
+        * @param res the result a*m; it must not be a. 
+        * @return true iff successful. 
+        */
+        YARP_math_API bool mul(const yarp::sig::Vector &a, const yarp::sig::Matrix &m,
+                               yarp::sig::Vector &res);
+
+        /**
+        * Matrix-matrix product computed in preallocated storage 
+        * (defined in Math.h). 
+        * @param a a matrix. 
+        * @param b a matrix. 
+        * @param res the result a*b; it must be neither a nor b. 
+        * @return true iff successful. 
+        */
+        YARP_math_API bool mul(const yarp::sig::Matrix &a, const yarp::sig::Matrix &b,
+                               yarp::sig::Matrix &res);
+
+        /**
+        * Fused scaled vector sum y=k*x+y, computed in place (defined 
+        * in Math.h). 
+        * @param k a scalar. 
+        * @param x a vector. 
+        * @param y the vector to be updated. 
+        * @return true iff successful (x and y have the same size). 
+        */
+        YARP_math_API bool axpy(double k, const yarp::sig::Vector &x, yarp::sig::Vector &y);
+
+        /**
+        * Fused matrix-vector product y=alpha*m*x+beta*y, computed in 
+        * place (defined in Math.h). For instance, J*q+K*(xd-x) is 
+        * evaluated without temporaries as sub(xd,x,e); 
+        * mul(J,q,y); gemv(1.0,K,e,1.0,y). 
+        * @param alpha a scalar. 
+        * @param m a matrix. 
+        * @param x a vector; it must not be y. 
+        * @param beta a scalar; if zero, the initial content of y is 
+        *             ignored.
+        * @param y the vector to be updated. 
+        * @return true iff successful. 
+        */
+        YARP_math_API bool gemv(double alpha, const yarp::sig::Matrix &m,
+                                const yarp::sig::Vector &x, double beta,
+                                yarp::sig::Vector &y);
+
+        /**
+        * Concatenation of vectors computed in preallocated storage 
+        * (defined in Math.h). 
+        * @param v1 first vector. 
+        * @param v2 second vector. 
+        * @param res the result [v1 v2]; it must be neither v1 nor v2. 
+        * @return true iff successful. 
+        */
+        YARP_math_API bool cat(const yarp::sig::Vector &v1, const yarp::sig::Vector &v2,
+                               yarp::sig::Vector &res);
+
+        /**
+        * Horizontal concatenation of matrices computed in 
+        * preallocated storage (defined in Math.h). 
+        * @param m1 first matrix. 
+        * @param m2 second matrix. 
+        * @param res the result [m1 m2]; it must be neither m1 nor m2. 
+        * @return true iff successful (m1 and m2 have the same number 
+        *         of rows).
+        */
+        YARP_math_API bool cat(const yarp::sig::Matrix &m1, const yarp::sig::Matrix &m2,
+                               yarp::sig::Matrix &res);
+
+        /**
+        * Vertical concatenation of matrices computed in preallocated 
+        * storage (defined in Math.h). 
+        * @param m1 first matrix. 
+        * @param m2 second matrix. 
+        * @param res the result [m1; m2]; it must be neither m1 nor m2.
+        * @return true iff successful (m1 and m2 have the same number 
+        *         of columns).
+        */
+        YARP_math_API bool pile(const yarp::sig::Matrix &m1, const yarp::sig::Matrix &m2,
+                                yarp::sig::Matrix &res);
+
+        /**
+        * Outer product computed in preallocated storage (defined in 
+        * Math.h). 
+        * @param a first vector. 
+        * @param b second vector. 
+        * @param res the result a*b'. 
+        * @return true iff successful (a and b have the same size). 
+        */
+        YARP_math_API bool outerProduct(const yarp::sig::Vector &a, const yarp::sig::Vector &b,
+                                        yarp::sig::Matrix &res);
+
+        /**
+        * Inverse of a 4 by 4 rototranslational matrix computed in 
+        * preallocated storage (defined in Math.h). 
+        * @param H is the 4 by 4 rototranslational matrix. 
+        * @param res the inverse of H; it can be H. 
+        * @return true iff successful. 
+        */
+        YARP_math_API bool SE3inv(const yarp::sig::Matrix &H, yarp::sig::Matrix &res);
+
+        /**
+        * Adjoint of a roto-translational matrix computed in 
+        * preallocated storage (defined in Math.h). 
+        * @param H is the 4 by 4 rototranslational matrix. 
+        * @param res the 6 by 6 adjoint matrix; it must not be H. 
+        * @return true iff successful. 
+        */
+        YARP_math_API bool adjoint(const yarp::sig::Matrix &H, yarp::sig::Matrix &res);
     }
 }
 
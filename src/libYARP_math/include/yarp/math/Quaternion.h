@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2016 iCub Facility - Istituto Italiano di Tecnologia
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ *
+ */
+
+#ifndef YARP_MATH_QUATERNION
+#define YARP_MATH_QUATERNION
+
+#include <cmath>
+
+#include <yarp/os/Log.h>
+#include <yarp/sig/Vector.h>
+
+namespace yarp {
+    namespace math {
+        class Quaternion;
+    }
+}
+
+/**
+* A unit quaternion stored on the stack, in the form
+* \f[ \mathbf{q}=q_0 + i \cdot q_1 + j \cdot q_2 + k \cdot q_3 \f]
+* (defined in Quaternion.h).
+*
+* The convention is the one of yarp::math::dcm2quat() and
+* yarp::math::quat2dcm(), and the product is defined so that the
+* quaternions of two rotations compose like the rotations do:
+* Quaternion(R1)*Quaternion(R2) represents R1*R2 (see Rotation3.h).
+*
+* All the members are inline and allocate no memory.
+*/
+class yarp::math::Quaternion
+{
+    double q[4];
+
+public:
+    /**
+    * Build the identity quaternion.
+    */
+    Quaternion()
+    {
+        q[0]=1.0; q[1]=q[2]=q[3]=0.0;
+    }
+
+    Quaternion(double q0, double q1, double q2, double q3)
+    {
+        q[0]=q0; q[1]=q1; q[2]=q2; q[3]=q3;
+    }
+
+    /**
+    * Build a quaternion from a vector with at least 4 elements.
+    */
+    explicit Quaternion(const yarp::sig::Vector &v)
+    {
+        yAssert(v.length()>=4);
+        q[0]=v[0]; q[1]=v[1]; q[2]=v[2]; q[3]=v[3];
+    }
+
+    double &operator[](int i)             { return q[i]; }
+    const double &operator[](int i) const { return q[i]; }
+
+    /**
+    * Quaternion product, composing rotations as the corresponding
+    * rotation matrices do.
+    */
+    Quaternion operator*(const Quaternion &b) const
+    {
+        return Quaternion(b.q[0]*q[0]-b.q[1]*q[1]-b.q[2]*q[2]-b.q[3]*q[3],
+                          b.q[0]*q[1]+b.q[1]*q[0]+b.q[2]*q[3]-b.q[3]*q[2],
+                          b.q[0]*q[2]-b.q[1]*q[3]+b.q[2]*q[0]+b.q[3]*q[1],
+                          b.q[0]*q[3]+b.q[1]*q[2]-b.q[2]*q[1]+b.q[3]*q[0]);
+    }
+
+    /**
+    * @return the conjugate, which represents the inverse rotation.
+    */
+    Quaternion conjugate() const
+    {
+        return Quaternion(q[0],-q[1],-q[2],-q[3]);
+    }
+
+    double norm() const
+    {
+        return sqrt(q[0]*q[0]+q[1]*q[1]+q[2]*q[2]+q[3]*q[3]);
+    }
+
+    /**
+    * Scale the quaternion to unit norm.
+    */
+    void normalize()
+    {
+        double n=norm();
+        if (n>0.0)
+        {
+            n=1.0/n;
+            q[0]*=n; q[1]*=n; q[2]*=n; q[3]*=n;
+        }
+    }
+
+    /**
+    * Copy the quaternion in a 4-dimensional vector, resized if
+    * needed.
+    */
+    void toVector(yarp::sig::Vector &v) const
+    {
+        v.resize(4);
+        v[0]=q[0]; v[1]=q[1]; v[2]=q[2]; v[3]=q[3];
+    }
+
+    yarp::sig::Vector toVector() const
+    {
+        yarp::sig::Vector v(4);
+        toVector(v);
+        return v;
+    }
+};
+
+#endif
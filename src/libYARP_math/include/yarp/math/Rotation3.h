@@ -0,0 +1,309 @@
+/*
+ * Copyright (C) 2016 iCub Facility - Istituto Italiano di Tecnologia
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ *
+ */
+
+#ifndef YARP_MATH_ROTATION3
+#define YARP_MATH_ROTATION3
+
+#include <cmath>
+
+#include <yarp/os/Log.h>
+#include <yarp/sig/Vector.h>
+#include <yarp/sig/Matrix.h>
+#include <yarp/math/Quaternion.h>
+
+namespace yarp {
+    namespace math {
+        class Rotation3;
+    }
+}
+
+/**
+* A 3 by 3 rotation matrix stored on the stack (defined in Rotation3.h).
+*
+* It offers the conversions of yarp::math::dcm2axis(), axis2dcm(),
+* dcm2rpy(), rpy2dcm(), dcm2quat() and quat2dcm() with the same
+* conventions, and it can be built from and copied to a
+* yarp::sig::Matrix. All the members are inline, fully unrolled and
+* allocate no memory, apart from those returning a yarp::sig::Matrix or
+* yarp::sig::Vector.
+*/
+class yarp::math::Rotation3
+{
+    double m[9];
+
+public:
+    /**
+    * Build the identity rotation.
+    */
+    Rotation3()
+    {
+        m[0]=1.0; m[1]=0.0; m[2]=0.0;
+        m[3]=0.0; m[4]=1.0; m[5]=0.0;
+        m[6]=0.0; m[7]=0.0; m[8]=1.0;
+    }
+
+    Rotation3(double r00, double r01, double r02,
+              double r10, double r11, double r12,
+              double r20, double r21, double r22)
+    {
+        m[0]=r00; m[1]=r01; m[2]=r02;
+        m[3]=r10; m[4]=r11; m[5]=r12;
+        m[6]=r20; m[7]=r21; m[8]=r22;
+    }
+
+    /**
+    * Build a rotation from the top left 3 by 3 submatrix of R.
+    */
+    explicit Rotation3(const yarp::sig::Matrix &R)
+    {
+        yAssert((R.rows()>=3) && (R.cols()>=3));
+        m[0]=R(0,0); m[1]=R(0,1); m[2]=R(0,2);
+        m[3]=R(1,0); m[4]=R(1,1); m[5]=R(1,2);
+        m[6]=R(2,0); m[7]=R(2,1); m[8]=R(2,2);
+    }
+
+    /**
+    * Build a rotation from a quaternion, as quat2dcm() does.
+    */
+    explicit Rotation3(const Quaternion &quat)
+    {
+        Quaternion q=quat;
+        q.normalize();
+        m[0]=q[0]*q[0]+q[1]*q[1]-q[2]*q[2]-q[3]*q[3];
+        m[1]=2.0*(q[1]*q[2]+q[0]*q[3]);
+        m[2]=2.0*(q[1]*q[3]-q[0]*q[2]);
+        m[3]=2.0*(q[1]*q[2]-q[0]*q[3]);
+        m[4]=q[0]*q[0]-q[1]*q[1]+q[2]*q[2]-q[3]*q[3];
+        m[5]=2.0*(q[2]*q[3]+q[0]*q[1]);
+        m[6]=2.0*(q[1]*q[3]+q[0]*q[2]);
+        m[7]=2.0*(q[2]*q[3]-q[0]*q[1]);
+        m[8]=q[0]*q[0]-q[1]*q[1]-q[2]*q[2]+q[3]*q[3];
+    }
+
+    /**
+    * Build the rotation of theta radians around the unit vector
+    * (x,y,z), as axis2dcm() does.
+    */
+    static Rotation3 fromAxisAngle(double x, double y, double z, double theta)
+    {
+        double c=cos(theta);
+        double s=sin(theta);
+        double C=1.0-c;
+
+        double xs=x*s;   double ys=y*s;   double zs=z*s;
+        double xC=x*C;   double yC=y*C;   double zC=z*C;
+        double xyC=x*yC; double yzC=y*zC; double zxC=z*xC;
+
+        return Rotation3(x*xC+c, xyC-zs, zxC+ys,
+                         xyC+zs, y*yC+c, yzC-xs,
+                         zxC-ys, yzC+xs, z*zC+c);
+    }
+
+    /**
+    * Build the ZYX rotation Rz(yaw)*Ry(pitch)*Rx(roll), as rpy2dcm()
+    * does.
+    */
+    static Rotation3 fromRPY(double roll, double pitch, double yaw)
+    {
+        double cr=cos(roll);  double sr=sin(roll);
+        double cp=cos(pitch); double sp=sin(pitch);
+        double cy=cos(yaw);   double sy=sin(yaw);
+
+        return Rotation3(cy*cp, cy*sp*sr-sy*cr, cy*sp*cr+sy*sr,
+                         sy*cp, sy*sp*sr+cy*cr, sy*sp*cr-cy*sr,
+                         -sp,   cp*sr,          cp*cr);
+    }
+
+    double &operator()(int r, int c)             { return m[3*r+c]; }
+    const double &operator()(int r, int c) const { return m[3*r+c]; }
+
+    /**
+    * Composition of rotations.
+    */
+    Rotation3 operator*(const Rotation3 &b) const
+    {
+        const double *a=m;
+        const double *o=b.m;
+        return Rotation3(a[0]*o[0]+a[1]*o[3]+a[2]*o[6],
+                         a[0]*o[1]+a[1]*o[4]+a[2]*o[7],
+                         a[0]*o[2]+a[1]*o[5]+a[2]*o[8],
+                         a[3]*o[0]+a[4]*o[3]+a[5]*o[6],
+                         a[3]*o[1]+a[4]*o[4]+a[5]*o[7],
+                         a[3]*o[2]+a[4]*o[5]+a[5]*o[8],
+                         a[6]*o[0]+a[7]*o[3]+a[8]*o[6],
+                         a[6]*o[1]+a[7]*o[4]+a[8]*o[7],
+                         a[6]*o[2]+a[7]*o[5]+a[8]*o[8]);
+    }
+
+    /**
+    * @return the transpose, i.e. the inverse rotation.
+    */
+    Rotation3 transposed() const
+    {
+        return Rotation3(m[0], m[3], m[6],
+                         m[1], m[4], m[7],
+                         m[2], m[5], m[8]);
+    }
+
+    /**
+    * Rotate a point: out=R*in; out can be in.
+    */
+    void apply(const double in[3], double out[3]) const
+    {
+        double x=in[0], y=in[1], z=in[2];
+        out[0]=m[0]*x+m[1]*y+m[2]*z;
+        out[1]=m[3]*x+m[4]*y+m[5]*z;
+        out[2]=m[6]*x+m[7]*y+m[8]*z;
+    }
+
+    /**
+    * Convert to axis/angle as dcm2axis() does.
+    * @param v filled with the unit axis (v[0],v[1],v[2]) and the
+    *          angle v[3] in [0,pi].
+    * @note when the angle is 0 the axis is (0,0,1); when it is pi the
+    *       axis is found in closed form and may have the opposite sign
+    *       of the one returned by dcm2axis().
+    */
+    void toAxisAngle(double v[4]) const
+    {
+        double x=m[7]-m[5];
+        double y=m[2]-m[6];
+        double z=m[3]-m[1];
+        double r=sqrt(x*x+y*y+z*z);
+        double theta=atan2(0.5*r,0.5*(m[0]+m[4]+m[8]-1.0));
+
+        if (r<1e-9)
+        {
+            // R is symmetric: either the identity or a rotation of pi,
+            // in which case R=2*n*n'-I
+            if (m[0]+m[4]+m[8]>1.0)
+            {
+                x=0.0; y=0.0; z=1.0;
+            }
+            else if ((m[0]>=m[4]) && (m[0]>=m[8]))
+            {
+                x=sqrt(0.5*(m[0]+1.0));
+                y=m[1]/(2.0*x);
+                z=m[2]/(2.0*x);
+            }
+            else if (m[4]>=m[8])
+            {
+                y=sqrt(0.5*(m[4]+1.0));
+                x=m[1]/(2.0*y);
+                z=m[5]/(2.0*y);
+            }
+            else
+            {
+                z=sqrt(0.5*(m[8]+1.0));
+                x=m[2]/(2.0*z);
+                y=m[5]/(2.0*z);
+            }
+            r=sqrt(x*x+y*y+z*z);
+        }
+
+        v[0]=x/r;
+        v[1]=y/r;
+        v[2]=z/r;
+        v[3]=theta;
+    }
+
+    /**
+    * Convert to roll, pitch and yaw as dcm2rpy() does.
+    */
+    void toRPY(double &roll, double &pitch, double &yaw) const
+    {
+        // M_PI is not available everywhere without _USE_MATH_DEFINES
+        const double halfPi=1.57079632679489661923;
+        if (m[6]<1.0)
+        {
+            if (m[6]>-1.0)
+            {
+                roll=atan2(m[7],m[8]);
+                pitch=asin(-m[6]);
+                yaw=atan2(m[3],m[0]);
+            }
+            else
+            {
+                roll=0.0;
+                pitch=halfPi;
+                yaw=-atan2(-m[5],m[4]);
+            }
+        }
+        else
+        {
+            roll=0.0;
+            pitch=-halfPi;
+            yaw=atan2(-m[5],m[4]);
+        }
+    }
+
+    /**
+    * Convert to a quaternion as dcm2quat() does.
+    */
+    Quaternion toQuaternion() const
+    {
+        double tr=m[0]+m[4]+m[8];
+        if (tr>0.0)
+        {
+            double sqtrp1=sqrt(tr+1.0);
+            double k=1.0/(2.0*sqtrp1);
+            return Quaternion(0.5*sqtrp1,
+                              (m[5]-m[7])*k,
+                              (m[6]-m[2])*k,
+                              (m[1]-m[3])*k);
+        }
+        else if ((m[4]>m[0]) && (m[4]>m[8]))
+        {
+            double sqdip1=sqrt(m[4]-m[0]-m[8]+1.0);
+            double k=(sqdip1>0.0)?0.5/sqdip1:sqdip1;
+            return Quaternion((m[6]-m[2])*k,
+                              (m[1]+m[3])*k,
+                              0.5*sqdip1,
+                              (m[5]+m[7])*k);
+        }
+        else if (m[8]>m[0])
+        {
+            double sqdip1=sqrt(m[8]-m[0]-m[4]+1.0);
+            double k=(sqdip1>0.0)?0.5/sqdip1:sqdip1;
+            return Quaternion((m[1]-m[3])*k,
+                              (m[6]+m[2])*k,
+                              (m[5]+m[7])*k,
+                              0.5*sqdip1);
+        }
+        else
+        {
+            double sqdip1=sqrt(m[0]-m[4]-m[8]+1.0);
+            double k=(sqdip1>0.0)?0.5/sqdip1:sqdip1;
+            return Quaternion((m[5]-m[7])*k,
+                              0.5*sqdip1,
+                              (m[1]+m[3])*k,
+                              (m[6]+m[2])*k);
+        }
+    }
+
+    /**
+    * Copy the rotation in a 4 by 4 homogeneous matrix with no
+    * translation, like the one returned by rpy2dcm(); H is resized if
+    * needed.
+    */
+    void toMatrix(yarp::sig::Matrix &H) const
+    {
+        H.resize(4,4);
+        H(0,0)=m[0]; H(0,1)=m[1]; H(0,2)=m[2]; H(0,3)=0.0;
+        H(1,0)=m[3]; H(1,1)=m[4]; H(1,2)=m[5]; H(1,3)=0.0;
+        H(2,0)=m[6]; H(2,1)=m[7]; H(2,2)=m[8]; H(2,3)=0.0;
+        H(3,0)=0.0;  H(3,1)=0.0;  H(3,2)=0.0;  H(3,3)=1.0;
+    }
+
+    yarp::sig::Matrix toMatrix() const
+    {
+        yarp::sig::Matrix H(4,4);
+        toMatrix(H);
+        return H;
+    }
+};
+
+#endif
@@ -16,6 +16,8 @@ namespace yarp
 {
     namespace math 
     {
+        class SVDSolver;
+
         /** 
         * Factorize the M-by-N matrix 'in' into the singular value decomposition in = U S V^T (defined in SVD.h).
         * The diagonal elements of the singular value matrix S are stored in the vector S.
@@ -161,4 +163,106 @@ namespace yarp
     }
 }
 
+/**
+* Singular value decomposition and pseudo-inverses of matrices of a
+* given size, computed in preallocated storage (defined in SVD.h).
+*
+* The free functions SVD(), pinv() and pinvDamped() allocate their
+* factors and temporaries at each call; an SVDSolver keeps them across
+* calls, so that once it has seen a matrix of a given size no further
+* memory is allocated (output matrices are resized only if needed).
+* This is meant for loops that invert Jacobians of the same size at
+* high rate.
+*
+* Two methods are available: the Golub-Reinsch algorithm used by SVD()
+* and a one-sided Jacobi method, which is usually faster for the small
+* matrices found in kinematics (up to about 10 by 10) and computes the
+* small singular values to higher relative accuracy.
+*
+* An SVDSolver is not thread safe: use one instance per thread.
+*/
+class YARP_math_API yarp::math::SVDSolver
+{
+public:
+    enum Method
+    {
+        GolubReinsch,
+        Jacobi
+    };
+
+    /**
+    * Constructor.
+    * @param rows number of rows of the matrices to decompose
+    * @param cols number of columns of the matrices to decompose
+    * @param method the decomposition method
+    */
+    SVDSolver(int rows=0, int cols=0, Method method=GolubReinsch);
+
+    /**
+    * Preallocate the storage for rows-by-cols matrices.
+    */
+    void resize(int rows, int cols);
+
+    void setMethod(Method method) { this->method=method; }
+    Method getMethod() const      { return method;         }
+
+    /**
+    * Decompose in = U S V^T, as SVD() does.
+    * @param in input M-by-N matrix; if its size differs from the one
+    *           the solver was built for, the storage is reallocated.
+    * @return true on success
+    */
+    bool decompose(const yarp::sig::Matrix &in);
+
+    /**
+    * @return the M-by-K matrix U of the last decomposition.
+    */
+    const yarp::sig::Matrix &getU() const { return (fat?VB:UA); }
+
+    /**
+    * @return the K singular values of the last decomposition, in
+    *         non-increasing order.
+    */
+    const yarp::sig::Vector &getS() const { return S; }
+
+    /**
+    * @return the N-by-K matrix V of the last decomposition.
+    */
+    const yarp::sig::Matrix &getV() const { return (fat?UA:VB); }
+
+    /**
+    * Compute the moore-penrose pseudo-inverse of a matrix, as pinv()
+    * does.
+    * @param in input matrix
+    * @param out pseudo-inverse of 'in', resized if needed
+    * @param tol singular values less than tol are set to zero
+    * @return true on success
+    */
+    bool pinv(const yarp::sig::Matrix &in, yarp::sig::Matrix &out, double tol=0.0);
+
+    /**
+    * Compute the damped pseudo-inverse of a matrix, as pinvDamped()
+    * does.
+    * @param in input matrix
+    * @param out damped pseudo-inverse of 'in', resized if needed
+    * @param damp damping factor
+    * @return true on success
+    */
+    bool pinvDamped(const yarp::sig::Matrix &in, yarp::sig::Matrix &out, double damp);
+
+private:
+    int m, n, k;
+    bool fat;
+    Method method;
+
+    // UA is the max(M,N)-by-K working copy of the input (or of its
+    // transpose for fat matrices) that is turned into U (or V); VB is
+    // the K-by-K factor on the other side; W holds V*inv(S).
+    yarp::sig::Matrix UA, VB, W;
+    yarp::sig::Vector S, work;
+
+    bool jacobi();
+    bool invert(yarp::sig::Matrix &out);
+};
+
 #endif
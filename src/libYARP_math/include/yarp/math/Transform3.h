@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2016 iCub Facility - Istituto Italiano di Tecnologia
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ *
+ */
+
+#ifndef YARP_MATH_TRANSFORM3
+#define YARP_MATH_TRANSFORM3
+
+#include <yarp/os/Log.h>
+#include <yarp/sig/Vector.h>
+#include <yarp/sig/Matrix.h>
+#include <yarp/math/Rotation3.h>
+
+namespace yarp {
+    namespace math {
+        class Transform3;
+    }
+}
+
+/**
+* A rigid body transformation, i.e. the 4 by 4 homogeneous matrix
+* [R p; 0 1], stored on the stack as a Rotation3 and a 3 elements
+* translation (defined in Transform3.h).
+*
+* It offers the operations of yarp::math::SE3inv() and adjoint() and
+* the composition of homogeneous matrices without allocating memory.
+*/
+class yarp::math::Transform3
+{
+    Rotation3 R;
+    double p[3];
+
+public:
+    /**
+    * Build the identity transformation.
+    */
+    Transform3()
+    {
+        p[0]=p[1]=p[2]=0.0;
+    }
+
+    Transform3(const Rotation3 &_R, double x, double y, double z) : R(_R)
+    {
+        p[0]=x; p[1]=y; p[2]=z;
+    }
+
+    /**
+    * Build a transformation from a 4 by 4 homogeneous matrix; the
+    * last row of H is not read.
+    */
+    explicit Transform3(const yarp::sig::Matrix &H) : R(H)
+    {
+        yAssert((H.rows()>=3) && (H.cols()>=4));
+        p[0]=H(0,3); p[1]=H(1,3); p[2]=H(2,3);
+    }
+
+    Rotation3 &rotation()             { return R; }
+    const Rotation3 &rotation() const { return R; }
+
+    double *translation()             { return p; }
+    const double *translation() const { return p; }
+
+    /**
+    * Composition of transformations, as the product of the
+    * corresponding homogeneous matrices.
+    */
+    Transform3 operator*(const Transform3 &b) const
+    {
+        Transform3 res;
+        res.R=R*b.R;
+        R.apply(b.p,res.p);
+        res.p[0]+=p[0]; res.p[1]+=p[1]; res.p[2]+=p[2];
+        return res;
+    }
+
+    /**
+    * @return the inverse transformation [R' -R'*p; 0 1], as SE3inv()
+    *         does.
+    */
+    Transform3 inverse() const
+    {
+        Transform3 res;
+        res.R=R.transposed();
+        res.R.apply(p,res.p);
+        res.p[0]=-res.p[0]; res.p[1]=-res.p[1]; res.p[2]=-res.p[2];
+        return res;
+    }
+
+    /**
+    * Transform a point: out=R*in+p; out can be in.
+    */
+    void apply(const double in[3], double out[3]) const
+    {
+        R.apply(in,out);
+        out[0]+=p[0]; out[1]+=p[1]; out[2]+=p[2];
+    }
+
+    /**
+    * Fill the 6 by 6 adjoint matrix [R S(p)*R; 0 R], stored row-major,
+    * as adjoint() does.
+    */
+    void adjoint(double A[36]) const
+    {
+        for (int r=0; r<3; r++)
+        {
+            for (int c=0; c<3; c++)
+            {
+                A[6*r+c]=A[6*(r+3)+(c+3)]=R(r,c);
+                A[6*(r+3)+c]=0.0;
+            }
+        }
+
+        // S(p)*R, with S(p) the skew-symmetric matrix of p
+        for (int c=0; c<3; c++)
+        {
+            A[c+3]     =-p[2]*R(1,c)+p[1]*R(2,c);
+            A[6+c+3]   = p[2]*R(0,c)-p[0]*R(2,c);
+            A[12+c+3]  =-p[1]*R(0,c)+p[0]*R(1,c);
+        }
+    }
+
+    /**
+    * Copy the adjoint matrix in A, which is resized to 6 by 6 if
+    * needed.
+    */
+    void adjoint(yarp::sig::Matrix &A) const
+    {
+        A.resize(6,6);
+        adjoint(A.data());
+    }
+
+    /**
+    * Copy the transformation in a 4 by 4 homogeneous matrix; H is
+    * resized if needed.
+    */
+    void toMatrix(yarp::sig::Matrix &H) const
+    {
+        R.toMatrix(H);
+        H(0,3)=p[0]; H(1,3)=p[1]; H(2,3)=p[2];
+    }
+
+    yarp::sig::Matrix toMatrix() const
+    {
+        yarp::sig::Matrix H(4,4);
+        toMatrix(H);
+        return H;
+    }
+};
+
+#endif
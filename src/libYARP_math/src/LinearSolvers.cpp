@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2016 iCub Facility - Istituto Italiano di Tecnologia
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ *
+ */
+
+#include <math.h>
+
+#include <yarp/math/LinearSolvers.h>
+
+#include <gsl/gsl_permutation.h>
+#include <gsl/gsl_linalg.h>
+
+using namespace yarp::sig;
+using namespace yarp::math;
+
+inline gsl_permutation *implementation(void *t)
+{
+    return static_cast<gsl_permutation*>(t);
+}
+
+LUSolver::LUSolver(int n) : n(0), sign(0), valid(false), permutation(NULL)
+{
+    if (n>0)
+        resize(n);
+}
+
+LUSolver::~LUSolver()
+{
+    if (permutation!=NULL)
+        gsl_permutation_free(implementation(permutation));
+}
+
+void LUSolver::resize(int n)
+{
+    if (permutation!=NULL)
+        gsl_permutation_free(implementation(permutation));
+
+    this->n=n;
+    LU.resize(n,n);
+    permutation=gsl_permutation_alloc(n);
+    valid=false;
+}
+
+bool LUSolver::factorize(const Matrix &A)
+{
+    if ((A.rows()!=A.cols()) || (A.rows()==0))
+        return false;
+
+    if ((A.rows()!=n) || (permutation==NULL))
+        resize(A.rows());
+
+    LU=A;
+    gsl_linalg_LU_decomp((gsl_matrix*)LU.getGslMatrix(),
+                         implementation(permutation),&sign);
+    valid=true;
+
+    for (int i=0; i<n; i++)
+        if (LU(i,i)==0.0)
+            return false;
+
+    return true;
+}
+
+bool LUSolver::solve(const Vector &b, Vector &x) const
+{
+    if (!valid || ((int)b.length()!=n))
+        return false;
+
+    // gsl would invoke its error handler on singular matrices
+    for (int i=0; i<n; i++)
+        if (LU(i,i)==0.0)
+            return false;
+
+    if (&x!=&b)
+        x=b;
+
+    gsl_linalg_LU_svx((const gsl_matrix*)LU.getGslMatrix(),
+                      implementation(permutation),
+                      (gsl_vector*)x.getGslVector());
+    return true;
+}
+
+bool LUSolver::inverse(Matrix &out) const
+{
+    if (!valid)
+        return false;
+
+    for (int i=0; i<n; i++)
+        if (LU(i,i)==0.0)
+            return false;
+
+    if ((out.rows()!=n) || (out.cols()!=n))
+        out.resize(n,n);
+
+    gsl_linalg_LU_invert((const gsl_matrix*)LU.getGslMatrix(),
+                         implementation(permutation),
+                         (gsl_matrix*)out.getGslMatrix());
+    return true;
+}
+
+double LUSolver::det() const
+{
+    if (!valid)
+        return 0.0;
+
+    return gsl_linalg_LU_det((gsl_matrix*)LU.getGslMatrix(),sign);
+}
+
+CholeskySolver::CholeskySolver(int n) : n(0), valid(false)
+{
+    if (n>0)
+        resize(n);
+}
+
+void CholeskySolver::resize(int n)
+{
+    this->n=n;
+    L.resize(n,n);
+    valid=false;
+}
+
+bool CholeskySolver::factorize(const Matrix &A)
+{
+    if ((A.rows()!=A.cols()) || (A.rows()==0))
+        return false;
+
+    if (A.rows()!=n)
+        resize(A.rows());
+
+    valid=false;
+    for (int j=0; j<n; j++)
+    {
+        double d=A(j,j);
+        for (int k=0; k<j; k++)
+            d-=L(j,k)*L(j,k);
+
+        if (!(d>0.0))
+            return false;
+
+        d=sqrt(d);
+        L(j,j)=d;
+
+        for (int i=j+1; i<n; i++)
+        {
+            double s=A(i,j);
+            for (int k=0; k<j; k++)
+                s-=L(i,k)*L(j,k);
+            L(i,j)=s/d;
+        }
+    }
+
+    valid=true;
+    return true;
+}
+
+// solve L*L^T*x=b in place, where x is strided
+static void choleskySubstitution(const Matrix &L, double *x, int stride)
+{
+    int n=L.rows();
+    for (int i=0; i<n; i++)
+    {
+        double s=x[i*stride];
+        for (int k=0; k<i; k++)
+            s-=L(i,k)*x[k*stride];
+        x[i*stride]=s/L(i,i);
+    }
+
+    for (int i=n-1; i>=0; i--)
+    {
+        double s=x[i*stride];
+        for (int k=i+1; k<n; k++)
+            s-=L(k,i)*x[k*stride];
+        x[i*stride]=s/L(i,i);
+    }
+}
+
+bool CholeskySolver::solve(const Vector &b, Vector &x) const
+{
+    if (!valid || ((int)b.length()!=n))
+        return false;
+
+    if (&x!=&b)
+        x=b;
+
+    choleskySubstitution(L,x.data(),1);
+    return true;
+}
+
+bool CholeskySolver::inverse(Matrix &out) const
+{
+    if (!valid)
+        return false;
+
+    if ((out.rows()!=n) || (out.cols()!=n))
+        out.resize(n,n);
+
+    out.eye();
+    for (int c=0; c<n; c++)
+        choleskySubstitution(L,out.data()+c,n);
+
+    return true;
+}
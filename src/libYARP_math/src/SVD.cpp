@@ -10,7 +10,10 @@
 
 #include <yarp/math/SVD.h>
 #include <gsl/gsl_linalg.h>
+#include <gsl/gsl_blas.h>
 #include <yarp/math/Math.h>
+#include <float.h>
+#include <math.h>
 
 using namespace yarp::sig;
 
@@ -233,3 +236,185 @@ void yarp::math::nullspaceProjection(const Matrix &A, Matrix &out, double tol)
             VT.setRow(c, zeros(n));
     out = eye(n) - V*VT;
 }
+
+yarp::math::SVDSolver::SVDSolver(int rows, int cols, Method method) :
+                                 m(0), n(0), k(0), fat(false), method(method)
+{
+    if ((rows>0) && (cols>0))
+        resize(rows,cols);
+}
+
+void yarp::math::SVDSolver::resize(int rows, int cols)
+{
+    m=rows;
+    n=cols;
+    k=(m<n)?m:n;
+    fat=(m<n);
+
+    UA.resize(fat?n:m,k);
+    VB.resize(k,k);
+    W.resize(n,k);
+    S.resize(k);
+    work.resize(k);
+}
+
+bool yarp::math::SVDSolver::decompose(const Matrix &in)
+{
+    if ((in.rows()==0) || (in.cols()==0))
+        return false;
+
+    if ((in.rows()!=m) || (in.cols()!=n))
+        resize(in.rows(),in.cols());
+
+    // as in SVD(), fat matrices are decomposed through their transpose
+    if (fat)
+    {
+        for (int r=0; r<m; r++)
+            for (int c=0; c<n; c++)
+                UA(c,r)=in(r,c);
+    }
+    else
+        UA=in;
+
+    if (method==Jacobi)
+        return jacobi();
+
+    return (gsl_linalg_SV_decomp((gsl_matrix*)UA.getGslMatrix(),
+                                 (gsl_matrix*)VB.getGslMatrix(),
+                                 (gsl_vector*)S.getGslVector(),
+                                 (gsl_vector*)work.getGslVector())==GSL_SUCCESS);
+}
+
+bool yarp::math::SVDSolver::jacobi()
+{
+    // one-sided (Hestenes) Jacobi: rotate pairs of columns of UA until
+    // they are all orthogonal, accumulating the rotations in VB; the
+    // singular values are then the norms of the columns
+    int p=UA.rows();
+    double *a=UA.data();
+    double *v=VB.data();
+    VB.eye();
+
+    bool rotated=true;
+    for (int sweep=0; rotated && (sweep<100); sweep++)
+    {
+        rotated=false;
+        for (int i=0; i<k-1; i++)
+        {
+            for (int j=i+1; j<k; j++)
+            {
+                double alpha=0.0, beta=0.0, gamma=0.0;
+                for (int r=0; r<p; r++)
+                {
+                    double ai=a[r*k+i];
+                    double aj=a[r*k+j];
+                    alpha+=ai*ai;
+                    beta+=aj*aj;
+                    gamma+=ai*aj;
+                }
+
+                if (fabs(gamma)<=DBL_EPSILON*sqrt(alpha*beta))
+                    continue;
+
+                double zeta=(beta-alpha)/(2.0*gamma);
+                double t=((zeta>=0.0)?1.0:-1.0)/(fabs(zeta)+sqrt(1.0+zeta*zeta));
+                double c=1.0/sqrt(1.0+t*t);
+                double s=c*t;
+
+                for (int r=0; r<p; r++)
+                {
+                    double ai=a[r*k+i];
+                    double aj=a[r*k+j];
+                    a[r*k+i]=c*ai-s*aj;
+                    a[r*k+j]=s*ai+c*aj;
+                }
+
+                for (int r=0; r<k; r++)
+                {
+                    double vi=v[r*k+i];
+                    double vj=v[r*k+j];
+                    v[r*k+i]=c*vi-s*vj;
+                    v[r*k+j]=s*vi+c*vj;
+                }
+
+                rotated=true;
+            }
+        }
+    }
+
+    for (int j=0; j<k; j++)
+    {
+        double norm=0.0;
+        for (int r=0; r<p; r++)
+            norm+=a[r*k+j]*a[r*k+j];
+        S[j]=norm=sqrt(norm);
+
+        if (norm>0.0)
+            for (int r=0; r<p; r++)
+                a[r*k+j]/=norm;
+    }
+
+    // sort the singular values in non-increasing order
+    for (int j=0; j<k-1; j++)
+    {
+        int jmax=j;
+        for (int i=j+1; i<k; i++)
+            if (S[i]>S[jmax])
+                jmax=i;
+
+        if (jmax!=j)
+        {
+            double tmp=S[j]; S[j]=S[jmax]; S[jmax]=tmp;
+            for (int r=0; r<p; r++)
+            {
+                tmp=a[r*k+j]; a[r*k+j]=a[r*k+jmax]; a[r*k+jmax]=tmp;
+            }
+            for (int r=0; r<k; r++)
+            {
+                tmp=v[r*k+j]; v[r*k+j]=v[r*k+jmax]; v[r*k+jmax]=tmp;
+            }
+        }
+    }
+
+    return !rotated;
+}
+
+bool yarp::math::SVDSolver::invert(Matrix &out)
+{
+    // out = V*diag(work)*U^T
+    const Matrix &U=getU();
+    const Matrix &V=getV();
+    for (int r=0; r<n; r++)
+        for (int c=0; c<k; c++)
+            W(r,c)=V(r,c)*work[c];
+
+    if ((out.rows()!=n) || (out.cols()!=m))
+        out.resize(n,m);
+
+    cblas_dgemm(CblasRowMajor,CblasNoTrans,CblasTrans,n,m,k,
+                1.0,W.data(),k,U.data(),k,0.0,out.data(),m);
+    return true;
+}
+
+bool yarp::math::SVDSolver::pinv(const Matrix &in, Matrix &out, double tol)
+{
+    if (!decompose(in))
+        return false;
+
+    for (int c=0; c<k; c++)
+        work[c]=(S[c]>tol)?1.0/S[c]:0.0;
+
+    return invert(out);
+}
+
+bool yarp::math::SVDSolver::pinvDamped(const Matrix &in, Matrix &out, double damp)
+{
+    if (!decompose(in))
+        return false;
+
+    double damp2=damp*damp;
+    for (int c=0; c<k; c++)
+        work[c]=S[c]/(S[c]*S[c]+damp2);
+
+    return invert(out);
+}
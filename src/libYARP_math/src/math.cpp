@@ -1051,3 +1051,253 @@ Matrix yarp::math::adjointInv(const Matrix &H)
     return A;
 }
 
+
+bool yarp::math::add(const Vector &a, const Vector &b, Vector &res)
+{
+    size_t n=a.size();
+    if (n!=b.size())
+        return false;
+
+    res.resize(n);
+    const double *pa=a.data();
+    const double *pb=b.data();
+    double *pr=res.data();
+    for (size_t i=0; i<n; i++)
+        pr[i]=pa[i]+pb[i];
+    return true;
+}
+
+bool yarp::math::sub(const Vector &a, const Vector &b, Vector &res)
+{
+    size_t n=a.size();
+    if (n!=b.size())
+        return false;
+
+    res.resize(n);
+    const double *pa=a.data();
+    const double *pb=b.data();
+    double *pr=res.data();
+    for (size_t i=0; i<n; i++)
+        pr[i]=pa[i]-pb[i];
+    return true;
+}
+
+bool yarp::math::mul(double k, const Vector &a, Vector &res)
+{
+    size_t n=a.size();
+    res.resize(n);
+    const double *pa=a.data();
+    double *pr=res.data();
+    for (size_t i=0; i<n; i++)
+        pr[i]=k*pa[i];
+    return true;
+}
+
+bool yarp::math::mul(const Matrix &m, const Vector &a, Vector &res)
+{
+    if (((size_t)m.cols()!=a.size()) || (&res==&a))
+        return false;
+
+    res.resize(m.rows());
+    return gemv(1.0,m,a,0.0,res);
+}
+
+bool yarp::math::mul(const Vector &a, const Matrix &m, Vector &res)
+{
+    if (((size_t)m.rows()!=a.size()) || (&res==&a))
+        return false;
+
+    res.resize(m.cols());
+    if ((m.rows()==0) || (m.cols()==0))
+    {
+        res.zero();
+        return true;
+    }
+
+    cblas_dgemv(CblasRowMajor, CblasTrans, m.rows(), m.cols(),
+        1.0, m.data(), m.cols(), a.data(), 1, 0.0, res.data(), 1);
+    return true;
+}
+
+bool yarp::math::mul(const Matrix &a, const Matrix &b, Matrix &res)
+{
+    if ((a.cols()!=b.rows()) || (&res==&a) || (&res==&b))
+        return false;
+
+    res.resize(a.rows(),b.cols());
+    if ((res.rows()==0) || (res.cols()==0))
+        return true;
+    if (a.cols()==0)
+    {
+        res.zero();
+        return true;
+    }
+
+    cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans,
+        res.rows(), res.cols(), a.cols(),
+        1.0, a.data(), a.cols(), b.data(), b.cols(), 0.0,
+        res.data(), res.cols());
+    return true;
+}
+
+bool yarp::math::axpy(double k, const Vector &x, Vector &y)
+{
+    size_t n=x.size();
+    if (n!=y.size())
+        return false;
+
+    const double *px=x.data();
+    double *py=y.data();
+    for (size_t i=0; i<n; i++)
+        py[i]+=k*px[i];
+    return true;
+}
+
+bool yarp::math::gemv(double alpha, const Matrix &m, const Vector &x,
+                      double beta, Vector &y)
+{
+    if (((size_t)m.cols()!=x.size()) || ((size_t)m.rows()!=y.size()) || (&x==&y))
+        return false;
+
+    if (m.rows()==0)
+        return true;
+    if (m.cols()==0)
+    {
+        // an empty product contributes nothing
+        for (size_t i=0; i<y.size(); i++)
+            y[i]=(beta==0.0)?0.0:beta*y[i];
+        return true;
+    }
+
+    // with beta=0, BLAS does not read y, which may be uninitialized
+    cblas_dgemv(CblasRowMajor, CblasNoTrans, m.rows(), m.cols(),
+        alpha, m.data(), m.cols(), x.data(), 1, beta, y.data(), 1);
+    return true;
+}
+
+bool yarp::math::cat(const Vector &v1, const Vector &v2, Vector &res)
+{
+    if ((&res==&v1) || (&res==&v2))
+        return false;
+
+    int n1=v1.size();
+    int n2=v2.size();
+    res.resize(n1+n2);
+    cblas_dcopy(n1, v1.data(), 1, res.data(), 1);       // copy first n1 elements
+    cblas_dcopy(n2, v2.data(), 1, res.data()+n1, 1);    // copy last n2 elements
+    return true;
+}
+
+bool yarp::math::cat(const Matrix &m1, const Matrix &m2, Matrix &res)
+{
+    int r=m1.rows();
+    if ((r!=m2.rows()) || (&res==&m1) || (&res==&m2))
+        return false;
+
+    int c1=m1.cols();
+    int c2=m2.cols();
+    res.resize(r,c1+c2);
+    for (int i=0; i<r; i++)
+    {
+        cblas_dcopy(c1, m1[i], 1, res[i], 1);       // copy first c1 cols of i-th row
+        cblas_dcopy(c2, m2[i], 1, res[i]+c1, 1);    // copy last c2 cols of i-th row
+    }
+    return true;
+}
+
+bool yarp::math::pile(const Matrix &m1, const Matrix &m2, Matrix &res)
+{
+    int c=m1.cols();
+    if ((c!=m2.cols()) || (&res==&m1) || (&res==&m2))
+        return false;
+
+    int r1=m1.rows();
+    int r2=m2.rows();
+    res.resize(r1+r2,c);
+    if (c==0)
+        return true;
+
+    cblas_dcopy(r1*c, m1.data(), 1, res.data(), 1); // copy first r1 rows
+    cblas_dcopy(r2*c, m2.data(), 1, res[r1], 1);    // copy last r2 rows
+    return true;
+}
+
+bool yarp::math::outerProduct(const Vector &a, const Vector &b, Matrix &res)
+{
+    size_t s=a.size();
+    if (s!=b.size())
+        return false;
+
+    res.resize((int)s,(int)s);
+    for (size_t i=0; i<s; i++)
+    {
+        double *row=res[(int)i];
+        for (size_t j=0; j<s; j++)
+            row[j]=a[i]*b[j];
+    }
+    return true;
+}
+
+bool yarp::math::SE3inv(const Matrix &H, Matrix &res)
+{
+    if ((H.rows()!=4) || (H.cols()!=4))
+    {
+        yError("SE3inv() failed");
+        return false;
+    }
+
+    // work on copies so that res may be H itself
+    double R[3][3];
+    double p[3];
+    for (int i=0; i<3; i++)
+    {
+        for (int j=0; j<3; j++)
+            R[i][j]=H(i,j);
+        p[i]=H(i,3);
+    }
+
+    res.resize(4,4);
+    for (int i=0; i<3; i++)
+    {
+        for (int j=0; j<3; j++)
+            res(i,j)=R[j][i];
+        res(i,3)=-(R[0][i]*p[0]+R[1][i]*p[1]+R[2][i]*p[2]);
+    }
+    res(3,0)=res(3,1)=res(3,2)=0.0;
+    res(3,3)=1.0;
+    return true;
+}
+
+bool yarp::math::adjoint(const Matrix &H, Matrix &res)
+{
+    if ((H.rows()!=4) || (H.cols()!=4))
+    {
+        yError("adjoint() failed: roto-translational matrix sized %dx%d instead of 4x4",
+               H.rows(),H.cols());
+        return false;
+    }
+
+    if (&res==&H)
+        return false;
+
+    res.resize(6,6);
+    res.zero();
+    for (int i=0; i<3; i++)
+    {
+        for (int j=0; j<3; j++)
+        {
+            res(i,j)=H(i,j);
+            res(i+3,j+3)=H(i,j);
+        }
+    }
+
+    // S(r)*R, being S(r) the skew matrix of the translational part of H
+    double r[3]={H(0,3), H(1,3), H(2,3)};
+    for (int j=0; j<3; j++)
+    {
+        res(0,j+3)=r[1]*H(2,j)-r[2]*H(1,j);
+        res(1,j+3)=r[2]*H(0,j)-r[0]*H(2,j);
+        res(2,j+3)=r[0]*H(1,j)-r[1]*H(0,j);
+    }
+    return true;
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2016 iCub Facility
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ */
+
+#ifndef YARP_SIG_IMAGERESAMPLE_H
+#define YARP_SIG_IMAGERESAMPLE_H
+
+#include <yarp/sig/Image.h>
+
+namespace yarp {
+    namespace sig {
+        /**
+         * \ingroup sig_class
+         *
+         * Image resampling.
+         */
+        namespace resample {
+            enum
+                {
+                    /**
+                     * Nearest neighbour, the same sampling as
+                     * Image::copy(alt,w,h).
+                     */
+                    METHOD_NEAREST,
+                    /**
+                     * Average of the source area covered by each
+                     * destination pixel, the method of choice to
+                     * shrink images.
+                     */
+                    METHOD_AREA,
+                    /**
+                     * Interpolation between the two nearest pixels
+                     * in each direction.
+                     */
+                    METHOD_BILINEAR,
+                    /**
+                     * Catmull-Rom cubic filter, widened when shrinking
+                     * so that it does not alias.
+                     */
+                    METHOD_CUBIC
+                };
+
+            /**
+             * Resample src into dest, which is resized to width x height.
+             *
+             * All the YARP pixel types are supported, the channels being
+             * filtered independently; Bayer and other raw encodings are
+             * not.  If dest has a different pixel type than src, the
+             * result is converted as by Image::copy().
+             *
+             * @param src the image to resample
+             * @param dest the result
+             * @param width the width of the result
+             * @param height the height of the result
+             * @param method one of the METHOD_* values
+             * @param threads the number of threads sharing the rows of the
+             *        result, used only on images large enough for it to pay
+             * @return true on success
+             */
+            bool YARP_sig_API resize(const Image& src, Image& dest,
+                                     int width, int height,
+                                     int method = METHOD_AREA,
+                                     int threads = 1);
+        }
+    }
+}
+
+#endif // YARP_SIG_IMAGERESAMPLE_H
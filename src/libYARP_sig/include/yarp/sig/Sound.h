@@ -9,6 +9,7 @@
 #define YARP2_SOUND
 
 #include <yarp/os/Portable.h>
+#include <yarp/os/NetInt16.h>
 
 #include <yarp/sig/api.h>
 
@@ -45,11 +46,30 @@ public:
 
      /**
      * Addition assignment operator.
-     * Appends a sound to another sound (internal memory reallocation)
+     * Appends a sound to another sound, see append().
      * @param alt the sound to append
      */
     Sound& operator+=(const Sound& alt);
 
+    /**
+     * Append a sound with the same number of channels and frequency.
+     * The memory grows geometrically, so a sequence of appends takes
+     * amortized linear time.
+     * @param alt the sound to append
+     * @return false if the sounds are not compatible
+     */
+    bool append(const Sound& alt);
+
+    /**
+     * Reserve memory for at least the given number of samples per
+     * channel, so that append() does not reallocate until the sound
+     * grows beyond it. The reservation is made for the current number
+     * of channels, or for a single channel if the sound has none yet,
+     * so call resize() first when reserving for a multichannel sound.
+     * @param samples the number of samples per channel
+     */
+    void reserve(int samples);
+
      /**
      * Returns a subpart of the sound
      * @param first_sample the starting sample number
@@ -75,6 +95,63 @@ public:
         }
     }
 
+    /**
+     * Direct access to the samples of a channel, which are stored
+     * contiguously as signed 16 bit integers.
+     * @param channel the channel to access
+     * @return a pointer to getSamples() samples, valid until the sound
+     * is resized or appended to
+     */
+    yarp::os::NetInt16 *getChannelData(int channel);
+
+    const yarp::os::NetInt16 *getChannelData(int channel) const;
+
+    /**
+     * Copy all the samples as interleaved frames, i.e.
+     * dest[sample*getChannels()+channel].
+     * @param dest getSamples()*getChannels() samples
+     */
+    void getInterleaved(short *dest) const;
+
+    /**
+     * Copy all the samples as interleaved frames, converted to
+     * floating point in [-1,1).
+     * @param dest getSamples()*getChannels() samples
+     */
+    void getInterleaved(float *dest) const;
+
+    /**
+     * Resize the sound and fill it with interleaved frames.
+     * @param src samples*channels samples
+     * @param samples the number of samples per channel
+     * @param channels the number of channels
+     */
+    void setInterleaved(const short *src, int samples, int channels);
+
+    /**
+     * Resize the sound and fill it with interleaved frames in
+     * floating point, which are clipped to [-1,1].
+     * @param src samples*channels samples
+     * @param samples the number of samples per channel
+     * @param channels the number of channels
+     */
+    void setInterleaved(const float *src, int samples, int channels);
+
+    /**
+     * Copy a channel converted to floating point in [-1,1).
+     * @param channel the channel to read
+     * @param dest getSamples() samples
+     */
+    void getChannel(int channel, float *dest) const;
+
+    /**
+     * Fill a channel from floating point samples, which are clipped
+     * to [-1,1].
+     * @param channel the channel to write
+     * @param src getSamples() samples
+     */
+    void setChannel(int channel, const float *src);
+
     /**
      * Check whether a sample lies within the sound
      * @param sample the sample to choose
@@ -113,6 +190,8 @@ private:
     void synchronize();
 
     void *implementation;
+    unsigned char *reserved;
+    int reservedBytes;
     int samples;
     int channels;
     int bytesPerSample;
@@ -9,6 +9,7 @@
 #define YARP2SoundFile_INC
 
 #include <yarp/sig/Sound.h>
+#include <yarp/os/ManagedBytes.h>
 
 namespace yarp {
     namespace sig{
@@ -43,6 +44,7 @@ namespace yarp {
                     int samples;
                     size_t data_start_offset;
                 } soundInfo;
+                yarp::os::ManagedBytes buffer;
 
                 public:
                 soundStreamReader()
@@ -67,6 +69,44 @@ namespace yarp {
                 bool   rewind(size_t sample_offset=0);
                 size_t getIndex();
             };
+
+            /**
+             * Write a sound to a WAV file one block at a time, without
+             * holding the whole recording in memory.  The lengths in the
+             * header are filled in by close().
+             */
+            class YARP_sig_API soundStreamWriter
+            {
+                private:
+                FILE *fp;
+                int freq;
+                int channels;
+                size_t samples;
+                yarp::os::ManagedBytes buffer;
+
+                public:
+                soundStreamWriter()
+                {
+                    fp = 0;
+                    freq = 0;
+                    channels = 0;
+                    samples = 0;
+                }
+
+                ~soundStreamWriter()
+                {
+                    if (fp)
+                    {
+                        close();
+                        fp=0;
+                    }
+                }
+
+                bool   open(const char *filename, int freq, int channels);
+                bool   close();
+                bool   writeBlock(const Sound& src);
+                size_t getSamples() { return samples; }
+            };
         }
     }
 }
@@ -13,6 +13,7 @@
 
 #include <yarp/sig/ImageDraw.h>
 #include <yarp/sig/ImageFile.h>
+#include <yarp/sig/ImageResample.h>
 #include <yarp/sig/Image.h>
 //#include <yarp/sig/IplImage.h> // clashes with OpenCV - only include if really needed
 #include <yarp/sig/Sound.h>
@@ -16,8 +16,10 @@
 #include <yarp/os/Log.h>
 #include <yarp/sig/Image.h>
 #include <yarp/sig/ImageNetworkHeader.h>
+#include <yarp/sig/ImageResample.h>
 
 #include <yarp/os/Bottle.h>
+#include <yarp/os/ManagedBytes.h>
 #include <yarp/os/Vocab.h>
 #include <yarp/os/ConstString.h>
 #include <yarp/os/Time.h>
@@ -32,6 +34,9 @@ using namespace yarp::os;
 
 #define DBGPF1 if (0)
 
+// images that need a conversion are read in chunks of at most this size
+#define YARP_IMAGE_READ_CHUNK 65536
+
 //inline int PAD_BYTES (int len, int pad)
 //{
 //	const int rem = len % pad;
@@ -74,6 +79,10 @@ public:
     int quantum;
     bool topIsLow;
 
+    // reused by Image::read when the incoming pixels must be converted
+    ManagedBytes readChunk;
+    FlexImage *readRaw;
+
 protected:
     Image& owner;
 
@@ -120,10 +129,12 @@ public:
         topIsLow = true;
         extern_type_id = 0;
         extern_type_quantum = -1;
+        readRaw = NULL;
     }
 
     ~ImageStorage() {
         _free_complete();
+        delete readRaw;
     }
 
     void resize(int x, int y, int pixel_type,
@@ -869,7 +880,11 @@ bool Image::read(yarp::os::ConnectionReader& connection) {
         return !connection.isError(); 
     }
 
+    // a FlexImage takes the incoming pixel code, a typed image keeps its own
+    int oldPixelCode = imgPixelCode;
     imgPixelCode = header.id;
+    if (getPixelCode() != header.id)
+        imgPixelCode = oldPixelCode;
 
     int q = getQuantum();
     if (q==0) {
@@ -905,10 +920,15 @@ bool Image::read(yarp::os::ConnectionReader& connection) {
     // Received and current images are binary incompatible do our best to convert
     //
 
+    ImageStorage *impl = (ImageStorage*)implementation;
+
     // handle here all bayer encoding 8 bits
     if (isBayer8(header.id))
     {
-        FlexImage flex;
+        // the raw frame is needed as a whole, keep it for the next read
+        if (impl->readRaw == NULL)
+            impl->readRaw = new FlexImage;
+        FlexImage& flex = *impl->readRaw;
         flex.setPixelCode(VOCAB_PIXEL_MONO);
         flex.setQuantum(header.quantum);
 
@@ -939,17 +959,45 @@ bool Image::read(yarp::os::ConnectionReader& connection) {
         return false;
     }
 
-    // Received image has valid YARP pixels and can be converted using Image primitives
-    // prepare a FlexImage, set it to be compatible with the received image
-    // read new image into FlexImage then copy from it.
-    FlexImage flex;
-    flex.setPixelCode(header.id);
-    flex.setQuantum(header.quantum);
-    ok = readFromConnection(flex, header, connection);
-    if (ok)
-        copy(flex);
-
-    return ok;    
+    // Received image has valid YARP pixels and can be converted using Image primitives.
+    // Read a few rows at a time into a buffer kept with the image and convert them
+    // straight into place, so that no frame is allocated.
+    resize(header.width, header.height);
+    int w = header.width;
+    int h = header.height;
+    int q1 = header.quantum;
+    int q2 = getQuantum();
+    if (q1==0) { q1 = YARP_IMAGE_ALIGN; }
+    if (q2==0) { q2 = YARP_IMAGE_ALIGN; }
+    int inRowSize = header.depth*w + PAD_BYTES(header.depth*w, q1);
+    if (inRowSize*h != header.imgSize) {
+        printf("There is a problem reading an image\n");
+        printf("incoming: width %d, height %d, code %d, quantum %d, size %d\n",
+            (int)header.width, (int)header.height,
+            (int)header.id,
+            (int)header.quantum, (int)header.imgSize);
+        return false;
+    }
+
+    int rows = YARP_IMAGE_READ_CHUNK/inRowSize;
+    if (rows<1) rows = 1;
+    if (rows>h) rows = h;
+    impl->readChunk.allocateOnNeed(rows*inRowSize, rows*inRowSize);
+    unsigned char *chunk = (unsigned char *)impl->readChunk.get();
+
+    // the sender's rows are in topIsLow order, as in a default FlexImage
+    bool flip = !topIsLowIndex();
+    for (int y=0; y<h; y+=rows) {
+        int n = (h-y<rows) ? h-y : rows;
+        ok = connection.expectBlock((char *)chunk, n*inRowSize);
+        if (!ok || connection.isError())
+            return false;
+        unsigned char *dest = getRawImage() + getRowSize()*(flip ? h-y-n : y);
+        copyPixels(chunk, header.id, dest, getPixelCode(), w, n,
+                   getRowSize()*n, q1, q2, true, !flip);
+    }
+
+    return true;
 }
 
 
@@ -1073,28 +1121,6 @@ bool Image::copy(const Image& alt, int w, int h) {
         return copy(img,w,h);
     }
 
-    resize(w,h);
-    int d = getPixelSize();
-
-    int nw = w;
-    int nh = h;
-    w = alt.width();
-    h = alt.height();
-
-    float di = ((float)h)/nh;
-    float dj = ((float)w)/nw;
-
-    for (int i=0; i<nh; i++)
-        {
-            int i0 = (int)(di*i);
-            for (int j=0; j<nw; j++)
-                {
-                    int j0 = (int)(dj*j);
-                    memcpy(getPixelAddress(j,i),
-                           alt.getPixelAddress(j0,i0),
-                           d);
-                }
-        }
-    return true;
+    return resample::resize(alt, *this, w, h, resample::METHOD_NEAREST);
 }
 
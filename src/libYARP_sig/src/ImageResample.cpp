@@ -0,0 +1,507 @@
+/*
+ * Copyright (C) 2016 iCub Facility
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ */
+
+#include <yarp/sig/ImageResample.h>
+#include <yarp/os/Thread.h>
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#  include <emmintrin.h>
+#  define YARP_RESAMPLE_SSE2
+#endif
+
+using namespace yarp::sig;
+using namespace yarp::sig::resample;
+using namespace yarp::os;
+
+// below this many source pixels a single thread is always used
+#define RESAMPLE_MIN_THREADED_PIXELS (320*240)
+// fewest destination rows given to a thread
+#define RESAMPLE_MIN_BAND_ROWS 16
+
+/*
+ * The source samples that make up each destination sample along one
+ * axis: count[o] samples from first[o], weighted by
+ * weights[o*width ... o*width+count[o]-1].  For METHOD_NEAREST only
+ * first is used.
+ */
+class ResampleTaps {
+public:
+    std::vector<int> first;
+    std::vector<int> count;
+    std::vector<float> weights;
+    int width;
+
+    void compute(int method, int in, int out);
+};
+
+static double cubic(double x)
+{
+    // Catmull-Rom
+    x = fabs(x);
+    if (x<1) return (1.5*x-2.5)*x*x+1;
+    if (x<2) return ((-0.5*x+2.5)*x-4)*x+2;
+    return 0;
+}
+
+static int clampIndex(int k, int in)
+{
+    return (k<0) ? 0 : ((k>=in) ? in-1 : k);
+}
+
+void ResampleTaps::compute(int method, int in, int out)
+{
+    first.resize(out);
+    count.resize(out);
+    if (method==METHOD_NEAREST) {
+        // same sampling as Image::copy(alt,w,h)
+        float d = ((float)in)/out;
+        for (int o=0; o<out; o++) {
+            first[o] = (int)(d*o);
+            count[o] = 1;
+        }
+        width = 0;
+        weights.clear();
+        return;
+    }
+
+    double scale = ((double)in)/out;
+    double fscale = (scale>1) ? scale : 1;
+    double support = (method==METHOD_CUBIC) ? 2*fscale : 1;
+
+    // range of source samples seen by destination sample o
+    std::vector<int> kmin(out), kmax(out);
+    width = 1;
+    for (int o=0; o<out; o++) {
+        if (method==METHOD_AREA) {
+            kmin[o] = (int)floor(o*scale);
+            kmax[o] = (int)ceil((o+1)*scale)-1;
+        } else {
+            double c = (o+0.5)*scale-0.5;
+            kmin[o] = (int)floor(c)-((method==METHOD_CUBIC) ? (int)ceil(support)-1 : 0);
+            kmax[o] = (int)floor(c)+((method==METHOD_CUBIC) ? (int)ceil(support) : 1);
+        }
+        if (kmax[o]<kmin[o]) kmax[o] = kmin[o];
+        if (kmax[o]-kmin[o]+1>width) width = kmax[o]-kmin[o]+1;
+    }
+
+    weights.assign(out*width, 0.0f);
+    for (int o=0; o<out; o++) {
+        double c = (o+0.5)*scale-0.5;
+        int f = clampIndex(kmin[o], in);
+        float *w = &weights[o*width];
+        double sum = 0;
+        for (int k=kmin[o]; k<=kmax[o]; k++) {
+            double v;
+            if (method==METHOD_AREA) {
+                double a = o*scale, b = (o+1)*scale;
+                v = ((b<k+1) ? b : k+1) - ((a>k) ? a : k);
+            } else if (method==METHOD_BILINEAR) {
+                v = 1-fabs(k-c);
+            } else {
+                v = cubic((k-c)/fscale);
+            }
+            if (v<=0 && method!=METHOD_CUBIC) continue;
+            w[clampIndex(k, in)-f] += (float)v;
+            sum += v;
+        }
+        for (int t=0; t<width; t++) {
+            w[t] = (float)(w[t]/sum);
+        }
+        first[o] = f;
+        count[o] = clampIndex(kmax[o], in)-f+1;
+    }
+}
+
+
+/*
+ * Conversion of the filtered values back to the channel type.
+ */
+template <class T>
+struct ResampleChannel {
+    static T fromFloat(float v, float lo, float hi) {
+        if (v<lo) v = lo;
+        if (v>hi) v = hi;
+        return (T)(int)floor(v+0.5f);
+    }
+};
+
+template <class T>
+static void storeRow(const float *acc, T *out, int n, float lo, float hi)
+{
+    for (int i=0; i<n; i++) {
+        out[i] = ResampleChannel<T>::fromFloat(acc[i], lo, hi);
+    }
+}
+
+static void storeRow(const float *acc, float *out, int n, float, float)
+{
+    memcpy(out, acc, n*sizeof(float));
+}
+
+#ifdef YARP_RESAMPLE_SSE2
+static inline __m128i roundToByte(const float *acc)
+{
+    __m128 v = _mm_max_ps(_mm_loadu_ps(acc), _mm_setzero_ps());
+    v = _mm_min_ps(v, _mm_set1_ps(255.0f));
+    return _mm_cvttps_epi32(_mm_add_ps(v, _mm_set1_ps(0.5f)));
+}
+#endif
+
+static void storeRow(const float *acc, unsigned char *out, int n, float, float)
+{
+    int i = 0;
+#ifdef YARP_RESAMPLE_SSE2
+    // clamp to 0..255 and round half up like the scalar tail, 16 values
+    // at a time
+    for (; i+16<=n; i+=16) {
+        __m128i a = roundToByte(acc+i);
+        __m128i b = roundToByte(acc+i+4);
+        __m128i c = roundToByte(acc+i+8);
+        __m128i d = roundToByte(acc+i+12);
+        __m128i ab = _mm_packs_epi32(a, b);
+        __m128i cd = _mm_packs_epi32(c, d);
+        _mm_storeu_si128((__m128i *)(out+i), _mm_packus_epi16(ab, cd));
+    }
+#endif
+    for (; i<n; i++) {
+        float v = acc[i];
+        out[i] = (v<=0) ? 0 : ((v>=255) ? 255 : (unsigned char)(v+0.5f));
+    }
+}
+
+// acc = w*row, or acc += w*row if add
+template <class T>
+static void weightRow(float *acc, const T *row, float w, int n, bool add)
+{
+    if (add) {
+        for (int i=0; i<n; i++) acc[i] += w*(float)row[i];
+    } else {
+        for (int i=0; i<n; i++) acc[i] = w*(float)row[i];
+    }
+}
+
+static void weightRow(float *acc, const float *row, float w, int n, bool add)
+{
+    int i = 0;
+#ifdef YARP_RESAMPLE_SSE2
+    __m128 vw = _mm_set1_ps(w);
+    if (add) {
+        for (; i+4<=n; i+=4) {
+            __m128 v = _mm_mul_ps(_mm_loadu_ps(row+i), vw);
+            _mm_storeu_ps(acc+i, _mm_add_ps(_mm_loadu_ps(acc+i), v));
+        }
+    } else {
+        for (; i+4<=n; i+=4) {
+            _mm_storeu_ps(acc+i, _mm_mul_ps(_mm_loadu_ps(row+i), vw));
+        }
+    }
+#endif
+    if (add) {
+        for (; i<n; i++) acc[i] += w*row[i];
+    } else {
+        for (; i<n; i++) acc[i] = w*row[i];
+    }
+}
+
+static void weightRow(float *acc, const unsigned char *row, float w, int n, bool add)
+{
+    int i = 0;
+#ifdef YARP_RESAMPLE_SSE2
+    // widen 16 bytes to 4x4 floats
+    __m128 vw = _mm_set1_ps(w);
+    __m128i zero = _mm_setzero_si128();
+    for (; i+16<=n; i+=16) {
+        __m128i b = _mm_loadu_si128((const __m128i *)(row+i));
+        __m128i lo = _mm_unpacklo_epi8(b, zero);
+        __m128i hi = _mm_unpackhi_epi8(b, zero);
+        __m128 f[4];
+        f[0] = _mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero));
+        f[1] = _mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero));
+        f[2] = _mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero));
+        f[3] = _mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero));
+        for (int k=0; k<4; k++) {
+            __m128 v = _mm_mul_ps(f[k], vw);
+            if (add) v = _mm_add_ps(_mm_loadu_ps(acc+i+4*k), v);
+            _mm_storeu_ps(acc+i+4*k, v);
+        }
+    }
+#endif
+    if (add) {
+        for (; i<n; i++) acc[i] += w*row[i];
+    } else {
+        for (; i<n; i++) acc[i] = w*row[i];
+    }
+}
+
+// filter one row of dw pixels of C channels along x
+template <class T, int C>
+static void filterLine(const T *in, float *out, const ResampleTaps& tx, int dw)
+{
+    for (int x=0; x<dw; x++) {
+        const float *w = &tx.weights[x*tx.width];
+        const T *p = in+tx.first[x]*C;
+        float acc[C];
+        for (int c=0; c<C; c++) acc[c] = 0;
+        for (int t=0; t<tx.count[x]; t++) {
+            for (int c=0; c<C; c++) acc[c] += w[t]*(float)p[c];
+            p += C;
+        }
+        for (int c=0; c<C; c++) out[x*C+c] = acc[c];
+    }
+}
+
+/*
+ * Filter the destination rows y0..y1-1 in the cheaper order.  Along x
+ * first, each source row needed once into a float buffer then along y,
+ * pays when the image gets taller or wider; along y first, straight from
+ * the source rows, when it shrinks.
+ */
+template <class T, int C>
+static void filterRows(const Image& src, Image& dest,
+                       const ResampleTaps& tx, const ResampleTaps& ty,
+                       int y0, int y1, float lo, float hi)
+{
+    int sw = src.width();
+    int dw = dest.width();
+    int n = dw*C;
+    int r0 = ty.first[y0];
+    int r1 = r0;
+    for (int y=y0; y<y1; y++) {
+        if (ty.first[y]+ty.count[y]>r1) r1 = ty.first[y]+ty.count[y];
+    }
+
+    // rough cost of each order, filtering along x is not vectorized
+    double xFirst = (double)(r1-r0)*n*tx.width*4 + (double)(y1-y0)*n*ty.width;
+    double yFirst = (double)(y1-y0)*sw*C*ty.width + (double)(y1-y0)*n*tx.width*4;
+    std::vector<float> acc(n);
+
+    if (yFirst<xFirst) {
+        std::vector<float> column(sw*C);
+        for (int y=y0; y<y1; y++) {
+            const float *w = &ty.weights[y*ty.width];
+            for (int t=0; t<ty.count[y]; t++) {
+                weightRow(&column[0], (const T *)src.getRow(ty.first[y]+t), w[t], sw*C, t>0);
+            }
+            filterLine<float,C>(&column[0], &acc[0], tx, dw);
+            storeRow(&acc[0], (T *)dest.getRow(y), n, lo, hi);
+        }
+        return;
+    }
+
+    std::vector<float> tmp((r1-r0)*n);
+    for (int r=r0; r<r1; r++) {
+        filterLine<T,C>((const T *)src.getRow(r), &tmp[(r-r0)*n], tx, dw);
+    }
+    for (int y=y0; y<y1; y++) {
+        const float *w = &ty.weights[y*ty.width];
+        for (int t=0; t<ty.count[y]; t++) {
+            weightRow(&acc[0], &tmp[(ty.first[y]+t-r0)*n], w[t], n, t>0);
+        }
+        storeRow(&acc[0], (T *)dest.getRow(y), n, lo, hi);
+    }
+}
+
+template <int N>
+struct ResamplePixel {
+    unsigned char b[N];
+};
+
+template <int N>
+static void nearestRows(const Image& src, Image& dest,
+                        const ResampleTaps& tx, const ResampleTaps& ty,
+                        int y0, int y1)
+{
+    int dw = dest.width();
+    for (int y=y0; y<y1; y++) {
+        const ResamplePixel<N> *in = (const ResamplePixel<N> *)src.getRow(ty.first[y]);
+        ResamplePixel<N> *out = (ResamplePixel<N> *)dest.getRow(y);
+        for (int x=0; x<dw; x++) {
+            out[x] = in[tx.first[x]];
+        }
+    }
+}
+
+static void nearestRowsAny(const Image& src, Image& dest,
+                           const ResampleTaps& tx, const ResampleTaps& ty,
+                           int y0, int y1)
+{
+    int dw = dest.width();
+    int d = dest.getPixelSize();
+    for (int y=y0; y<y1; y++) {
+        const unsigned char *in = src.getRow(ty.first[y]);
+        unsigned char *out = dest.getRow(y);
+        for (int x=0; x<dw; x++) {
+            memcpy(out+x*d, in+tx.first[x]*d, d);
+        }
+    }
+}
+
+
+/*
+ * A resampling split in bands of destination rows.
+ */
+class ResampleJob {
+public:
+    const Image *src;
+    Image *dest;
+    ResampleTaps tx, ty;
+    float lo, hi;
+    void (*filter)(const Image&, Image&, const ResampleTaps&, const ResampleTaps&,
+                   int, int, float, float);
+    void (*nearest)(const Image&, Image&, const ResampleTaps&, const ResampleTaps&,
+                    int, int);
+
+    void rows(int y0, int y1) {
+        if (nearest!=NULL) {
+            nearest(*src, *dest, tx, ty, y0, y1);
+        } else {
+            filter(*src, *dest, tx, ty, y0, y1, lo, hi);
+        }
+    }
+};
+
+class ResampleBand : public Thread {
+public:
+    ResampleJob *job;
+    int y0, y1;
+
+    virtual void run() {
+        job->rows(y0, y1);
+    }
+};
+
+// choose the filter for the channels of the given pixel type
+static bool setFilter(ResampleJob& job, int code)
+{
+    job.lo = 0;
+    job.hi = 0;
+    switch (code) {
+    case VOCAB_PIXEL_MONO:
+        job.filter = filterRows<unsigned char,1>;
+        break;
+    case VOCAB_PIXEL_RGB:
+    case VOCAB_PIXEL_BGR:
+    case VOCAB_PIXEL_HSV:
+        job.filter = filterRows<unsigned char,3>;
+        break;
+    case VOCAB_PIXEL_RGBA:
+    case VOCAB_PIXEL_BGRA:
+        job.filter = filterRows<unsigned char,4>;
+        break;
+    case VOCAB_PIXEL_MONO_SIGNED:
+        job.filter = filterRows<signed char,1>;
+        job.lo = -128;
+        job.hi = 127;
+        break;
+    case VOCAB_PIXEL_RGB_SIGNED:
+        job.filter = filterRows<signed char,3>;
+        job.lo = -128;
+        job.hi = 127;
+        break;
+    case VOCAB_PIXEL_MONO16:
+        job.filter = filterRows<PixelMono16,1>;
+        job.hi = 65535;
+        break;
+    case VOCAB_PIXEL_INT:
+        job.filter = filterRows<PixelInt,1>;
+        job.lo = -2147483648.0f;
+        job.hi = 2147483520.0f;
+        break;
+    case VOCAB_PIXEL_RGB_INT:
+        job.filter = filterRows<PixelInt,3>;
+        job.lo = -2147483648.0f;
+        job.hi = 2147483520.0f;
+        break;
+    case VOCAB_PIXEL_MONO_FLOAT:
+        job.filter = filterRows<float,1>;
+        break;
+    case VOCAB_PIXEL_RGB_FLOAT:
+    case VOCAB_PIXEL_HSV_FLOAT:
+        job.filter = filterRows<float,3>;
+        break;
+    default:
+        return false;
+    }
+    return true;
+}
+
+static void setNearest(ResampleJob& job, int pixelSize)
+{
+    switch (pixelSize) {
+    case 1: job.nearest = nearestRows<1>; break;
+    case 2: job.nearest = nearestRows<2>; break;
+    case 3: job.nearest = nearestRows<3>; break;
+    case 4: job.nearest = nearestRows<4>; break;
+    case 12: job.nearest = nearestRows<12>; break;
+    default: job.nearest = nearestRowsAny; break;
+    }
+}
+
+bool yarp::sig::resample::resize(const Image& src, Image& dest,
+                                 int width, int height,
+                                 int method, int threads)
+{
+    if (width<=0 || height<=0 || src.width()<=0 || src.height()<=0) {
+        return false;
+    }
+
+    int code = src.getPixelCode();
+    if (&src==&dest || dest.getPixelCode()!=code) {
+        // work on an image of the source type, then convert
+        FlexImage tmp;
+        tmp.setPixelCode(code);
+        tmp.setPixelSize(src.getPixelSize());
+        tmp.setQuantum(src.getQuantum());
+        if (&src==&dest) {
+            FlexImage copy;
+            copy.copy(src);
+            if (!resize(copy, tmp, width, height, method, threads)) return false;
+        } else {
+            if (!resize(src, tmp, width, height, method, threads)) return false;
+        }
+        return dest.copy(tmp);
+    }
+
+    ResampleJob job;
+    job.src = &src;
+    job.dest = &dest;
+    job.filter = NULL;
+    job.nearest = NULL;
+    if (method==METHOD_NEAREST) {
+        setNearest(job, src.getPixelSize());
+    } else if (method==METHOD_AREA || method==METHOD_BILINEAR || method==METHOD_CUBIC) {
+        if (!setFilter(job, code)) return false;
+    } else {
+        return false;
+    }
+    job.tx.compute(method, src.width(), width);
+    job.ty.compute(method, src.height(), height);
+    dest.resize(width, height);
+
+    int bands = threads;
+    if (src.width()*src.height()<RESAMPLE_MIN_THREADED_PIXELS) bands = 1;
+    if (bands>height/RESAMPLE_MIN_BAND_ROWS) bands = height/RESAMPLE_MIN_BAND_ROWS;
+    if (bands<1) bands = 1;
+
+    // the calling thread takes the first band
+    ResampleBand *helpers = (bands>1) ? new ResampleBand[bands-1] : NULL;
+    for (int b=1; b<bands; b++) {
+        ResampleBand& band = helpers[b-1];
+        band.job = &job;
+        band.y0 = height*b/bands;
+        band.y1 = height*(b+1)/bands;
+        band.start();
+    }
+    job.rows(0, height/bands);
+    for (int b=1; b<bands; b++) {
+        helpers[b-1].stop();
+    }
+    delete[] helpers;
+    return true;
+}
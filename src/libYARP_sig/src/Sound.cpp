@@ -16,6 +16,13 @@
 #include <cstring>
 #include <cstdio>
 
+#include <yarp/conf/numeric.h>
+
+#if defined(YARP_LITTLE_ENDIAN) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#  include <emmintrin.h>
+#  define YARP_SOUND_SSE2
+#endif
+
 using namespace yarp::sig;
 using namespace yarp::os;
 
@@ -36,36 +43,84 @@ Sound::Sound(const Sound& alt) : yarp::os::Portable() {
 }
 
 Sound& Sound::operator += (const Sound& alt) {
+    append(alt);
+    return *this;
+}
+
+bool Sound::append(const Sound& alt) {
+    if (&alt==this) {
+        Sound copy(alt);
+        return append(copy);
+    }
+    if (samples==0 || channels==0) {
+        *this = alt;
+        return true;
+    }
     if (alt.channels!= channels)
     {
         printf ("unable to concatenate sounds with different number of channels!");
-        return *this;
+        return false;
     }
     if (alt.frequency!= frequency)
     {
         printf ("unable to concatenate sounds with different sample rate!");
-        return *this;
+        return false;
     }
 
-    int offset = this->getRawDataSize();
-    int size   = alt.getRawDataSize();
+    int newSamples = samples+alt.samples;
+    int rowBytes = samples*bytesPerSample;
 
-    Sound orig= *this;
-    this->resize(this->samples+alt.samples,channels);
+    // the samples live in a buffer owned by the sound and viewed by the
+    // image, which grows geometrically; the channels are stored one
+    // after the other, so all but the first one are moved
+    FlexImage& img = HELPER(implementation);
+    unsigned char *data = img.getRawImage();
+    if (data!=reserved || newSamples*channels*bytesPerSample>reservedBytes) {
+        reserve(newSamples>2*samples?newSamples:2*samples);
+        data = img.getRawImage();
+    }
 
-    unsigned char* p1    = orig.getRawData();
-    unsigned char* p2    = alt.getRawData();
-    unsigned char* pout  = this->getRawData();
+    for (int c=channels-1; c>0; c--) {
+        memmove(data+c*newSamples*bytesPerSample,data+c*rowBytes,rowBytes);
+    }
+    for (int c=0; c<channels; c++) {
+        memcpy(data+c*newSamples*bytesPerSample+rowBytes,
+               alt.getChannelData(c),alt.samples*bytesPerSample);
+    }
 
-    for (int i=0; i<offset; i++)
-        pout[i]=p1[i];
+    img.setExternal(data,newSamples,channels);
+    synchronize();
+    return true;
+}
 
-    int j=0;
-    for (int i=offset; i<offset+size; i++)
-        pout[i]=p2[j++];
+void Sound::reserve(int samples) {
+    // never reserve less than the sound already holds
+    if (samples<this->samples) {
+        samples = this->samples;
+    }
+    int ch = (channels>0)?channels:1;
+    int bytes = samples*ch*bytesPerSample;
+    FlexImage& img = HELPER(implementation);
+    unsigned char *data = img.getRawImage();
+    if (data==reserved && bytes<=reservedBytes) {
+        return;
+    }
 
-    this->synchronize();
-    return *this;
+    unsigned char *buf = reserved;
+    if (bytes>reservedBytes) {
+        buf = new unsigned char[bytes];
+    }
+    if (data!=NULL && data!=buf) {
+        memcpy(buf,data,this->samples*channels*bytesPerSample);
+    }
+    if (this->samples>0 && channels>0) {
+        img.setExternal(buf,this->samples,channels);
+    }
+    if (buf!=reserved) {
+        delete[] reserved;
+        reserved = buf;
+        reservedBytes = bytes;
+    }
 }
 
 const Sound& Sound::operator = (const Sound& alt) {
@@ -102,24 +157,10 @@ Sound Sound::subSound(int first_sample, int last_sample)
     s.resize(last_sample-first_sample, this->channels);
     s.setFrequency(this->frequency);
 
-    /*
-    //faster implementation but currently not working
-    unsigned char* p1    = this->getRawData();
-    unsigned char* p2    = s.getRawData();
-    int j=0;
-    for (int i=first_sample; i<last_sample*2; i++)
+    for (int c=0; c<this->channels; c++)
     {
-        p2[j++]=p1[i];
-    }
-    */
-
-    //safe implementation
-    int j=0;
-    for (int i=first_sample; i<last_sample; i++)
-    {
-        for (int c=0; c< this->channels; c++)
-            s.set(this->get(i,c),j,c);
-        j++;
+        memcpy(s.getChannelData(c),getChannelData(c)+first_sample,
+               (last_sample-first_sample)*bytesPerSample);
     }
 
     s.synchronize();
@@ -138,6 +179,8 @@ void Sound::init(int bytesPerSample) {
 
     samples = 0;
     channels = 0;
+    reserved = NULL;
+    reservedBytes = 0;
     this->bytesPerSample = bytesPerSample;
 }
 
@@ -146,6 +189,7 @@ Sound::~Sound() {
         delete &HELPER(implementation);
         implementation = NULL;
     }
+    delete[] reserved;
 }
 
 void Sound::resize(int samples, int channels) {
@@ -218,4 +262,129 @@ int Sound::getRawDataSize() const {
     return img.getRawImageSize();
 }
 
+NetInt16 *Sound::getChannelData(int channel) {
+    FlexImage& img = HELPER(implementation);
+    return (NetInt16*)img.getRow(channel);
+}
+
+const NetInt16 *Sound::getChannelData(int channel) const {
+    FlexImage& img = HELPER(implementation);
+    return (const NetInt16*)img.getRow(channel);
+}
+
+// conversion between 16 bit integers and floating point in [-1,1),
+// vectorized where SSE2 is available
 
+static inline short floatToInt16(float x) {
+    float v = x*32768.0f;
+    if (v>=32767.0f) {
+        return 32767;
+    }
+    if (v<=-32768.0f) {
+        return -32768;
+    }
+    return (short)((v>=0.0f)?(v+0.5f):(v-0.5f));
+}
+
+static void int16ToFloat(const NetInt16 *src, float *dest, int n) {
+    int i = 0;
+#ifdef YARP_SOUND_SSE2
+    const __m128 scale = _mm_set1_ps(1.0f/32768.0f);
+    for (; i+8<=n; i+=8) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(src+i));
+        // sign extension: put each sample in the high half and shift
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(x,x),16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(x,x),16);
+        _mm_storeu_ps(dest+i,_mm_mul_ps(_mm_cvtepi32_ps(lo),scale));
+        _mm_storeu_ps(dest+i+4,_mm_mul_ps(_mm_cvtepi32_ps(hi),scale));
+    }
+#endif
+    for (; i<n; i++) {
+        dest[i] = (short)src[i]/32768.0f;
+    }
+}
+
+static void floatToInt16(const float *src, NetInt16 *dest, int n) {
+    int i = 0;
+#ifdef YARP_SOUND_SSE2
+    const __m128 scale = _mm_set1_ps(32768.0f);
+    const __m128 top = _mm_set1_ps(32767.0f);
+    const __m128 bottom = _mm_set1_ps(-32768.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    for (; i+8<=n; i+=8) {
+        // clamp first, so that the conversion cannot overflow, then
+        // round half away from zero like the scalar version
+        __m128 a = _mm_mul_ps(_mm_loadu_ps(src+i),scale);
+        __m128 b = _mm_mul_ps(_mm_loadu_ps(src+i+4),scale);
+        a = _mm_max_ps(_mm_min_ps(a,top),bottom);
+        b = _mm_max_ps(_mm_min_ps(b,top),bottom);
+        a = _mm_add_ps(a,_mm_or_ps(_mm_and_ps(a,sign),half));
+        b = _mm_add_ps(b,_mm_or_ps(_mm_and_ps(b,sign),half));
+        __m128i lo = _mm_cvttps_epi32(a);
+        __m128i hi = _mm_cvttps_epi32(b);
+        _mm_storeu_si128((__m128i*)(dest+i),_mm_packs_epi32(lo,hi));
+    }
+#endif
+    for (; i<n; i++) {
+        dest[i] = floatToInt16(src[i]);
+    }
+}
+
+void Sound::getChannel(int channel, float *dest) const {
+    int16ToFloat(getChannelData(channel),dest,samples);
+}
+
+void Sound::setChannel(int channel, const float *src) {
+    floatToInt16(src,getChannelData(channel),samples);
+}
+
+void Sound::getInterleaved(short *dest) const {
+    for (int c=0; c<channels; c++) {
+        const NetInt16 *src = getChannelData(c);
+        short *out = dest+c;
+        for (int i=0; i<samples; i++, out+=channels) {
+            *out = src[i];
+        }
+    }
+}
+
+void Sound::getInterleaved(float *dest) const {
+    if (channels==1) {
+        getChannel(0,dest);
+        return;
+    }
+    for (int c=0; c<channels; c++) {
+        const NetInt16 *src = getChannelData(c);
+        float *out = dest+c;
+        for (int i=0; i<samples; i++, out+=channels) {
+            *out = (short)src[i]/32768.0f;
+        }
+    }
+}
+
+void Sound::setInterleaved(const short *src, int samples, int channels) {
+    resize(samples,channels);
+    for (int c=0; c<channels; c++) {
+        NetInt16 *out = getChannelData(c);
+        const short *in = src+c;
+        for (int i=0; i<samples; i++, in+=channels) {
+            out[i] = *in;
+        }
+    }
+}
+
+void Sound::setInterleaved(const float *src, int samples, int channels) {
+    resize(samples,channels);
+    if (channels==1) {
+        setChannel(0,src);
+        return;
+    }
+    for (int c=0; c<channels; c++) {
+        NetInt16 *out = getChannelData(c);
+        const float *in = src+c;
+        for (int i=0; i<samples; i++, in+=channels) {
+            out[i] = floatToInt16(*in);
+        }
+    }
+}
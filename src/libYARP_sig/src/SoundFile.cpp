@@ -23,6 +23,15 @@ using namespace yarp::os;
 using namespace yarp::sig;
 using namespace yarp::sig::file;
 
+// samples are moved between file and sound this many frames at a time
+static const int WAV_CHUNK_FRAMES = 4096;
+
+// bytes written by PcmWavHeader::setup_to_write, and offsets of the
+// lengths that soundStreamWriter fills in on closing
+static const int WAV_HEADER_SIZE = 44;
+static const int WAV_LENGTH_OFFSET = 4;
+static const int WAV_DATA_LENGTH_OFFSET = 40;
+
 YARP_BEGIN_PACK
 class PcmWavHeader {
 public:
@@ -50,10 +59,37 @@ public:
     NetInt32 dataLength;
 
     void setup_to_write(const Sound& sound, FILE *fp);
+    void setup_to_write(int channels, int samples, int freq, FILE *fp);
     bool parse_from_file(FILE *fp);
 };
 YARP_END_PACK
 
+// wav files store frames interleaved, the sound keeps one channel after
+// the other; both use little-endian 16 bit samples
+static void deinterleave(const NetInt16 *src, Sound& dest, int offset,
+                         int frames) {
+    int channels = dest.getChannels();
+    for (int c=0; c<channels; c++) {
+        NetInt16 *out = dest.getChannelData(c)+offset;
+        const NetInt16 *in = src+c;
+        for (int i=0; i<frames; i++, in+=channels) {
+            out[i] = *in;
+        }
+    }
+}
+
+static void interleave(const Sound& src, int offset, int frames,
+                       NetInt16 *dest) {
+    int channels = src.getChannels();
+    for (int c=0; c<channels; c++) {
+        const NetInt16 *in = src.getChannelData(c)+offset;
+        NetInt16 *out = dest+c;
+        for (int i=0; i<frames; i++, out+=channels) {
+            *out = in[i];
+        }
+    }
+}
+
 bool PcmWavHeader::parse_from_file(FILE *fp)
 {
     size_t result;
@@ -79,7 +115,7 @@ bool PcmWavHeader::parse_from_file(FILE *fp)
     //extra bytes in pcm chuck
     int extra_size = formatLength-sizeof(pcm);
     pcmExtraData.allocate(extra_size);
-    result = fread(&pcmExtraData,extra_size,1,fp);
+    result = fread(pcmExtraData.get(),extra_size,1,fp);
 
     //extra chuncks
     result = fread(&dummyHeader,sizeof(dummyHeader),1,fp);
@@ -89,7 +125,7 @@ bool PcmWavHeader::parse_from_file(FILE *fp)
         result = fread(&dummyLength,sizeof(dummyLength),1,fp);
         dummyData.clear();
         dummyData.allocate(dummyLength);
-        result = fread(&dummyData,dummyLength,1,fp);
+        result = fread(dummyData.get(),dummyLength,1,fp);
         result = fread(&dummyHeader,sizeof(dummyHeader),1,fp);
     }
 
@@ -101,21 +137,26 @@ bool PcmWavHeader::parse_from_file(FILE *fp)
 }
 
 void PcmWavHeader::setup_to_write(const Sound& src, FILE *fp)
+{
+    setup_to_write(src.getChannels(),src.getSamples(),
+                   (int)src.getFrequency(),fp);
+}
+
+void PcmWavHeader::setup_to_write(int channels, int samples, int freq, FILE *fp)
 {
     int bitsPerSample = 16;
-    int channels = src.getChannels();
-    int bytes = channels*src.getSamples()*2;
+    int bytes = channels*samples*2;
     int align = channels*((bitsPerSample+7)/8);
 
     wavHeader = VOCAB4('R','I','F','F');
-    wavLength = bytes + sizeof(PcmWavHeader) - 2*sizeof(NetInt32);
+    wavLength = bytes + WAV_HEADER_SIZE - 2*sizeof(NetInt32);
     formatHeader1 = VOCAB4('W','A','V','E');
     formatHeader2 = VOCAB4('f','m','t',' ');
     formatLength = sizeof(pcm);
 
     pcm.pcmFormatTag = 1; /* PCM! */
     pcm.pcmChannels = channels;
-    pcm.pcmSamplesPerSecond = (int)src.getFrequency();
+    pcm.pcmSamplesPerSecond = freq;
     pcm.pcmBytesPerSecond = align*pcm.pcmSamplesPerSecond;
     pcm.pcmBlockAlign = align;
     pcm.pcmBitsPerSample = bitsPerSample;
@@ -167,20 +208,20 @@ bool yarp::sig::file::read(Sound& dest, const char *src)
     int samples = header.dataLength/(bits/8)/channels;
     dest.resize(samples,channels);
     dest.setFrequency(freq);
-    ManagedBytes bytes(header.dataLength);
     printf("%d channels %d samples %d frequency\n", channels, samples, freq);
 
-    size_t result;
-    result = fread(bytes.get(),bytes.length(),1,fp);
-    YARP_UNUSED(result);
-
+    ManagedBytes bytes(WAV_CHUNK_FRAMES*channels*sizeof(NetInt16));
     NetInt16 *data = (NetInt16*)bytes.get();
-    int ct = 0;
-    for (int i=0; i<samples; i++) {
-        for (int j=0; j<channels; j++) {
-            dest.set(data[ct],i,j);
-            ct++;
+    for (int i=0; i<samples; i+=WAV_CHUNK_FRAMES) {
+        int frames = samples-i;
+        if (frames>WAV_CHUNK_FRAMES) frames = WAV_CHUNK_FRAMES;
+        size_t result = fread(data,channels*sizeof(NetInt16),frames,fp);
+        if ((int)result<frames) {
+            // truncated file, keep silence for what is missing
+            memset(data+result*channels,0,
+                   (frames-result)*channels*sizeof(NetInt16));
         }
+        deinterleave(data,dest,i,frames);
     }
 
     fclose(fp);
@@ -199,19 +240,16 @@ bool yarp::sig::file::write(const Sound& src, const char *dest)
     PcmWavHeader header;
     header.setup_to_write(src, fp);
 
-    ManagedBytes bytes(header.dataLength);
-    NetInt16 *data = (NetInt16*)bytes.get();
-    int ct = 0;
     int samples = src.getSamples();
     int channels = src.getChannels();
-    for (int i=0; i<samples; i++) {
-        for (int j=0; j<channels; j++) {
-            int v = src.get(i,j);
-            data[ct] = v;
-            ct++;
-        }
+    ManagedBytes bytes(WAV_CHUNK_FRAMES*channels*sizeof(NetInt16));
+    NetInt16 *data = (NetInt16*)bytes.get();
+    for (int i=0; i<samples; i+=WAV_CHUNK_FRAMES) {
+        int frames = samples-i;
+        if (frames>WAV_CHUNK_FRAMES) frames = WAV_CHUNK_FRAMES;
+        interleave(src,i,frames,data);
+        fwrite(data,channels*sizeof(NetInt16),frames,fp);
     }
-    fwrite(bytes.get(),bytes.length(),1,fp);
 
     fclose(fp);
     return true;
@@ -257,6 +295,7 @@ bool yarp::sig::file::soundStreamReader::close()
     }
 
     fclose(fp);
+    fp=0;
     fname[0]=0;
     index=0;
     return true;
@@ -264,28 +303,22 @@ bool yarp::sig::file::soundStreamReader::close()
 
 size_t yarp::sig::file::soundStreamReader::readBlock(Sound& dest, size_t block_size)
 {
-    int expected_bytes = block_size*(soundInfo.bits/8)*soundInfo.channels;
+    size_t expected_bytes = block_size*(soundInfo.bits/8)*soundInfo.channels;
 
     //this probably works only if soundInfo.bits=16
-    int expected_words=expected_bytes/(soundInfo.bits/8);
-    NetInt16     *data = new NetInt16 [expected_words];
+    if (buffer.length()<expected_bytes) {
+        buffer.allocate(expected_bytes);
+    }
+    NetInt16 *data = (NetInt16*)buffer.get();
 
     int bytes_read = fread(data,1,expected_bytes,fp);
     int samples_read = bytes_read/(soundInfo.bits/8)/soundInfo.channels;
 
     dest.resize(samples_read,soundInfo.channels);
     dest.setFrequency(soundInfo.freq);
-
-    int ct = 0;
-    for (int i=0; i<samples_read; i++) {
-        for (int j=0; j<soundInfo.channels; j++) {
-            dest.set(data[ct],i,j);
-            ct++;
-        }
-    }
+    deinterleave(data,dest,0,samples_read);
     index+=samples_read;
 
-    delete [] data;
     return samples_read;
 }
 
@@ -303,7 +336,7 @@ bool  yarp::sig::file::soundStreamReader::rewind(size_t sample_offset)
         return false;
     }
 
-    fseek(fp,this->soundInfo.data_start_offset+(sample_offset*this->soundInfo.channels*this->soundInfo.bits/2),SEEK_SET);
+    fseek(fp,this->soundInfo.data_start_offset+(sample_offset*this->soundInfo.channels*this->soundInfo.bits/8),SEEK_SET);
     index=sample_offset;
 
     return true;
@@ -313,3 +346,85 @@ size_t yarp::sig::file::soundStreamReader::getIndex()
 {
     return index;
 }
+
+bool yarp::sig::file::soundStreamWriter::open(const char *filename,
+                                              int freq, int channels)
+{
+    if (fp)
+    {
+        printf("a file is already open\n");
+        return false;
+    }
+    if (channels<=0)
+    {
+        printf("invalid number of channels\n");
+        return false;
+    }
+
+    fp = fopen(filename, "wb");
+    if (!fp)
+    {
+        printf("cannot open file %s for writing\n", filename);
+        return false;
+    }
+    this->freq = freq;
+    this->channels = channels;
+    samples = 0;
+
+    PcmWavHeader header;
+    header.setup_to_write(channels,0,freq,fp);
+    return true;
+}
+
+bool yarp::sig::file::soundStreamWriter::writeBlock(const Sound& src)
+{
+    if (!fp)
+    {
+        printf("no files open\n");
+        return false;
+    }
+    if (src.getSamples()==0)
+    {
+        return true;
+    }
+    if (src.getChannels()!=channels)
+    {
+        printf("unable to write a block with %d channels in a file with %d\n",
+               src.getChannels(), channels);
+        return false;
+    }
+
+    int frames = src.getSamples();
+    size_t bytes = frames*channels*sizeof(NetInt16);
+    if (buffer.length()<bytes) {
+        buffer.allocate(bytes);
+    }
+    NetInt16 *data = (NetInt16*)buffer.get();
+    interleave(src,0,frames,data);
+    size_t result = fwrite(data,channels*sizeof(NetInt16),frames,fp);
+    samples += result;
+    return (int)result==frames;
+}
+
+bool yarp::sig::file::soundStreamWriter::close()
+{
+    if (!fp)
+    {
+        printf("no files open\n");
+        return false;
+    }
+
+    NetInt32 dataLength = (int)(samples*channels*sizeof(NetInt16));
+    NetInt32 wavLength = dataLength + WAV_HEADER_SIZE - 2*sizeof(NetInt32);
+    size_t result;
+    fseek(fp,WAV_LENGTH_OFFSET,SEEK_SET);
+    result = fwrite(&wavLength,sizeof(wavLength),1,fp);
+    fseek(fp,WAV_DATA_LENGTH_OFFSET,SEEK_SET);
+    result = fwrite(&dataLength,sizeof(dataLength),1,fp);
+    YARP_UNUSED(result);
+
+    fclose(fp);
+    fp = 0;
+    samples = 0;
+    return true;
+}
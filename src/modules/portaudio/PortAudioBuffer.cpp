@@ -9,14 +9,15 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <portaudio.h>
 
 
 circularBuffer::circularBuffer(int bufferSize)
 {
     maxsize  = bufferSize + 1; 
-    start = 0;
-    end   = 0;
+    start.set(0);
+    end.set(0);
     elems = (SAMPLE *) calloc(maxsize, sizeof(SAMPLE));
 }
 
@@ -25,4 +26,90 @@ circularBuffer::~circularBuffer()
     free(elems);
 }
 
+int circularBuffer::write(const SAMPLE *data, int count)
+{
+    int e = end.get();
+    int n = freeSpace();
+    if (n > count) n = count;
+
+    // at most two copies, before and after the wrap
+    int first = maxsize - e;
+    if (first > n) first = n;
+    memcpy(elems + e, data, first * sizeof(SAMPLE));
+    memcpy(elems, data + first, (n - first) * sizeof(SAMPLE));
+    end.set((e + n) % maxsize);
+
+    if (n < count) addOverruns(count - n);
+    return n;
+}
+
+int circularBuffer::writeSilence(int count)
+{
+    int e = end.get();
+    int n = freeSpace();
+    if (n > count) n = count;
+
+    for (int i = 0; i < n; i++)
+    {
+        elems[e] = SAMPLE_SILENCE;
+        if (++e == maxsize) e = 0;
+    }
+    end.set(e);
+
+    if (n < count) addOverruns(count - n);
+    return n;
+}
+
+int circularBuffer::writeInterleaving(const SAMPLE *const *channels, int frames, int numChannels)
+{
+    int e = end.get();
+    int n = freeSpace() / numChannels;
+    if (n > frames) n = frames;
+
+    for (int f = 0; f < n; f++)
+    {
+        for (int c = 0; c < numChannels; c++)
+        {
+            elems[e] = channels[c][f];
+            if (++e == maxsize) e = 0;
+        }
+    }
+    end.set(e);
 
+    if (n < frames) addOverruns((frames - n) * numChannels);
+    return n;
+}
+
+int circularBuffer::read(SAMPLE *data, int count)
+{
+    int s = start.get();
+    int n = size();
+    if (n > count) n = count;
+
+    int first = maxsize - s;
+    if (first > n) first = n;
+    memcpy(data, elems + s, first * sizeof(SAMPLE));
+    memcpy(data + first, elems, (n - first) * sizeof(SAMPLE));
+    start.set((s + n) % maxsize);
+
+    return n;
+}
+
+int circularBuffer::readDeinterleaving(SAMPLE *const *channels, int frames, int numChannels)
+{
+    int s = start.get();
+    int n = size() / numChannels;
+    if (n > frames) n = frames;
+
+    for (int f = 0; f < n; f++)
+    {
+        for (int c = 0; c < numChannels; c++)
+        {
+            channels[c][f] = elems[s];
+            if (++s == maxsize) s = 0;
+        }
+    }
+    start.set(s);
+
+    return n;
+}
@@ -11,6 +11,8 @@
 #include <portaudio.h>
 #include <stdio.h>
 
+#include <yarp/os/impl/AtomicCounter.h>
+
 /* Select sample format. */
 #if 0
 #define PA_SAMPLE_TYPE  paFloat32
@@ -32,19 +34,38 @@ typedef unsigned char SAMPLE;
 #endif
 
 //----------------------------------------------------------------------------------
+/**
+ * Single-producer/single-consumer ring of interleaved samples.
+ *
+ * The producer only moves \e end and the consumer only moves \e start,
+ * so the PortAudio callback and the grabber/render thread can share the
+ * buffer without locks. Blocks are transferred with at most two memcpy
+ * (the ring wraps at most once); the (de)interleaving variants convert
+ * to and from one array per channel on the fly.
+ *
+ * Samples that do not fit are dropped and counted as overruns by the
+ * producer; samples that the consumer had to replace with silence are
+ * counted as underruns. Each counter has a single writer.
+ */
 class circularBuffer
 {
     int         maxsize;
-    int         start;
-    int         end;
     SAMPLE      *elems;
+    yarp::os::impl::AtomicCounter start;
+    yarp::os::impl::AtomicCounter end;
+    yarp::os::impl::AtomicCounter overruns;
+    yarp::os::impl::AtomicCounter underruns;
+
+    // disable copy
+    circularBuffer(const circularBuffer&);
+    circularBuffer& operator=(const circularBuffer&);
 
     public:
     inline bool isFull()
     {
-        return (end + 1) % maxsize == start;
+        return (end.get() + 1) % maxsize == start.get();
     }
- 
+
     inline const SAMPLE* getRawData()
     {
         return elems;
@@ -52,54 +73,69 @@ class circularBuffer
 
     inline bool isEmpty()
     {
-        return end == start;
+        return end.get() == start.get();
     }
 
-    inline void write(SAMPLE elem)
-    {
-        elems[end] = elem;
-        end = (end + 1) % maxsize;
-        if (end == start)
-        {
-            printf ("ERROR: buffer ovverrun!\n");
-            start = (start + 1) % maxsize; // full, overwrite 
-        }
-    }
- 
     inline int size()
     {
-        int i;
-        if (end>start)
-            i = end-start;
-        else if (end==start)
-            i = 0;
-        else          
-            i = maxsize - start + end;
-        return i;
+        return (end.get() - start.get() + maxsize) % maxsize;
     }
 
-    inline SAMPLE read()
+    inline int freeSpace()
     {
-        if (end == start)
-        {
-            printf ("ERROR: buffer underrun!\n");
-        }
-        SAMPLE elem = elems[start];
-        start = (start + 1) % maxsize;
-        return elem;
+        return maxsize - 1 - size();
     }
- 
+
     inline unsigned int getMaxSize()
     {
-        return maxsize;
+        return maxsize - 1;
     }
 
+    /**
+     * Discard the content of the buffer. It must not run concurrently
+     * with read(), e.g. the stream must be stopped.
+     */
     inline void clear()
     {
-        start = 0;
-        end   = 0;
+        start.set(end.get());
     }
 
+    inline int getOverruns()      { return overruns.get();  }
+    inline int getUnderruns()     { return underruns.get(); }
+    inline void addOverruns(int n)  { overruns.set(overruns.get() + n);   }
+    inline void addUnderruns(int n) { underruns.set(underruns.get() + n); }
+
+    /**
+     * Producer: append up to \e count interleaved samples.
+     * @return the number of samples written, the others are overruns
+     */
+    int write(const SAMPLE *data, int count);
+
+    /**
+     * Producer: append \e count silent samples.
+     */
+    int writeSilence(int count);
+
+    /**
+     * Producer: append \e frames frames taking channel \e c from
+     * channels[c]; only whole frames are written.
+     * @return the number of frames written
+     */
+    int writeInterleaving(const SAMPLE *const *channels, int frames, int numChannels);
+
+    /**
+     * Consumer: take up to \e count interleaved samples.
+     * @return the number of samples read
+     */
+    int read(SAMPLE *data, int count);
+
+    /**
+     * Consumer: take up to \e frames frames storing channel \e c in
+     * channels[c]; only whole frames are read.
+     * @return the number of frames read
+     */
+    int readDeinterleaving(SAMPLE *const *channels, int frames, int numChannels);
+
     circularBuffer(int bufferSize);
     ~circularBuffer();
 
@@ -34,83 +34,47 @@ static int bufferIOCallback( const void *inputBuffer, void *outputBuffer,
     int num_channels         = dataBuffers->numChannels;
     int finished = paComplete;
 
+    (void) timeInfo; // just to prevent unused variable warnings
+    (void) statusFlags;
+
     if (dataBuffers->canRec)
     {
-        const SAMPLE *rptr = (const SAMPLE*)inputBuffer;
-        unsigned int framesToCalc;
-        unsigned int i;
-        unsigned long framesLeft = recdata->getMaxSize()-recdata->size();
-
-        (void) outputBuffer; // just to prevent unused variable warnings
-        (void) timeInfo;
-        (void) statusFlags;
-        (void) userData;
+        int count = (int)framesPerBuffer * num_channels;
 
-        if( framesLeft/num_channels < framesPerBuffer )
+        // only whole frames are stored, whatever does not fit is
+        // dropped and counted as overrun
+        int fit = recdata->freeSpace() / num_channels * num_channels;
+        if( fit < count )
         {
-            framesToCalc = framesLeft/num_channels;
-            finished = paComplete;
-        }
-        else
-        {
-            framesToCalc = framesPerBuffer;
-            finished = paContinue;
+            recdata->addOverruns(count - fit);
+            count = fit;
         }
 
         if( inputBuffer == NULL )
-        {
-            for( i=0; i<framesToCalc; i++ )
-            {
-                recdata->write(0); // left
-                if( num_channels == 2 ) recdata->write(0);  // right
-            }
-        }
+            recdata->writeSilence(count);
         else
-        {
-            for( i=0; i<framesToCalc; i++ )
-            {
-                recdata->write(*rptr++);  // left
-                if( num_channels == 2 ) recdata->write(*rptr++);  // right
-            }
-        }
+            recdata->write((const SAMPLE*)inputBuffer, count);
+
         //note: you can record or play but not simultaneously (for now)
-        return finished;
+        return paContinue;
     }
 
     if (dataBuffers->canPlay)
     {
         SAMPLE *wptr = (SAMPLE*)outputBuffer;
-        unsigned int i;
-
-        unsigned int framesLeft = playdata->size();
+        int count = (int)framesPerBuffer * num_channels;
+        int got = playdata->read(wptr, count);
 
-        (void) inputBuffer; // just to prevent unused variable warnings
-        (void) timeInfo;
-        (void) statusFlags;
-        (void) userData;
-
-        if( framesLeft/num_channels < framesPerBuffer )
+        if( got < count )
         {
             // final buffer
-            for( i=0; i<framesLeft/num_channels; i++ )
-            {
-                *wptr++ = playdata->read();  // left 
-                if( num_channels == 2 ) *wptr++ = playdata->read();  // right 
-            }
-            for( ; i<framesPerBuffer; i++ )
-            {
-                *wptr++ = 0;  // left 
-                if( num_channels == 2 ) *wptr++ = 0;  // right 
-            }
+            for( int i=got; i<count; i++ )
+                wptr[i] = SAMPLE_SILENCE;
+            playdata->addUnderruns(count - got);
             finished = paComplete;
         }
         else
         {
-            for( i=0; i<framesPerBuffer; i++ )
-            {
-                *wptr++ = playdata->read();  // left 
-                if( num_channels == 2 ) *wptr++ = playdata->read();  // right 
-            }
             finished = paContinue;
         }
         //note: you can record or play but not simultaneously (for now)
@@ -145,7 +109,7 @@ bool PortAudioDeviceDriver::open(yarp::os::Searchable& config)
 {
     driverConfig.rate = config.check("rate",Value(0),"audio sample rate (0=automatic)").asInt();
     driverConfig.samples = config.check("samples",Value(0),"number of samples per network packet (0=automatic)").asInt();
-    driverConfig.channels = config.check("channels",Value(0),"number of audio channels (0=automatic, max is 2)").asInt();
+    driverConfig.channels = config.check("channels",Value(0),"number of audio channels (0=automatic)").asInt();
     driverConfig.wantRead = (bool)config.check("read","if present, just deal with reading audio (microphone)");
     driverConfig.wantWrite = (bool)config.check("write","if present, just deal with writing audio (speaker)");
     driverConfig.deviceNumber = config.check("id",Value(-1),"which portaudio index to use (-1=automatic)").asInt();
@@ -190,7 +154,7 @@ bool PortAudioDeviceDriver::open(PortAudioDeviceDriverSettings& config)
 
     //buffer.allocate(num_samples*num_channels*sizeof(SAMPLE));
     numBytes = numSamples * sizeof(SAMPLE);
-    int twiceTheBuffer = numBytes * 2;
+    int twiceTheBuffer = numSamples * numChannels * 2;
     dataBuffers.numChannels=numChannels;
     if (dataBuffers.playData==0)
         dataBuffers.playData = new circularBuffer(twiceTheBuffer);
@@ -329,18 +293,66 @@ bool PortAudioDeviceDriver::getSound(yarp::sig::Sound& sound)
     }
     buff_size_wdt = 0;
 
-    if (sound.getChannels()!=this->numChannels && sound.getSamples() != this->numSamples)
+    if (sound.getChannels()!=this->numChannels || sound.getSamples() != this->numSamples)
     {
         sound.resize(this->numSamples,this->numChannels);
     }
     sound.setFrequency(this->driverConfig.rate);
 
-    for (int i=0; i<this->numSamples; i++)
+    // the samples of a Sound are stored channel by channel, so the
+    // interleaved frames are split straight into its memory
+    int got = 0;
+#if defined(YARP_LITTLE_ENDIAN)
+    if (sound.getBytesPerSample()==sizeof(SAMPLE))
+    {
+        SAMPLE *raw = (SAMPLE*)sound.getRawData();
+        channelPointers.resize(this->numChannels);
+        for (int j=0; j<this->numChannels; j++)
+            channelPointers[j] = raw + j*this->numSamples;
+
+        got = dataBuffers.recData->readDeinterleaving(&channelPointers[0], this->numSamples, this->numChannels);
         for (int j=0; j<this->numChannels; j++)
-            {
-                SAMPLE s = dataBuffers.recData->read();
-                sound.set(s,i,j);
-            }
+            for (int i=got; i<this->numSamples; i++)
+                channelPointers[j][i] = SAMPLE_SILENCE;
+    }
+    else
+#endif
+    {
+        frameBuffer.resize(this->numChannels);
+        for (int i=0; i<this->numSamples; i++)
+        {
+            bool ok = (dataBuffers.recData->read(&frameBuffer[0], this->numChannels) == this->numChannels);
+            got += ok?1:0;
+            for (int j=0; j<this->numChannels; j++)
+                sound.set(ok?frameBuffer[j]:SAMPLE_SILENCE,i,j);
+        }
+    }
+
+    if (got < this->numSamples)
+    {
+        printf ("ERROR: buffer underrun!\n");
+        dataBuffers.recData->addUnderruns((this->numSamples - got) * this->numChannels);
+    }
+    return true;
+}
+
+bool PortAudioDeviceDriver::getRecordingCounters(int& overruns, int& underruns)
+{
+    if (dataBuffers.recData == 0)
+        return false;
+
+    overruns = dataBuffers.recData->getOverruns();
+    underruns = dataBuffers.recData->getUnderruns();
+    return true;
+}
+
+bool PortAudioDeviceDriver::getRenderingCounters(int& overruns, int& underruns)
+{
+    if (dataBuffers.playData == 0)
+        return false;
+
+    overruns = dataBuffers.playData->getOverruns();
+    underruns = dataBuffers.playData->getUnderruns();
     return true;
 }
 
@@ -414,9 +426,7 @@ bool PortAudioDeviceDriver::immediateSound(yarp::sig::Sound& sound)
     int num_samples = sound.getRawDataSize()/num_channels/num_bytes;
     // memcpy(data.samplesBuffer,dataP,num_samples/**num_bytes*num_channels*/);
     
-    for (int i=0; i<num_samples; i++)
-        for (int j=0; j<num_channels; j++)
-            dataBuffers.playData->write (sound.get(i,j));
+    writeSound(sound, num_samples, num_channels);
 
     pThread.something_to_play = true;
     return true;
@@ -464,12 +474,37 @@ bool PortAudioDeviceDriver::appendSound(yarp::sig::Sound& sound)
     int num_samples = sound.getRawDataSize()/num_channels/num_bytes;
     // memcpy(data.samplesBuffer,dataP,num_samples/**num_bytes*num_channels*/);
     
-    for (int i=0; i<num_samples; i++)
-        for (int j=0; j<num_channels; j++)
-            dataBuffers.playData->write (sound.get(i,j));
+    writeSound(sound, num_samples, num_channels);
 
     pThread.something_to_play = true;
     return true;
 }
 
+void PortAudioDeviceDriver::writeSound(yarp::sig::Sound& sound, int num_samples, int num_channels)
+{
+    // whatever does not fit in the buffer is dropped and counted as overrun
+#if defined(YARP_LITTLE_ENDIAN)
+    if (sound.getBytesPerSample()==sizeof(SAMPLE))
+    {
+        const SAMPLE *raw = (const SAMPLE*)sound.getRawData();
+        constChannelPointers.resize(num_channels);
+        for (int j=0; j<num_channels; j++)
+            constChannelPointers[j] = raw + j*num_samples;
 
+        dataBuffers.playData->writeInterleaving(&constChannelPointers[0], num_samples, num_channels);
+        return;
+    }
+#endif
+    frameBuffer.resize(num_channels);
+    for (int i=0; i<num_samples; i++)
+    {
+        if (dataBuffers.playData->freeSpace() < num_channels)
+        {
+            dataBuffers.playData->addOverruns((num_samples - i) * num_channels);
+            break;
+        }
+        for (int j=0; j<num_channels; j++)
+            frameBuffer[j] = (SAMPLE)sound.get(i,j);
+        dataBuffers.playData->write(&frameBuffer[0], num_channels);
+    }
+}
@@ -8,6 +8,9 @@
 #ifndef PortAudioDeviceDriverh
 #define PortAudioDeviceDriverh
 
+#include <vector>
+
+#include <yarp/conf/numeric.h>
 #include <yarp/os/ManagedBytes.h>
 #include <yarp/os/Thread.h>
 
@@ -68,6 +71,11 @@ private:
     int                 numBytes;
     streamThread        pThread;
 
+    // scratch storage reused by getSound() and renderSound()
+    std::vector<SAMPLE*>       channelPointers;
+    std::vector<const SAMPLE*> constChannelPointers;
+    std::vector<SAMPLE>        frameBuffer;
+
     PortAudioDeviceDriver(const PortAudioDeviceDriver&);
     void operator=(const PortAudioDeviceDriver&);
 
@@ -102,6 +110,8 @@ public:
     virtual bool renderSound(yarp::sig::Sound& sound);
     virtual bool startRecording();
     virtual bool stopRecording();
+    virtual bool getRecordingCounters(int& overruns, int& underruns);
+    virtual bool getRenderingCounters(int& overruns, int& underruns);
     
     bool abortSound(void);
     bool immediateSound(yarp::sig::Sound& sound);
@@ -116,6 +126,7 @@ protected:
     PortAudioDeviceDriverSettings driverConfig;
     enum {RENDER_APPEND=0, RENDER_IMMEDIATE=1} renderMode;
     void handleError(void);
+    void writeSound(yarp::sig::Sound& sound, int num_samples, int num_channels);
 };
 
 
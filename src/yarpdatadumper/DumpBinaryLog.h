@@ -0,0 +1,389 @@
+/*
+ * Copyright (C) 2016 iCub Facility - Istituto Italiano di Tecnologia
+ * CopyPolicy: Released under the terms of the GPLv2 or later, see GPL.TXT
+ */
+
+#ifndef DUMPBINARYLOG_H
+#define DUMPBINARYLOG_H
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <algorithm>
+
+#include <yarp/os/Bytes.h>
+#include <yarp/os/InputStream.h>
+#include <yarp/os/OutputStream.h>
+#include <yarp/os/ConnectionReader.h>
+#include <yarp/os/ConnectionWriter.h>
+#include <yarp/os/PortReader.h>
+#include <yarp/os/PortWriter.h>
+#include <yarp/os/NetInt32.h>
+#include <yarp/os/NetInt64.h>
+#include <yarp/os/NetFloat64.h>
+
+
+/**
+ * Binary recording format shared by yarpdatadumper (writer) and
+ * yarpdataplayer (reader). All numbers are little-endian, as on the
+ * YARP wire.
+ *
+ * \code
+ * header  : "YARPDUMP" | int32 version | int32 type
+ * chunk   : int32 seqNumber | int32 flags | float64 txStamp | float64 rxStamp
+ *           | int32 length | <length bytes of payload>
+ * index   : int32 count | count x (float64 stamp | int64 chunkOffset)
+ * trailer : int64 indexOffset | "YARPIDX1"
+ * \endcode
+ *
+ * The payload is the YARP binary wire data of a Bottle (type 0) or of
+ * an Image (type 1), or a compressed image as described in
+ * DumpImageCodec.h (type 2).
+ *
+ * The flags tell which stamps are valid (bit 0: tx, bit 1: rx). The
+ * index is appended when the recording is closed; if it is missing
+ * (e.g. the dumper was killed) the reader rebuilds it by scanning the
+ * chunks.
+ */
+#define DUMP_BINARY_MAGIC           "YARPDUMP"
+#define DUMP_BINARY_INDEX_MAGIC     "YARPIDX1"
+#define DUMP_BINARY_MAGIC_LEN       8
+#define DUMP_BINARY_VERSION         1
+#define DUMP_BINARY_HEADER_LEN      (DUMP_BINARY_MAGIC_LEN+2*4)
+#define DUMP_BINARY_CHUNK_LEN       (4+4+8+8+4)
+#define DUMP_BINARY_TRAILER_LEN     (8+DUMP_BINARY_MAGIC_LEN)
+#define DUMP_BINARY_TYPE_BOTTLE     0
+#define DUMP_BINARY_TYPE_IMAGE      1
+#define DUMP_BINARY_TYPE_PACKED     2
+#define DUMP_BINARY_TX_VALID        1
+#define DUMP_BINARY_RX_VALID        2
+
+
+// InputStream reading from a memory region (e.g. a mapped file)
+/**************************************************************************/
+class DumpMemoryInputStream : public yarp::os::InputStream
+{
+private:
+    const char *data;
+    size_t      len;
+    size_t      at;
+
+public:
+    using yarp::os::InputStream::read;
+
+    DumpMemoryInputStream(const char *_data, size_t _len) :
+                          data(_data), len(_len), at(0) { }
+
+    YARP_SSIZE_T read(const yarp::os::Bytes &b)
+    {
+        size_t n=std::min(b.length(),len-at);
+        memcpy(b.get(),data+at,n);
+        at+=n;
+        return (n>0)||(b.length()==0)?(YARP_SSIZE_T)n:-1;
+    }
+
+    void close()  { at=len;      }
+    bool isOk()   { return true; }
+};
+
+
+// OutputStream appending to a reusable buffer
+/**************************************************************************/
+class DumpBufferOutputStream : public yarp::os::OutputStream
+{
+private:
+    std::vector<char> buf;
+
+public:
+    using yarp::os::OutputStream::write;
+
+    void reset()             { buf.clear();      }
+    const char *get() const  { return buf.empty()?NULL:&buf[0]; }
+    size_t length() const    { return buf.size(); }
+
+    void write(const yarp::os::Bytes &b)
+    {
+        buf.insert(buf.end(),b.get(),b.get()+b.length());
+    }
+
+    void close()  { }
+    bool isOk()   { return true; }
+};
+
+
+// Writer of the binary recording format
+/**************************************************************************/
+class DumpBinaryWriter
+{
+private:
+    std::ofstream          fdata;
+    DumpBufferOutputStream payload;
+    std::vector<double>    stamps;
+    std::vector<long long> offsets;
+    long long              at;
+
+    template <class T>
+    void put(const T &x)
+    {
+        fdata.write((const char*)&x,sizeof(x));
+        at+=sizeof(x);
+    }
+
+public:
+    DumpBinaryWriter() : at(0) { }
+    ~DumpBinaryWriter() { close(); }
+
+    bool open(const std::string &fileName, int type)
+    {
+        fdata.open(fileName.c_str(),std::ios::out|std::ios::binary|std::ios::trunc);
+        if (!fdata.is_open())
+            return false;
+
+        at=0;
+        stamps.clear();
+        offsets.clear();
+
+        fdata.write(DUMP_BINARY_MAGIC,DUMP_BINARY_MAGIC_LEN);
+        at+=DUMP_BINARY_MAGIC_LEN;
+        put(yarp::os::NetInt32(DUMP_BINARY_VERSION));
+        put(yarp::os::NetInt32(type));
+        return fdata.good();
+    }
+
+    bool isOpen() { return fdata.is_open(); }
+
+    /**
+     * Use \e buffer for the file stream; it must be called before
+     * open() and the buffer must outlive the writer.
+     */
+    void setBuffer(char *buffer, size_t size)
+    {
+        fdata.rdbuf()->pubsetbuf(buffer,size);
+    }
+
+    void flush() { fdata.flush(); }
+
+    /**
+     * Append one item; \e stamp is the reference time used for the
+     * index, txStamp/rxStamp are stored only if flagged as valid.
+     */
+    bool write(int seqNumber, int flags, double txStamp, double rxStamp,
+               double stamp, yarp::os::PortWriter &obj)
+    {
+        payload.reset();
+        if (!yarp::os::ConnectionWriter::writeToStream(obj,payload))
+            return false;
+
+        return writeRaw(seqNumber,flags,txStamp,rxStamp,stamp,
+                        payload.get(),payload.length());
+    }
+
+    /**
+     * Append one item whose payload has already been encoded.
+     */
+    bool writeRaw(int seqNumber, int flags, double txStamp, double rxStamp,
+                  double stamp, const char *data, size_t length)
+    {
+        stamps.push_back(stamp);
+        offsets.push_back(at);
+
+        put(yarp::os::NetInt32(seqNumber));
+        put(yarp::os::NetInt32(flags));
+        put(yarp::os::NetFloat64(txStamp));
+        put(yarp::os::NetFloat64(rxStamp));
+        put(yarp::os::NetInt32((int)length));
+        if (length>0)
+        {
+            fdata.write(data,length);
+            at+=length;
+        }
+
+        return fdata.good();
+    }
+
+    void close()
+    {
+        if (!fdata.is_open())
+            return;
+
+        long long indexOffset=at;
+        put(yarp::os::NetInt32((int)stamps.size()));
+        for (size_t i=0; i<stamps.size(); i++)
+        {
+            put(yarp::os::NetFloat64(stamps[i]));
+            put(yarp::os::NetInt64(offsets[i]));
+        }
+        put(yarp::os::NetInt64(indexOffset));
+        fdata.write(DUMP_BINARY_INDEX_MAGIC,DUMP_BINARY_MAGIC_LEN);
+        fdata.close();
+    }
+};
+
+
+// Reader of the binary recording format working on a memory region,
+// typically a memory-mapped file: frames are decoded only on request
+/**************************************************************************/
+class DumpBinaryReader
+{
+private:
+    const char            *base;
+    size_t                 len;
+    int                    type;
+    std::vector<double>    stamps;
+    std::vector<long long> offsets;
+
+    template <class T>
+    T get(size_t offset) const
+    {
+        T x;
+        memcpy(&x,base+offset,sizeof(x));
+        return x;
+    }
+
+    bool loadIndex()
+    {
+        if (len<DUMP_BINARY_HEADER_LEN+DUMP_BINARY_TRAILER_LEN)
+            return false;
+
+        size_t trailer=len-DUMP_BINARY_TRAILER_LEN;
+        if (memcmp(base+trailer+8,DUMP_BINARY_INDEX_MAGIC,DUMP_BINARY_MAGIC_LEN)!=0)
+            return false;
+
+        long long indexOffset=get<yarp::os::NetInt64>(trailer);
+        if ((indexOffset<DUMP_BINARY_HEADER_LEN) || ((size_t)indexOffset+4>trailer))
+            return false;
+
+        int count=get<yarp::os::NetInt32>((size_t)indexOffset);
+        if ((count<0) || ((size_t)indexOffset+4+(size_t)count*16!=trailer))
+            return false;
+
+        stamps.resize(count);
+        offsets.resize(count);
+        for (int i=0; i<count; i++)
+        {
+            size_t entry=(size_t)indexOffset+4+i*16;
+            stamps[i]=get<yarp::os::NetFloat64>(entry);
+            offsets[i]=get<yarp::os::NetInt64>(entry+8);
+        }
+        return true;
+    }
+
+    void scanChunks()
+    {
+        stamps.clear();
+        offsets.clear();
+
+        size_t at=DUMP_BINARY_HEADER_LEN;
+        while (at+DUMP_BINARY_CHUNK_LEN<=len)
+        {
+            int flags=get<yarp::os::NetInt32>(at+4);
+            double txStamp=get<yarp::os::NetFloat64>(at+8);
+            double rxStamp=get<yarp::os::NetFloat64>(at+16);
+            int length=get<yarp::os::NetInt32>(at+24);
+            if ((length<0) || (at+DUMP_BINARY_CHUNK_LEN+length>len))
+                break;
+
+            stamps.push_back((flags&DUMP_BINARY_TX_VALID)?txStamp:rxStamp);
+            offsets.push_back(at);
+            at+=DUMP_BINARY_CHUNK_LEN+length;
+        }
+    }
+
+public:
+    DumpBinaryReader() : base(NULL), len(0), type(-1) { }
+
+    /**
+     * Attach the reader to the content of a recording.
+     * @return false if the content is not a binary recording
+     */
+    bool attach(const char *_base, size_t _len)
+    {
+        base=_base;
+        len=_len;
+        stamps.clear();
+        offsets.clear();
+
+        if ((base==NULL) || (len<DUMP_BINARY_HEADER_LEN) ||
+            (memcmp(base,DUMP_BINARY_MAGIC,DUMP_BINARY_MAGIC_LEN)!=0) ||
+            (get<yarp::os::NetInt32>(DUMP_BINARY_MAGIC_LEN)!=DUMP_BINARY_VERSION))
+        {
+            base=NULL;
+            len=0;
+            return false;
+        }
+
+        type=get<yarp::os::NetInt32>(DUMP_BINARY_MAGIC_LEN+4);
+        if (!loadIndex())
+            scanChunks();
+
+        return true;
+    }
+
+    static bool isBinaryLog(const char *_base, size_t _len)
+    {
+        return (_base!=NULL) && (_len>=DUMP_BINARY_MAGIC_LEN) &&
+               (memcmp(_base,DUMP_BINARY_MAGIC,DUMP_BINARY_MAGIC_LEN)==0);
+    }
+
+    int getType() const   { return type; }
+    int size() const      { return (int)stamps.size(); }
+
+    const std::vector<double> &getStamps() const { return stamps; }
+
+    double getStamp(int i) const { return stamps[i]; }
+
+    int getSeqNumber(int i) const
+    {
+        return get<yarp::os::NetInt32>((size_t)offsets[i]);
+    }
+
+    double getTxStamp(int i) const
+    {
+        return get<yarp::os::NetFloat64>((size_t)offsets[i]+8);
+    }
+
+    double getRxStamp(int i) const
+    {
+        return get<yarp::os::NetFloat64>((size_t)offsets[i]+16);
+    }
+
+    /**
+     * @return the index of the first frame whose stamp is not less
+     * than \e t (binary search on the time index)
+     */
+    int findFrame(double t) const
+    {
+        return (int)(std::lower_bound(stamps.begin(),stamps.end(),t)-stamps.begin());
+    }
+
+    /**
+     * Access the payload of the i-th frame without decoding it.
+     */
+    bool getPayload(int i, const char *&data, size_t &length) const
+    {
+        if ((i<0) || (i>=size()))
+            return false;
+
+        size_t at=(size_t)offsets[i];
+        length=(size_t)get<yarp::os::NetInt32>(at+24);
+        data=base+at+DUMP_BINARY_CHUNK_LEN;
+        return true;
+    }
+
+    /**
+     * Decode the i-th frame straight from the recording into \e obj.
+     */
+    bool readFrame(int i, yarp::os::PortReader &obj) const
+    {
+        const char *data;
+        size_t length;
+        if ((type==DUMP_BINARY_TYPE_PACKED) || !getPayload(i,data,length))
+            return false;
+
+        DumpMemoryInputStream is(data,length);
+        return yarp::os::ConnectionReader::readFromStream(obj,is);
+    }
+};
+
+#endif
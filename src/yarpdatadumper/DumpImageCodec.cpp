@@ -0,0 +1,469 @@
+/*
+ * Copyright (C) 2016 iCub Facility - Istituto Italiano di Tecnologia
+ * CopyPolicy: Released under the terms of the GPLv2 or later, see GPL.TXT
+ */
+
+#include <cstdio>
+#include <cstring>
+
+#ifdef DUMP_HAS_JPEG
+    #include <setjmp.h>
+    extern "C" {
+    #include <jpeglib.h>
+    }
+#endif
+
+#ifdef DUMP_HAS_ZLIB
+    #include <zlib.h>
+#endif
+
+#include <yarp/os/NetInt32.h>
+#include <yarp/os/Log.h>
+#include <yarp/sig/IplImage.h>
+
+#include "DumpImageCodec.h"
+
+using namespace std;
+using namespace yarp::os;
+using namespace yarp::sig;
+
+
+namespace
+{
+
+/**************************************************************************/
+void putInt(vector<char> &out, size_t at, int x)
+{
+    NetInt32 v=x;
+    memcpy(&out[at],&v,sizeof(v));
+}
+
+
+/**************************************************************************/
+int getInt(const char *data, size_t at)
+{
+    NetInt32 v;
+    memcpy(&v,data+at,sizeof(v));
+    return v;
+}
+
+
+/**************************************************************************/
+bool isJpegCompatible(int code)
+{
+    return (code==VOCAB_PIXEL_MONO) || (code==VOCAB_PIXEL_RGB) ||
+           (code==VOCAB_PIXEL_BGR);
+}
+
+
+/**************************************************************************/
+int losslessCodec()
+{
+#ifdef DUMP_HAS_ZLIB
+    return DUMP_CODEC_DEFLATE;
+#else
+    return DUMP_CODEC_RAW;
+#endif
+}
+
+
+/**************************************************************************/
+int pixelSizeOf(const Image &img)
+{
+    // a generic Image filled by a port keeps its pixel size unset,
+    // whereas the underlying storage knows it
+    int px=img.getPixelSize();
+    const IplImage *ipl=(const IplImage*)img.getIplImage();
+    if ((px<=0) && (ipl!=NULL))
+        px=ipl->nChannels*((ipl->depth&~IPL_DEPTH_SIGN)/8);
+    return px;
+}
+
+
+/**************************************************************************/
+void packRows(const Image &img, size_t px, char *dst, bool filter)
+{
+    size_t rowLen=(size_t)img.width()*px;
+    for (int r=0; r<img.height(); r++)
+    {
+        const unsigned char *src=img.getRow(r);
+        if (!filter)
+            memcpy(dst,src,rowLen);
+        else
+        {
+            for (size_t i=0; i<px && i<rowLen; i++)
+                dst[i]=src[i];
+            for (size_t i=px; i<rowLen; i++)
+                dst[i]=(char)(src[i]-src[i-px]);
+        }
+        dst+=rowLen;
+    }
+}
+
+
+/**************************************************************************/
+void unpackRows(const char *src, Image &img, bool filter)
+{
+    size_t rowLen=(size_t)img.width()*img.getPixelSize();
+    size_t px=(size_t)img.getPixelSize();
+    for (int r=0; r<img.height(); r++)
+    {
+        unsigned char *dst=img.getRow(r);
+        if (!filter)
+            memcpy(dst,src,rowLen);
+        else
+        {
+            for (size_t i=0; i<px && i<rowLen; i++)
+                dst[i]=(unsigned char)src[i];
+            for (size_t i=px; i<rowLen; i++)
+                dst[i]=(unsigned char)(src[i]+dst[i-px]);
+        }
+        src+=rowLen;
+    }
+}
+
+
+#ifdef DUMP_HAS_JPEG
+/**************************************************************************/
+struct DumpJpegError
+{
+    struct jpeg_error_mgr pub;
+    jmp_buf               jump;
+};
+
+
+/**************************************************************************/
+void dumpJpegErrorExit(j_common_ptr cinfo)
+{
+    DumpJpegError *err=(DumpJpegError*)cinfo->err;
+    (*cinfo->err->output_message)(cinfo);
+    longjmp(err->jump,1);
+}
+
+
+/**************************************************************************/
+struct DumpJpegDest
+{
+    struct jpeg_destination_mgr pub;
+    vector<char>               *out;
+    size_t                      start;
+};
+
+
+/**************************************************************************/
+void dumpJpegInitDest(j_compress_ptr cinfo)
+{
+    DumpJpegDest *dest=(DumpJpegDest*)cinfo->dest;
+    dest->out->resize(dest->start+4096);
+    dest->pub.next_output_byte=(JOCTET*)&(*dest->out)[dest->start];
+    dest->pub.free_in_buffer=dest->out->size()-dest->start;
+}
+
+
+/**************************************************************************/
+boolean dumpJpegEmptyDest(j_compress_ptr cinfo)
+{
+    // libjpeg wants the whole buffer to be flushed here
+    DumpJpegDest *dest=(DumpJpegDest*)cinfo->dest;
+    size_t used=dest->out->size();
+    dest->out->resize(2*used);
+    dest->pub.next_output_byte=(JOCTET*)&(*dest->out)[used];
+    dest->pub.free_in_buffer=dest->out->size()-used;
+    return TRUE;
+}
+
+
+/**************************************************************************/
+void dumpJpegTermDest(j_compress_ptr cinfo)
+{
+    DumpJpegDest *dest=(DumpJpegDest*)cinfo->dest;
+    dest->out->resize(dest->out->size()-dest->pub.free_in_buffer);
+}
+
+
+/**************************************************************************/
+void dumpJpegInitSource(j_decompress_ptr cinfo) { }
+void dumpJpegTermSource(j_decompress_ptr cinfo) { }
+
+
+/**************************************************************************/
+boolean dumpJpegFillInput(j_decompress_ptr cinfo)
+{
+    // the whole stream is in memory: pretend an EOI marker
+    static const JOCTET eoi[2]={ (JOCTET)0xFF, (JOCTET)JPEG_EOI };
+    cinfo->src->next_input_byte=eoi;
+    cinfo->src->bytes_in_buffer=2;
+    return TRUE;
+}
+
+
+/**************************************************************************/
+void dumpJpegSkipInput(j_decompress_ptr cinfo, long num_bytes)
+{
+    if (num_bytes>0)
+    {
+        size_t n=(size_t)num_bytes;
+        if (n>cinfo->src->bytes_in_buffer)
+            n=cinfo->src->bytes_in_buffer;
+        cinfo->src->next_input_byte+=n;
+        cinfo->src->bytes_in_buffer-=n;
+    }
+}
+
+
+/**************************************************************************/
+bool jpegEncode(const Image &img, int quality, vector<char> &out)
+{
+    int code=img.getPixelCode();
+    int comps=(code==VOCAB_PIXEL_MONO)?1:3;
+
+    struct jpeg_compress_struct cinfo;
+    DumpJpegError jerr;
+    DumpJpegDest dest;
+    vector<JSAMPLE> row((size_t)img.width()*comps);
+
+    cinfo.err=jpeg_std_error(&jerr.pub);
+    jerr.pub.error_exit=dumpJpegErrorExit;
+    if (setjmp(jerr.jump))
+    {
+        jpeg_destroy_compress(&cinfo);
+        return false;
+    }
+
+    jpeg_create_compress(&cinfo);
+    dest.pub.init_destination=dumpJpegInitDest;
+    dest.pub.empty_output_buffer=dumpJpegEmptyDest;
+    dest.pub.term_destination=dumpJpegTermDest;
+    dest.out=&out;
+    dest.start=out.size();
+    cinfo.dest=&dest.pub;
+
+    cinfo.image_width=img.width();
+    cinfo.image_height=img.height();
+    cinfo.input_components=comps;
+    cinfo.in_color_space=(comps==1)?JCS_GRAYSCALE:JCS_RGB;
+    jpeg_set_defaults(&cinfo);
+    jpeg_set_quality(&cinfo,quality,TRUE);
+    jpeg_start_compress(&cinfo,TRUE);
+
+    while (cinfo.next_scanline<cinfo.image_height)
+    {
+        const unsigned char *src=img.getRow(cinfo.next_scanline);
+        JSAMPROW rowPtr=(JSAMPROW)src;
+        if (code==VOCAB_PIXEL_BGR)
+        {
+            for (int i=0; i<img.width(); i++)
+            {
+                row[3*i+0]=src[3*i+2];
+                row[3*i+1]=src[3*i+1];
+                row[3*i+2]=src[3*i+0];
+            }
+            rowPtr=&row[0];
+        }
+        jpeg_write_scanlines(&cinfo,&rowPtr,1);
+    }
+
+    jpeg_finish_compress(&cinfo);
+    jpeg_destroy_compress(&cinfo);
+    return true;
+}
+
+
+/**************************************************************************/
+bool jpegDecode(const char *data, size_t len, FlexImage &img)
+{
+    int code=img.getPixelCode();
+    int comps=(code==VOCAB_PIXEL_MONO)?1:3;
+
+    struct jpeg_decompress_struct cinfo;
+    struct jpeg_source_mgr src;
+    DumpJpegError jerr;
+    vector<JSAMPLE> row((size_t)img.width()*comps);
+
+    cinfo.err=jpeg_std_error(&jerr.pub);
+    jerr.pub.error_exit=dumpJpegErrorExit;
+    if (setjmp(jerr.jump))
+    {
+        jpeg_destroy_decompress(&cinfo);
+        return false;
+    }
+
+    jpeg_create_decompress(&cinfo);
+    src.init_source=dumpJpegInitSource;
+    src.fill_input_buffer=dumpJpegFillInput;
+    src.skip_input_data=dumpJpegSkipInput;
+    src.resync_to_restart=jpeg_resync_to_restart;
+    src.term_source=dumpJpegTermSource;
+    src.next_input_byte=(const JOCTET*)data;
+    src.bytes_in_buffer=len;
+    cinfo.src=&src;
+
+    jpeg_read_header(&cinfo,TRUE);
+    cinfo.out_color_space=(comps==1)?JCS_GRAYSCALE:JCS_RGB;
+    jpeg_start_decompress(&cinfo);
+    if (((int)cinfo.output_width!=img.width()) ||
+        ((int)cinfo.output_height!=img.height()) ||
+        (cinfo.output_components!=comps))
+    {
+        jpeg_destroy_decompress(&cinfo);
+        return false;
+    }
+
+    while (cinfo.output_scanline<cinfo.output_height)
+    {
+        unsigned char *dst=img.getRow(cinfo.output_scanline);
+        JSAMPROW rowPtr=(code==VOCAB_PIXEL_BGR)?&row[0]:(JSAMPROW)dst;
+        jpeg_read_scanlines(&cinfo,&rowPtr,1);
+        if (code==VOCAB_PIXEL_BGR)
+        {
+            for (int i=0; i<img.width(); i++)
+            {
+                dst[3*i+0]=row[3*i+2];
+                dst[3*i+1]=row[3*i+1];
+                dst[3*i+2]=row[3*i+0];
+            }
+        }
+    }
+
+    jpeg_finish_decompress(&cinfo);
+    jpeg_destroy_decompress(&cinfo);
+    return true;
+}
+#endif
+
+}
+
+
+/**************************************************************************/
+int dumpCodecFromName(const string &name)
+{
+    if (name=="raw")
+        return DUMP_CODEC_RAW;
+#ifdef DUMP_HAS_JPEG
+    if (name=="jpeg")
+        return DUMP_CODEC_JPEG;
+#endif
+#ifdef DUMP_HAS_ZLIB
+    if (name=="lossless")
+        return DUMP_CODEC_DEFLATE;
+#endif
+    return -1;
+}
+
+
+/**************************************************************************/
+bool dumpImageEncode(const Image &img, int codec, int quality,
+                     vector<char> &out)
+{
+    int code=img.getPixelCode();
+    if ((codec==DUMP_CODEC_JPEG) && !isJpegCompatible(code))
+        codec=losslessCodec();
+
+    int px=pixelSizeOf(img);
+    if (px<=0)
+        return false;
+
+    size_t rawLen=(size_t)img.width()*img.height()*px;
+    out.resize(DUMP_CODEC_HEADER_LEN);
+
+#ifdef DUMP_HAS_JPEG
+    if (codec==DUMP_CODEC_JPEG)
+    {
+        if (quality<1)
+            quality=1;
+        else if (quality>100)
+            quality=100;
+
+        if (!jpegEncode(img,quality,out))
+            return false;
+    }
+    else
+#endif
+#ifdef DUMP_HAS_ZLIB
+    if (codec==DUMP_CODEC_DEFLATE)
+    {
+        vector<char> filtered(rawLen);
+        if (rawLen>0)
+            packRows(img,px,&filtered[0],true);
+
+        uLongf zLen=compressBound((uLong)rawLen);
+        out.resize(DUMP_CODEC_HEADER_LEN+zLen);
+        // favour speed: the filter already exposes most of the redundancy
+        if (compress2((Bytef*)&out[DUMP_CODEC_HEADER_LEN],&zLen,
+                      (const Bytef*)(rawLen>0?&filtered[0]:NULL),
+                      (uLong)rawLen,Z_BEST_SPEED)!=Z_OK)
+            return false;
+        out.resize(DUMP_CODEC_HEADER_LEN+zLen);
+    }
+    else
+#endif
+    {
+        codec=DUMP_CODEC_RAW;
+        out.resize(DUMP_CODEC_HEADER_LEN+rawLen);
+        if (rawLen>0)
+            packRows(img,px,&out[DUMP_CODEC_HEADER_LEN],false);
+    }
+
+    putInt(out,0,codec);
+    putInt(out,4,img.width());
+    putInt(out,8,img.height());
+    putInt(out,12,code);
+    putInt(out,16,px);
+    return true;
+}
+
+
+/**************************************************************************/
+bool dumpImageDecode(const char *data, size_t len, Image &img)
+{
+    if ((data==NULL) || (len<DUMP_CODEC_HEADER_LEN))
+        return false;
+
+    int codec=getInt(data,0);
+    int w=getInt(data,4);
+    int h=getInt(data,8);
+    int code=getInt(data,12);
+    int pixelSize=getInt(data,16);
+    if ((w<0) || (h<0) || (pixelSize<=0))
+        return false;
+
+    FlexImage tmp;
+    tmp.setPixelCode(code);
+    tmp.setPixelSize(pixelSize);
+    tmp.setQuantum(1);
+    tmp.resize(w,h);
+
+    data+=DUMP_CODEC_HEADER_LEN;
+    len-=DUMP_CODEC_HEADER_LEN;
+    size_t rawLen=(size_t)w*h*tmp.getPixelSize();
+
+    bool ok=false;
+    if (codec==DUMP_CODEC_RAW)
+    {
+        ok=(len>=rawLen);
+        if (ok)
+            unpackRows(data,tmp,false);
+    }
+#ifdef DUMP_HAS_JPEG
+    else if (codec==DUMP_CODEC_JPEG)
+        ok=isJpegCompatible(code) && jpegDecode(data,len,tmp);
+#endif
+#ifdef DUMP_HAS_ZLIB
+    else if (codec==DUMP_CODEC_DEFLATE)
+    {
+        vector<char> filtered(rawLen);
+        uLongf zLen=(uLongf)rawLen;
+        ok=(uncompress((Bytef*)(rawLen>0?&filtered[0]:NULL),&zLen,
+                       (const Bytef*)data,(uLong)len)==Z_OK) && (zLen==rawLen);
+        if (ok && (rawLen>0))
+            unpackRows(&filtered[0],tmp,true);
+    }
+#endif
+    else
+        yError("unsupported image codec %d",codec);
+
+    if (ok)
+        img.copy(tmp);
+
+    return ok;
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2016 iCub Facility - Istituto Italiano di Tecnologia
+ * CopyPolicy: Released under the terms of the GPLv2 or later, see GPL.TXT
+ */
+
+#ifndef DUMPIMAGECODEC_H
+#define DUMPIMAGECODEC_H
+
+#include <string>
+#include <vector>
+
+#include <yarp/sig/Image.h>
+
+
+/**
+ * Image compression used by yarpdatadumper for the "compressed image"
+ * binary recordings (see DumpBinaryLog.h). Each frame is stored as:
+ *
+ * \code
+ * int32 codec | int32 width | int32 height | int32 pixelCode | int32 pixelSize
+ *       | <codec data>
+ * \endcode
+ *
+ * - DUMP_CODEC_RAW: rows packed without padding;
+ * - DUMP_CODEC_JPEG: a JPEG stream (mono, rgb and bgr images only),
+ *   available if the tool is built with libjpeg (DUMP_HAS_JPEG);
+ * - DUMP_CODEC_DEFLATE: rows packed without padding, each byte replaced
+ *   by its difference with the same byte of the previous pixel (the
+ *   PNG "sub" filter), then deflated; it is lossless for every pixel
+ *   type and available if the tool is built with zlib (DUMP_HAS_ZLIB).
+ *
+ * Images that the requested codec cannot handle fall back to the
+ * best lossless codec available.
+ */
+#define DUMP_CODEC_RAW              0
+#define DUMP_CODEC_JPEG             1
+#define DUMP_CODEC_DEFLATE          2
+#define DUMP_CODEC_HEADER_LEN       (5*4)
+
+
+/**
+ * @return the codec id matching \e name ("raw", "jpeg", "lossless"),
+ * or -1 if unknown or not available in this build.
+ */
+int dumpCodecFromName(const std::string &name);
+
+/**
+ * Compress \e img into \e out (which is overwritten).
+ * @param codec the preferred codec
+ * @param quality JPEG quality in [1,100]
+ */
+bool dumpImageEncode(const yarp::sig::Image &img, int codec, int quality,
+                     std::vector<char> &out);
+
+/**
+ * Decompress a frame produced by dumpImageEncode() into \e img, which
+ * takes the original size and pixel type if it is a generic Image, or
+ * is converted to its own pixel type otherwise.
+ */
+bool dumpImageDecode(const char *data, size_t len, yarp::sig::Image &img);
+
+#endif
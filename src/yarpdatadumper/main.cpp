@@ -10,16 +10,23 @@
 #include <sstream>
 #include <string>
 #include <deque>
+#include <vector>
+#include <algorithm>
 
 #ifdef ADD_VIDEO
     #include <opencv2/opencv.hpp>
 #endif
 
 #include <yarp/os/all.h>
+#include <yarp/os/impl/AtomicCounter.h>
 #include <yarp/sig/all.h>
 
+#include "DumpBinaryLog.h"
+#include "DumpImageCodec.h"
+
 using namespace std;
 using namespace yarp::os;
+using namespace yarp::os::impl;
 using namespace yarp::sig;
 
 
@@ -27,6 +34,22 @@ using namespace yarp::sig;
 typedef enum { bottle, image } DumpType;
 
 
+// Size and alignment of the buffers of the data files
+/**************************************************************************/
+#define DUMP_WRITE_BUFFER_SIZE      (4<<20)
+#define DUMP_WRITE_BUFFER_ALIGN     4096
+
+
+// Give back a page-aligned region of the given size within storage
+/**************************************************************************/
+char *alignedBuffer(vector<char> &storage, size_t size)
+{
+    storage.resize(size+DUMP_WRITE_BUFFER_ALIGN);
+    size_t misalign=(size_t)&storage[0]%DUMP_WRITE_BUFFER_ALIGN;
+    return &storage[0]+(misalign>0?DUMP_WRITE_BUFFER_ALIGN-misalign:0);
+}
+
+
 // Abstract object definition for queueing
 /**************************************************************************/
 class DumpObj
@@ -35,6 +58,9 @@ public:
     virtual ~DumpObj() { }
     virtual const string toFile(const string&, unsigned int) = 0;
     virtual void *getPtr() = 0;
+    virtual Portable *getPortable() = 0;
+    virtual bool pack(int codec, int quality) { return false; }
+    virtual const vector<char> *getPacked() { return NULL; }
 };
 
 
@@ -59,6 +85,7 @@ public:
     }
 
     void *getPtr() { return NULL; }
+    Portable *getPortable() { return p; }
 };
 
 
@@ -77,6 +104,7 @@ class DumpImage : public DumpObj
 {
 private:
     Image *p;
+    vector<char> packed;
 
 public:
     DumpImage() { p=new Image(); }
@@ -114,6 +142,14 @@ public:
     }
 
     void *getPtr() { return p->getIplImage(); }
+    Portable *getPortable() { return p; }
+
+    bool pack(int codec, int quality)
+    {
+        return dumpImageEncode(*p,codec,quality,packed);
+    }
+
+    const vector<char> *getPacked() { return packed.empty()?NULL:&packed; }
 };
 
 
@@ -139,6 +175,12 @@ public:
     DumpTimeStamp() : rxOk(false), txOk(false) { }
     void setRxStamp(const double stamp) { rxStamp=stamp; rxOk=true; }
     void setTxStamp(const double stamp) { txStamp=stamp; txOk=true; }
+    double getTxStamp() const { return txOk?txStamp:-1.0; }
+    double getRxStamp() const { return rxOk?rxStamp:-1.0; }
+    int getFlags() const
+    {
+        return (txOk?DUMP_BINARY_TX_VALID:0)|(rxOk?DUMP_BINARY_RX_VALID:0);
+    }
     double getStamp() const
     {
         if (txOk)
@@ -178,17 +220,204 @@ typedef struct
 
 // Definition of the queue
 // Two services act on this resource:
-// 1) the port, which listens to incoming data
-// 2) the thread, which stores the data to disk
+// 1) the port, which listens to incoming data (the producer)
+// 2) the thread, which stores the data to disk (the consumer)
+// It is a bounded ring of preallocated slots where the producer
+// only moves the tail and the consumer only moves the head, hence
+// no lock is needed; when the ring is full the incoming items are
+// dropped and accounted for
 /**************************************************************************/
-class DumpQueue : public deque<DumpItem>
+class DumpQueue
 {
 private:
-    Mutex mutex;
+    vector<DumpItem> slots;
+    AtomicCounter    head;
+    AtomicCounter    tail;
+    AtomicCounter    peak;
+    AtomicCounter    drops;
+    Semaphore        ready;
+
+    int next(int i) const { return (i+1)%(int)slots.size(); }
 
 public:
-    void lock()   { mutex.lock();   }
-    void unlock() { mutex.unlock(); }
+    DumpQueue(int capacity) : slots(std::max(capacity,1)+1), ready(0) { }
+
+    int capacity() const { return (int)slots.size()-1; }
+
+    int size()
+    {
+        int sz=(int)slots.size();
+        return (tail.get()-head.get()+sz)%sz;
+    }
+
+    // producer side (the compression pool serializes its workers)
+    bool push(const DumpItem &item)
+    {
+        int t=tail.get();
+        int h=head.get();
+        if (next(t)==h)
+        {
+            drops.inc();
+            return false;
+        }
+
+        slots[t]=item;
+        tail.set(next(t));
+
+        int sz=(int)slots.size();
+        int backlog=(t-h+sz)%sz+1;
+        if (backlog>peak.get())
+            peak.set(backlog);
+
+        // the consumer sleeps only when it found the ring empty: look at
+        // head again, it may have caught up with us since we read it
+        if (head.get()==t)
+            ready.post();
+        return true;
+    }
+
+    // consumer side
+    bool pop(DumpItem &item)
+    {
+        int h=head.get();
+        if (h==tail.get())
+            return false;
+
+        item=slots[h];
+        head.set(next(h));
+        return true;
+    }
+
+    DumpItem &front() { return slots[head.get()]; }
+    DumpItem &back()  { return slots[(tail.get()-1+(int)slots.size())%(int)slots.size()]; }
+
+    void wait(double timeout) { ready.waitWithTimeout(timeout); }
+    void wake()               { ready.post();                   }
+
+    int getPeak()  { return peak.get();  }
+    int getDrops() { return drops.get(); }
+};
+
+
+// Pool of threads compressing the items before they get queued
+// for storage; the items reach the queue in their arrival order,
+// whatever the order in which the single compressions complete
+/**************************************************************************/
+class DumpCompressor
+{
+private:
+    struct Job
+    {
+        DumpItem item;
+        bool     done;
+    };
+
+    class Worker : public Thread
+    {
+        DumpCompressor &compressor;
+
+    public:
+        Worker(DumpCompressor &_compressor) : compressor(_compressor) { }
+        void run() { while (compressor.process()); }
+    };
+
+    DumpQueue       &buf;
+    int              codec;
+    int              quality;
+    deque<Job*>      pending;
+    deque<Job*>      todo;
+    Mutex            mutex;
+    Semaphore        jobs;
+    vector<Worker*>  workers;
+    bool             closing;
+
+    // one step of a worker: it returns false when the pool is closing
+    // and there is nothing left to do
+    bool process()
+    {
+        jobs.wait();
+
+        mutex.lock();
+        if (todo.empty())
+        {
+            mutex.unlock();
+            return !closing;
+        }
+        Job *job=todo.front();
+        todo.pop_front();
+        mutex.unlock();
+
+        job->item.obj->pack(codec,quality);
+
+        mutex.lock();
+        job->done=true;
+        while (!pending.empty() && pending.front()->done)
+        {
+            if (!buf.push(pending.front()->item))
+                delete pending.front()->item.obj;
+
+            delete pending.front();
+            pending.pop_front();
+        }
+        mutex.unlock();
+
+        return true;
+    }
+
+public:
+    DumpCompressor(DumpQueue &Q, int _codec, int _quality) :
+                   buf(Q), codec(_codec), quality(_quality), jobs(0),
+                   closing(false) { }
+
+    bool start(int nThreads)
+    {
+        closing=false;
+        for (int i=0; i<std::max(nThreads,1); i++)
+        {
+            Worker *worker=new Worker(*this);
+            if (!worker->start())
+            {
+                delete worker;
+                return false;
+            }
+            workers.push_back(worker);
+        }
+        return true;
+    }
+
+    void push(const DumpItem &item)
+    {
+        Job *job=new Job;
+        job->item=item;
+        job->done=false;
+
+        mutex.lock();
+        pending.push_back(job);
+        todo.push_back(job);
+        mutex.unlock();
+
+        jobs.post();
+    }
+
+    // the jobs still pending are completed before returning
+    void stop()
+    {
+        mutex.lock();
+        closing=true;
+        mutex.unlock();
+
+        for (size_t i=0; i<workers.size(); i++)
+            jobs.post();
+
+        for (size_t i=0; i<workers.size(); i++)
+        {
+            workers[i]->stop();
+            delete workers[i];
+        }
+        workers.clear();
+    }
+
+    ~DumpCompressor() { stop(); }
 };
 
 
@@ -198,7 +427,8 @@ class DumpPort : public BufferedPort<T>
 {
 public:
     DumpPort(DumpQueue &Q, unsigned int _dwnsample=1,
-             bool _rxTime=true, bool _txTime=false) : buf(Q)
+             bool _rxTime=true, bool _txTime=false,
+             DumpCompressor *_compressor=NULL) : buf(Q), compressor(_compressor)
     {
         rxTime=_rxTime;
         txTime=_txTime;
@@ -210,6 +440,7 @@ public:
 
 private:
     DumpQueue &buf;
+    DumpCompressor *compressor;
     unsigned int dwnsample;
     unsigned int cnt;
     bool firstIncomingData;
@@ -241,9 +472,12 @@ private:
 
             item.obj=factory(obj);
 
-            buf.lock();
-            buf.push_back(item);
-            buf.unlock();
+            // compression is carried out by the pool, so that
+            // the port is never held up by the encoder
+            if (compressor!=NULL)
+                compressor->push(item);
+            else if (!buf.push(item))
+                delete item.obj;
 
             cnt=0;
         }
@@ -251,23 +485,32 @@ private:
 };
 
 
+// Write-behind thread: it sleeps until the port fills the queue and
+// appends the items to data files with large buffers, which are
+// flushed every 10 seconds
 /**************************************************************************/
-class DumpThread : public RateThread
+class DumpThread : public Thread
 {
 private:
     DumpQueue      &buf;
     DumpType        type;
+    vector<char>    writeBuffer;    // it must outlive the data files
     ofstream        finfo;
     ofstream        fdata;
+    DumpBinaryWriter fbin;
     string          dirName;
     string          infoFile;
     string          dataFile;
     unsigned int    blockSize;
     unsigned int    cumulSize;
+    unsigned int    storedSize;
     unsigned int    counter;
+    int             reportedDrops;
     double          oldTime;
 
     bool            saveData;
+    bool            binary;
+    int             codec;
     bool            videoOn;
     string          videoType;
     bool            closing;
@@ -284,16 +527,17 @@ private:
 
 public:
     DumpThread(DumpType _type, DumpQueue &Q, const string &_dirName, int szToWrite,
-               bool _saveData, bool _videoOn, const string &_videoType) :
-               RateThread(50), buf(Q), type(_type), dirName(_dirName),
-               blockSize(szToWrite), saveData(_saveData),
-               videoOn(_videoOn), videoType(_videoType)
+               bool _saveData, bool _binary, int _codec, bool _videoOn,
+               const string &_videoType) :
+               buf(Q), type(_type), dirName(_dirName),
+               blockSize(szToWrite), saveData(_saveData), binary(_binary&&_saveData),
+               codec(binary?_codec:-1), videoOn(_videoOn), videoType(_videoType)
     {
         infoFile=dirName;
         infoFile+="/info.log";
 
         dataFile=dirName;
-        dataFile+="/data.log";
+        dataFile+=binary?"/data.bin":"/data.log";
 
     #ifdef ADD_VIDEO
         transform(videoType.begin(),videoType.end(),videoType.begin(),::tolower);
@@ -327,7 +571,9 @@ public:
     {
         oldTime=Time::now();
         cumulSize=0;
+        storedSize=0;
         counter=0;
+        reportedDrops=0;
         closing=false;
 
         finfo.open(infoFile.c_str());
@@ -346,10 +592,25 @@ public:
             if (videoOn)
                 finfo<<" Video:"<<videoType<<"(huffyuv);";
         }
+        if (binary)
+            finfo<<" Format:binary;";
+        if (codec>=0)
+            finfo<<" Compression:"<<(codec==DUMP_CODEC_JPEG?"jpeg":
+                                     codec==DUMP_CODEC_DEFLATE?"lossless":"raw")<<";";
         finfo<<endl;
 
-        fdata.open(dataFile.c_str());
-        if (!fdata.is_open())
+        char *buffer=alignedBuffer(writeBuffer,DUMP_WRITE_BUFFER_SIZE);
+        if (binary)
+            fbin.setBuffer(buffer,DUMP_WRITE_BUFFER_SIZE);
+        else
+            fdata.rdbuf()->pubsetbuf(buffer,DUMP_WRITE_BUFFER_SIZE);
+
+        if (binary)
+            fbin.open(dataFile,codec>=0?DUMP_BINARY_TYPE_PACKED:
+                      type==bottle?DUMP_BINARY_TYPE_BOTTLE:DUMP_BINARY_TYPE_IMAGE);
+        else
+            fdata.open(dataFile.c_str());
+        if (!(binary?fbin.isOpen():fdata.is_open()))
         {
             yError() << "unable to open file: " << dataFile;
             return false;
@@ -371,33 +632,26 @@ public:
         return true;
     }
 
-    void run()
+    void store()
     {
-        buf.lock();
-        unsigned int sz=buf.size(); //!!! access to size must be protected: problem spotted with Linux stl
-        buf.unlock();
+        unsigned int sz=buf.size();
 
-        // each 10 seconds it issues a writeToDisk command straightaway
-        bool writeToDisk=false;
+        // each 10 seconds the files are flushed and the stats reported
         double curTime=Time::now();
-        if ((curTime-oldTime>10.0) || closing)
-        {
-            writeToDisk=sz>0;
-            oldTime=curTime;
-        }
+        bool flush=(curTime-oldTime>10.0) || closing;
 
-        // it performs the writeToDisk on command or as soon as
-        // the queue size is greater than the given threshold
-        if ((sz>blockSize) || writeToDisk)
+        if (sz>0)
         {
         #ifdef ADD_VIDEO
-            // extract images parameters just once
+            // extract images parameters just once, as soon as
+            // the queue size is greater than the given threshold
+            if (doImgParamsExtraction && (sz<=blockSize) && !flush)
+                return;
+
             if (doImgParamsExtraction && (sz>1))
             {
-                buf.lock();
                 DumpItem itemFront=buf.front();
                 DumpItem itemEnd=buf.back();
-                buf.unlock();
 
                 int fps;
                 int frameW=((IplImage*)itemEnd.obj->getPtr())->width;
@@ -419,21 +673,40 @@ public:
         #endif
 
             // save to disk
-            for (unsigned int i=0; i<sz; i++)
+            DumpItem item;
+            for (unsigned int i=0; (i<sz) && buf.pop(item); i++)
             {
-                buf.lock();
-                DumpItem item=buf.front();
-                buf.pop_front();
-                buf.unlock();
-
-                fdata << item.seqNumber << ' ' << item.timeStamp.getString() << ' ';
-                if (saveData)
-                    fdata << item.obj->toFile(dirName,counter++) << endl;
+                if (codec>=0)
+                {
+                    // compressed by the pool in a single file, no per-item files
+                    const vector<char> *packed=item.obj->getPacked();
+                    if (packed!=NULL)
+                        fbin.writeRaw(item.seqNumber,item.timeStamp.getFlags(),
+                                      item.timeStamp.getTxStamp(),item.timeStamp.getRxStamp(),
+                                      item.timeStamp.getStamp(),&(*packed)[0],packed->size());
+                    else
+                        yWarning() << "unable to compress item #" << item.seqNumber;
+                    counter++;
+                }
+                else if (binary)
+                {
+                    // raw wire data in a single file, no per-item files
+                    fbin.write(item.seqNumber,item.timeStamp.getFlags(),
+                               item.timeStamp.getTxStamp(),item.timeStamp.getRxStamp(),
+                               item.timeStamp.getStamp(),*item.obj->getPortable());
+                    counter++;
+                }
+                else if (saveData)
+                {
+                    fdata << item.seqNumber << ' ' << item.timeStamp.getString() << ' ';
+                    fdata << item.obj->toFile(dirName,counter++) << '\n';
+                }
                 else
                 {
                     ostringstream frame;
                     frame << "frame_" << setw(8) << setfill('0') << counter++;
-                    fdata << frame.str() << endl;
+                    fdata << item.seqNumber << ' ' << item.timeStamp.getString() << ' ';
+                    fdata << frame.str() << '\n';
                 }
 
             #ifdef ADD_VIDEO
@@ -444,26 +717,65 @@ public:
 
                     // write the timecode of the frame
                     int dt=(int)(1000.0*(item.timeStamp.getStamp()-t0));
-                    ftimecodes << dt << endl;
+                    ftimecodes << dt << '\n';
                 }
             #endif
 
                 delete item.obj;
             }
 
+            storedSize+=sz;
             cumulSize+=sz;
-            yInfo() << sz << " items stored [cumul #: " << cumulSize << "]";
+        }
+
+        if (flush)
+        {
+            if (binary)
+                fbin.flush();
+            else
+                fdata.flush();
+
+            int drops=buf.getDrops();
+            if ((storedSize>0) || (drops>reportedDrops))
+            {
+                yInfo() << storedSize << " items stored [cumul #: " << cumulSize << "]"
+                        << "[backlog peak: " << buf.getPeak() << "/" << buf.capacity() << "]"
+                        << "[dropped: " << drops << "]";
+                if (drops>reportedDrops)
+                    yWarning() << drops-reportedDrops << " items dropped since the queue was full";
+            }
+
+            storedSize=0;
+            reportedDrops=drops;
+            oldTime=curTime;
+        }
+    }
+
+    void run()
+    {
+        while (!isStopping())
+        {
+            buf.wait(0.5);
+            store();
         }
     }
 
+    void onStop()
+    {
+        buf.wake();
+    }
+
     void threadRelease()
     {
-        // call run() for the last time to flush the queue
+        // store for the last time to flush the queue
         closing=true;
-        run();
+        store();
 
         finfo.close();
-        fdata.close();
+        if (binary)
+            fbin.close();
+        else
+            fdata.close();
 
     #ifdef ADD_VIDEO
         if (videoOn)
@@ -498,6 +810,7 @@ private:
     DumpPort<Bottle> *p_bottle;
     DumpPort<Image>  *p_image;
     DumpThread       *t;
+    DumpCompressor   *c;
     DumpReporter      reporter;
     Port              rpcPort;
     DumpType          type;
@@ -507,7 +820,7 @@ private:
     string            portName;
 
 public:
-    DumpModule() { }
+    DumpModule() : c(NULL) { }
 
     bool configure(ResourceFinder &rf)
     {
@@ -518,8 +831,10 @@ public:
             portName="/"+portName;
 
         bool saveData=true;
+        bool binary=rf.check("binary");
         bool videoOn=false;
         string videoType=rf.check("videoType",Value("mkv")).asString().c_str();
+        int codec=-1;
 
         if (rf.check("type"))
         {
@@ -551,6 +866,20 @@ public:
         else
             type=bottle;
 
+        if (rf.check("compress"))
+        {
+            string codecName=rf.find("compress").asString().c_str();
+            if (type!=image)
+                yWarning() << "compression applies only to images; option ignored";
+            else if ((codec=dumpCodecFromName(codecName))<0)
+            {
+                yError() << "Error: compression" << codecName << "not available";
+                return false;
+            }
+            else
+                binary=true;
+        }
+
         dwnsample=rf.check("downsample",Value(1)).asInt();
         rxTime=rf.check("rxTime");
         txTime=rf.check("txTime");
@@ -580,8 +909,8 @@ public:
         }
         yarp::os::mkdir_p(dirName.c_str());
 
-        q=new DumpQueue();
-        t=new DumpThread(type,*q,dirName.c_str(),100,saveData,videoOn,videoType);
+        q=new DumpQueue(rf.check("queueSize",Value(1000)).asInt());
+        t=new DumpThread(type,*q,dirName.c_str(),100,saveData,binary,codec,videoOn,videoType);
 
         if (!t->start())
         {
@@ -591,6 +920,23 @@ public:
             return false;
         }
 
+        if (saveData && (codec>=0))
+        {
+            int quality=rf.check("quality",Value(90)).asInt();
+            int nThreads=rf.check("compressThreads",Value(2)).asInt();
+            c=new DumpCompressor(*q,codec,std::min(std::max(quality,1),100));
+            if (!c->start(nThreads))
+            {
+                yError() << "unable to start the compression threads";
+                delete c;
+                t->stop();
+                delete t;
+                delete q;
+
+                return false;
+            }
+        }
+
         reporter.setThread(t);
 
         if (type==bottle)
@@ -603,7 +949,7 @@ public:
         }
         else
         {
-            p_image=new DumpPort<Image>(*q,dwnsample,rxTime,txTime);
+            p_image=new DumpPort<Image>(*q,dwnsample,rxTime,txTime,c);
             p_image->useCallback();
             p_image->open(portName.c_str());
             p_image->setStrict();
@@ -638,8 +984,6 @@ public:
 
     bool close()
     {
-        t->stop();
-
         if (type==bottle)
         {
             p_bottle->interrupt();
@@ -656,6 +1000,15 @@ public:
         rpcPort.interrupt();
         rpcPort.close();
 
+        // flush the compression pool before the storage thread
+        if (c!=NULL)
+        {
+            c->stop();
+            delete c;
+        }
+
+        t->stop();
+
         delete t;
         delete q;
 
@@ -690,6 +1043,11 @@ int main(int argc, char *argv[])
     #else
         yInfo() << "\t--type       type: type of the data to be dumped [bottle(default), image]";
     #endif
+        yInfo() << "\t--binary         : store raw data with a time index in data.bin instead of data.log";
+        yInfo() << "\t--compress  type: store compressed images in data.bin [raw, jpeg, lossless]";
+        yInfo() << "\t--quality      q: jpeg quality in [1,100] (default: 90)";
+        yInfo() << "\t--compressThreads n: number of compression threads (default: 2)";
+        yInfo() << "\t--queueSize     n: max number of items waiting to be stored (default: 1000)";
         yInfo() << "\t--downsample    n: downsample rate (default: 1 => downsample disabled)";
         yInfo() << "\t--rxTime         : dump the receiver time instead of the sender time";
         yInfo() << "\t--txTime         : dump the sender time straightaway";
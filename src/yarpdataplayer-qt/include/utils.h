@@ -29,7 +29,9 @@
 #include <yarp/sig/Image.h>
 #include <yarp/os/Network.h>
 #include <yarp/os/RpcClient.h>
+#include <QFile>
 #include "include/worker.h"
+#include "DumpBinaryLog.h"
 
 class WorkerClass;
 class MasterThread;
@@ -51,6 +53,9 @@ struct partsData
         yarp::os::BufferedPort<yarp::os::Bottle>        bottlePort; //yarp port for sending bottles
         yarp::os::BufferedPort<yarp::sig::Image>        imagePort;  //yarp port for sending images
         std::string             portName;                           //the name of the port
+        bool                    isBinary;                           //true if the data has been recorded in binary format
+        QFile                   binFile;                            //binary data file, memory-mapped while playing
+        DumpBinaryReader        binLog;                             //indexed reader of the binary data file
         int                     sent;                               //integer used for step from command
         bool                    hasNotified;                        //boolean used for individual part notification that it has reached eof
     };
@@ -102,6 +107,10 @@ public:
     */
     bool checkLogValidity (const char * filename);
     /**
+    * function that checks validity of binary data files
+    */
+    bool checkBinaryValidity (const char * filename);
+    /**
     * function that resets the directory count
     */
     void resetDirCount();
@@ -110,6 +119,10 @@ public:
     */
     bool setupDataFromParts(partsData &part);
     /**
+    * function that indexes the binary data of a part without loading it
+    */
+    bool setupBinaryDataFromParts(partsData &part);
+    /**
     * function that configures and opens all the ports required
     */
     bool configurePorts(partsData &part);
@@ -67,6 +67,10 @@ public:
     */
     int sendImages( int part, int id );
     /**
+    * Function that sends one frame of a binary recording
+    */
+    int sendBinary( int part, int id );
+    /**
     * Function that returns the frame rate
     */
     double getFrameRate();
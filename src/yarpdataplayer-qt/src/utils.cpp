@@ -155,9 +155,17 @@ int Utilities::getRecSubDirList(string dir, vector<string> &names, vector<string
             const char * filename = fullName.c_str();
             if(stat(filename,&st) == 0) {
                 string dataFileName = string(dir + "/" + direntp->d_name + "/data.log");
+                bool binary = false;
+                if (stat(dataFileName.c_str(), &st) != 0){
+                    string binFileName = string(dir + "/" + direntp->d_name + "/data.bin");
+                    if (stat(binFileName.c_str(), &st) == 0){
+                        dataFileName = binFileName;
+                        binary = true;
+                    }
+                }
 
                 bool checkLog = checkLogValidity( filename );
-                bool checkData = checkLogValidity( dataFileName.c_str() );
+                bool checkData = binary ? checkBinaryValidity( dataFileName.c_str() ) : checkLogValidity( dataFileName.c_str() );
                 //check log file validity before proceeding
                 if ( checkLog && checkData && (stat(dataFileName.c_str(), &st) == 0)) {
                     LOG(" %s IS present adding it to the gui\n",filename);
@@ -169,7 +177,7 @@ int Utilities::getRecSubDirList(string dir, vector<string> &names, vector<string
                     }
 
                     info.push_back( string(dir + "/" + direntp->d_name + "/info.log") );
-                    logs.push_back( string(dir + "/" + direntp->d_name + "/data.log") );
+                    logs.push_back( dataFileName );
                     paths.push_back( string(dir + "/" + direntp->d_name + "/") ); //pass full path
                     dir_count++;
                 } else {
@@ -241,9 +249,57 @@ bool Utilities::checkLogValidity(const char *filename)
     return check;
 }
 /**********************************************************/
+bool Utilities::checkBinaryValidity(const char *filename)
+{
+    char magic[DUMP_BINARY_MAGIC_LEN];
+    fstream str;
+    str.open (filename, ios::in | ios::binary);
+    if (!str.is_open()){
+        return false;
+    }
+    str.read(magic, sizeof(magic));
+    bool check = str.good() && DumpBinaryReader::isBinaryLog(magic, sizeof(magic));
+    str.close();
+    return check;
+}
+/**********************************************************/
+bool Utilities::setupBinaryDataFromParts(partsData &part)
+{
+    // map the whole file: frames are decoded only when they are sent
+    part.binFile.setFileName(part.logFile.c_str());
+    if (!part.binFile.open(QIODevice::ReadOnly)){
+        return false;
+    }
+    size_t len = (size_t)part.binFile.size();
+    const char *base = (const char*)part.binFile.map(0, part.binFile.size());
+    if (!part.binLog.attach(base, len) || (part.binLog.size() < 1)){
+        LOG_ERROR("%s is not a valid binary log\n", part.logFile.c_str());
+        part.binFile.close();
+        return false;
+    }
+
+    int frames = part.binLog.size();
+    part.timestamp.resize(frames);
+    for (int i=0; i < frames; i++){
+        if (withExtraColumn){
+            part.timestamp[i] = (column == 2) ? part.binLog.getRxStamp(i) : part.binLog.getTxStamp(i);
+        } else {
+            part.timestamp[i] = part.binLog.getStamp(i);
+        }
+    }
+    LOG("%d frames indexed in %s\n", frames, part.logFile.c_str());
+
+    allTimeStamps.push_back( part.timestamp[0] );   //save all first timeStamps dumped for later ease of use
+    part.maxFrame = frames-1;
+    part.currFrame = 0;
+    part.isBinary = true;
+    return true;
+}
+/**********************************************************/
 bool Utilities::setupDataFromParts(partsData &part)
 {
     fstream str;
+    part.isBinary = false;
 
     // info part
     LOG("opening file %s\n", part.infoFile.c_str() );
@@ -270,6 +326,10 @@ bool Utilities::setupDataFromParts(partsData &part)
     }
 
     // data part
+    if (checkBinaryValidity(part.logFile.c_str())){
+        return setupBinaryDataFromParts(part);
+    }
+
     LOG("opening file %s\n", part.logFile.c_str() );
     str.open (part.logFile.c_str());//, ios::binary);
 
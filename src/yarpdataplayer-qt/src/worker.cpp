@@ -25,6 +25,7 @@
 #include "include/worker.h"
 #include "include/mainwindow.h"
 #include "include/log.h"
+#include "DumpImageCodec.h"
 
 using namespace yarp::sig;
 using namespace yarp::sig::file;
@@ -95,7 +96,11 @@ void WorkerClass::run()
         frameRate = t-initTime;
         initTime = t;
     }
-    if (isActive)
+    if (isActive && utilities->partDetails[part].isBinary)
+    {
+        sendBinary(part, frame);
+    }
+    else if (isActive)
     {
         Bottle tmp;
         if (utilities->withExtraColumn){
@@ -272,6 +277,54 @@ int WorkerClass::sendImages(int part, int frame)
     return 0;
 }
 /**********************************************************/
+int WorkerClass::sendBinary(int part, int frame)
+{
+    partsData &p = utilities->partDetails[part];
+
+    //propagate timestamp
+    Stamp ts(frame,p.timestamp[frame]);
+
+    //decode straight from the mapped file into the port buffers
+    if (strcmp (p.type.c_str(),"Bottle") == 0){
+        Bottle& outBot = p.bottlePort.prepare();
+        if (!p.binLog.readFrame(frame, outBot)){
+            LOG_ERROR("Cannot decode frame %d of %s !\n", frame, p.logFile.c_str() );
+            p.bottlePort.unprepare();
+            return 1;
+        }
+        p.bottlePort.setEnvelope(ts);
+        if (utilities->sendStrict){
+            p.bottlePort.writeStrict();
+        } else {
+            p.bottlePort.write();
+        }
+    } else {
+        Image &temp = p.imagePort.prepare();
+        bool ok;
+        if (p.binLog.getType() == DUMP_BINARY_TYPE_PACKED){
+            //compressed images are decoded from the mapped file as well
+            const char *data;
+            size_t len;
+            ok = p.binLog.getPayload(frame, data, len) && dumpImageDecode(data, len, temp);
+        } else {
+            ok = p.binLog.readFrame(frame, temp);
+        }
+        if (!ok){
+            LOG_ERROR("Cannot decode frame %d of %s !\n", frame, p.logFile.c_str() );
+            p.imagePort.unprepare();
+            return 1;
+        }
+        p.imagePort.setEnvelope(ts);
+        if (utilities->sendStrict){
+            p.imagePort.writeStrict();
+        } else {
+            p.imagePort.write();
+        }
+    }
+
+    return 0;
+}
+/**********************************************************/
 void WorkerClass::setManager(Utilities *utilities)
 {
     this->utilities= utilities;
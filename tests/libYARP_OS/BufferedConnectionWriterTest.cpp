@@ -155,9 +155,49 @@ public:
         }
     }
 
+    void testDummyConnector() {
+        report(0,"test reading back through a dummy connector...");
+        DummyConnector con;
+
+        // the reader works straight off the writer's buffers, external
+        // blocks included, without flattening the message first
+        ImageOf<PixelRgb> img1, img2;
+        img1.resize(320,240);
+        img1.zero();
+        img1.pixel(10,5).r = 41;
+        img1.write(con.getWriter());
+        img1.pixel(10,5).r = 42;
+        ConnectionReader& reader = con.getReader();
+        checkTrue(reader.getSize()>(size_t)img1.getRawImageSize(),
+                  "size includes the pixels");
+        img2.read(reader);
+        checkTrue(img2.width()==img1.width() && img2.height()==img1.height(),
+                  "image size matches");
+        checkEqual(img2.pixel(10,5).r, 42, "image read from external buffer");
+
+        Monster m1, m2;
+        m1.body.fromString("hello (1 (2 (3))) {1 2 3} [done]");
+        m1.head.head.body.resize(41,12);
+        m1.head.body.head.resize(17,63);
+        con.reset();
+        m1.write(con.getWriter());
+        m2.read(con.getReader());
+        checkEqual(m2.body.get(3).asString(),"done","tail matches");
+        checkEqual(m2.head.body.head.width(),17,"nested image matches");
+
+        DummyConnector text;
+        text.setTextMode(true);
+        Bottle b1, b2;
+        b1.fromString("10 \"text\" (1 2)");
+        b1.write(text.getWriter());
+        b2.read(text.getReader());
+        checkEqual(b2.toString(),b1.toString(),"text mode");
+    }
+
     virtual void runTests() {
         testWrite();
         testRestart();
+        testDummyConnector();
     }
 };
 
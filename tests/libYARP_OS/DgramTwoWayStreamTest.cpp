@@ -10,7 +10,9 @@
 #include <yarp/os/impl/String.h>
 #include <yarp/os/impl/UnitTest.h>
 #include <yarp/os/NetType.h>
+#include <yarp/os/Time.h>
 #include <stdio.h>
+#include <string.h>
 
 using namespace yarp::os::impl;
 using namespace yarp::os;
@@ -256,8 +258,121 @@ public:
         }
     }
 
+    // the byte-wise routine NetType::getCrc used to be, as a reference
+    static unsigned long slowCrc(const char *buf, size_t len) {
+        static unsigned long table[256];
+        if (table[1]==0) {
+            for (unsigned long n=0; n<256; n++) {
+                unsigned long c = n;
+                for (int k=0; k<8; k++) {
+                    c = (c&1)?(0xedb88320L^(c>>1)):(c>>1);
+                }
+                table[n] = c;
+            }
+        }
+        unsigned long c = 0xffffffffL;
+        for (size_t n=0; n<len; n++) {
+            c = table[(c^(unsigned char)buf[n])&0xff]^(c>>8);
+        }
+        return c^0xffffffffL;
+    }
+
+    void checkCrc() {
+        report(0, "checking the crc of datagrams");
+
+        char check[] = "123456789";
+        checkEqual((int)NetType::getCrc(check,9),(int)0xcbf43926,
+                   "standard check value");
+        checkEqual((int)NetType::getCrc(check,0),0,"empty buffer");
+
+        ManagedBytes msg(300);
+        for (size_t i=0; i<msg.length(); i++) {
+            msg.get()[i] = (char)(i*37+11);
+        }
+        bool same = true;
+        for (int offset=0; offset<8; offset++) {
+            for (size_t len=0; len+offset<=msg.length(); len+=7) {
+                if (NetType::getCrc(msg.get()+offset,len)!=
+                    slowCrc(msg.get()+offset,len)) {
+                    printf("crc differs at offset %d length %d\n", offset, (int)len);
+                    same = false;
+                }
+            }
+        }
+        checkTrue(same,"crc unchanged at any alignment and length");
+
+        // throughput, for the record
+        ManagedBytes big(1000000);
+        memset(big.get(),1,big.length());
+        int rounds = 20;
+        double start = Time::now();
+        unsigned long fast = 0;
+        for (int i=0; i<rounds; i++) {
+            fast = NetType::getCrc(big.get(),big.length());
+        }
+        double tFast = Time::now()-start;
+        start = Time::now();
+        unsigned long slow = slowCrc(big.get(),big.length());
+        double tSlow = (Time::now()-start)*rounds;
+        checkEqual((int)fast,(int)slow,"same crc on a big buffer");
+        char txt[200];
+        sprintf(txt,"crc throughput: %.0f MB/s, byte-wise reference %.0f MB/s",
+                (tFast>0)?rounds*big.length()/tFast/1e6:0,
+                (tSlow>0)?rounds*big.length()/tSlow/1e6:0);
+        report(0,txt);
+    }
+
+    void checkNoCrc() {
+        report(0, "checking dgrams without crc");
+
+        DgramTest out;
+        int sz = 100;
+        out.openMonitor(sz,sz);
+        out.setCrc(false);
+
+        ManagedBytes msg(200);
+        for (size_t i=0; i<msg.length(); i++) {
+            msg.get()[i] = i%128;
+        }
+        out.beginPacket();
+        out.write(msg.bytes());
+        out.flush();
+        out.endPacket();
+        checkEqual(3,out.size(),"right number of packets");
+
+        DgramTest in;
+        in.openMonitor(sz,sz);
+        in.setCrc(false);
+        ManagedBytes recv(200);
+        in.copyMonitor(out);
+        in.copyMonitor(out);
+        in.corruptDrop(4);
+        int lengths[3];
+        bool good[3];
+        for (int k=0; k<3; k++) {
+            memset(recv.get(),0,recv.length());
+            in.beginPacket();
+            lengths[k] = in.readFull(recv.bytes());
+            in.endPacket();
+            good[k] = memcmp(recv.get(),msg.get(),recv.length())==0;
+        }
+        checkTrue(good[0],"received what is sent");
+        checkEqual(lengths[0],recv.length(),"first length should be full");
+        checkEqual(lengths[1],-1,"dropped dgram still detected");
+
+        // a receiver checking the crc rejects them
+        DgramTest strict;
+        strict.openMonitor(sz,sz);
+        strict.copyMonitor(out);
+        strict.beginPacket();
+        checkEqual(strict.readFull(recv.bytes()),-1,"rejected by a receiver checking crc");
+        strict.endPacket();
+    }
+
     virtual void runTests() {
         checkNormal();
+        checkCrc();
+        checkNoCrc();
     }
 };
 
@@ -7,6 +7,8 @@
 
 #include <yarp/os/Port.h>
 #include <yarp/os/impl/Companion.h>
+#include <yarp/os/impl/Carriers.h>
+#include <yarp/os/impl/DgramTwoWayStream.h>
 #include <yarp/os/Time.h>
 #include <yarp/os/Thread.h>
 #include <yarp/os/Semaphore.h>
@@ -26,6 +28,10 @@
 #include <yarp/os/RpcClient.h>
 #include <yarp/os/RpcServer.h>
 #include <yarp/os/PortInfo.h>
+#include <yarp/os/SizedWriter.h>
+#include <yarp/os/QosStyle.h>
+
+#include <vector>
 
 //#include "TestList.h"
 
@@ -50,6 +56,41 @@ public:
     }
 };
 
+class MessageIdRecorder : public PortWriter {
+public:
+    Semaphore mutex;
+    std::vector<int> ids;
+
+    MessageIdRecorder() : mutex(1) {}
+
+    virtual bool write(ConnectionWriter& connection) {
+        SizedWriter *writer = dynamic_cast<SizedWriter *>(&connection);
+        mutex.wait();
+        ids.push_back((writer!=NULL)?writer->getMessageId():0);
+        mutex.post();
+        Bottle b("1");
+        return b.write(connection);
+    }
+};
+
+class SlowReader : public PortReader {
+public:
+    Semaphore mutex;
+    std::vector<int> values;
+
+    SlowReader() : mutex(1) {}
+
+    virtual bool read(ConnectionReader& connection) {
+        Bottle b;
+        if (!b.read(connection)) return false;
+        mutex.wait();
+        values.push_back(b.get(0).asInt());
+        mutex.post();
+        Time::delay(0.2);
+        return true;
+    }
+};
+
 class ServiceTester : public Portable {
 public:
     UnitTest& owner;
@@ -376,6 +417,99 @@ public:
     }
 
 
+    void testUdpNoCrc() {
+        report(0,"checking udp without crc");
+
+        BufferedPort<Bottle> input;
+        Port output;
+        input.open("/in");
+        output.open("/out");
+        input.setStrict();
+
+        output.addOutput(Contact::byName("/in").addCarrier("udp+crc.0"));
+
+        Bottle bot1;
+        bot1.fromString("1 2 3");
+        for (int i=0; i<1000; i++) {
+            bot1.addInt(i);
+        }
+        Bottle *result = NULL;
+        double timeout = Time::now()+5;
+        while (result==NULL && Time::now()<timeout) {
+            output.write(bot1);
+            result = input.read(false);
+            if (result==NULL) {
+                Time::delay(0.1);
+                result = input.read(false);
+            }
+        }
+        checkTrue(result!=NULL,"got something");
+        if (result!=NULL) {
+            checkEqual(bot1.size(),result->size(),"size check");
+            checkEqual(result->get(result->size()-1).asInt(),999,"content check");
+        }
+
+        // the sender keeps the checksum only if the receiver did not agree
+        // to drop it, so look at the stream the sender ended up with
+        OutputProtocol *op = Carriers::connect(Network::queryName("/in"));
+        checkTrue(op!=NULL,"connected by hand");
+        if (op!=NULL) {
+            checkTrue(op->open(Route("/manual","/in","udp+crc.0")),
+                      "negotiated");
+            DgramTwoWayStream *dgram =
+                dynamic_cast<DgramTwoWayStream*>(&op->getOutputStream());
+            checkTrue(dgram!=NULL,"sending datagrams");
+            if (dgram!=NULL) {
+                checkFalse(dgram->getCrc(),"receiver agreed to skip crc");
+            }
+            op->close();
+            delete op;
+        }
+
+        output.close();
+        input.close();
+    }
+
+    void testUdpStats() {
+        report(0,"checking reception statistics of udp connections");
+
+        BufferedPort<Bottle> input;
+        Port output;
+        input.open("/in");
+        output.open("/out");
+        input.setStrict();
+
+        output.addOutput(Contact::byName("/in").addCarrier("udp"));
+
+        Bottle bot1;
+        bot1.fromString("1 2 3");
+        int got = 0;
+        double timeout = Time::now()+5;
+        while (got<3 && Time::now()<timeout) {
+            output.write(bot1);
+            Time::delay(0.05);
+            while (input.read(false)!=NULL) {
+                got++;
+            }
+        }
+        checkTrue(got>=3,"messages received");
+
+        Bottle cmd, reply;
+        cmd.fromString("prop get /out");
+        NetworkBase::write(Contact::byName("/in"),cmd,reply,true,true);
+        Bottle& stats = reply.findGroup("stats");
+        checkFalse(stats.isNull(),"statistics reported");
+        Bottle *values = stats.get(1).asList();
+        checkTrue(values!=NULL,"statistics reported as a list");
+        if (values!=NULL) {
+            checkTrue(values->find("dgrams").asInt()>=got,"datagrams counted");
+            checkEqual(values->find("dropped").asInt(),0,"nothing dropped");
+        }
+
+        output.close();
+        input.close();
+    }
+
     void testHeavy() {
         report(0,"checking heavy udp");
 
@@ -1408,6 +1542,119 @@ public:
         pout.close();
     }
 
+    void testMessageId() {
+        report(0,"checking messages are identified across connections");
+        Port pout;
+        BufferedPort<Bottle> pin1, pin2;
+        pin1.setStrict();
+        pin2.setStrict();
+        pout.open("/out");
+        pin1.open("/in1");
+        pin2.open("/in2");
+        Network::connect("/out","/in1");
+        Network::connect("/out","/in2");
+        MessageIdRecorder msg;
+        pout.write(msg);
+        pin1.read();
+        pin2.read();
+        pout.write(msg);
+        pin1.read();
+        pin2.read();
+        checkEqual((int)msg.ids.size(),4,"message serialized per connection");
+        if (msg.ids.size()==4) {
+            checkTrue(msg.ids[0]!=0,"message has an id");
+            checkEqual(msg.ids[0],msg.ids[1],"same id on both connections");
+            checkEqual(msg.ids[2],msg.ids[3],"same id on both connections");
+            checkTrue(msg.ids[0]!=msg.ids[2],"new id for a new write");
+        }
+        pout.close();
+        pin1.close();
+        pin2.close();
+    }
+
+    void testQosRate() {
+        report(0,"checking the message rate of a connection can be capped");
+        Port pout;
+        BufferedPort<Bottle> pin1, pin2;
+        pin1.setStrict();
+        pin2.setStrict();
+        pout.open("/out");
+        pin1.open("/in1");
+        pin2.open("/in2");
+        Network::connect("/out","/in1");
+        Network::connect("/out","/in2");
+        QosStyle style;
+        style.setMaxRate(5);
+        checkTrue(Network::setConnectionQos("/out","/in2",style,QosStyle(),false),
+                  "rate set");
+        QosStyle src, dest;
+        checkTrue(Network::getConnectionQos("/out","/in2",src,dest,false),
+                  "rate read back");
+        checkEqual(src.getMaxRate(),5.0,"rate read back correctly");
+        for (int i=0; i<20; i++) {
+            Bottle b;
+            b.addInt(i);
+            pout.write(b);
+            Time::delay(0.02);
+        }
+        Time::delay(0.2);
+        checkEqual(pin1.getPendingReads(),20,"uncapped connection gets everything");
+        int n = pin2.getPendingReads();
+        checkTrue(n>=1 && n<=4,"capped connection gets about 5 messages per second");
+        Bottle *b = pin2.read();
+        checkTrue(b!=NULL && b->get(0).asInt()==0,"first message goes through");
+        pout.close();
+        pin1.close();
+        pin2.close();
+    }
+
+    void testQosDrop() {
+        report(0,"checking a slow connection can skip rather than block");
+        Port pout, pin2;
+        BufferedPort<Bottle> pin1;
+        SlowReader slow;
+        pin1.setStrict();
+        pin2.setReader(slow);
+        pout.open("/out");
+        pin1.open("/in1");
+        pin2.open("/in2");
+        Network::connect("/out","/in1");
+        Network::connect("/out","/in2");
+        QosStyle style;
+        style.setDropWhenBusy(true);
+        checkTrue(Network::setConnectionQos("/out","/in2",style,QosStyle(),false),
+                  "dropping set");
+        double start = Time::now();
+        Bottle b;
+        for (int i=0; i<10; i++) {
+            b.clear();
+            b.addInt(i);
+            pout.write(b);
+            // the copy sent in the background must not see this
+            b.clear();
+            b.addInt(-1);
+            Time::delay(0.02);
+        }
+        double elapsed = Time::now()-start;
+        checkTrue(elapsed<1.0,"writer not held up by the slow connection");
+        Time::delay(0.5);
+        checkEqual(pin1.getPendingReads(),10,"fast connection gets everything");
+        slow.mutex.wait();
+        int n = (int)slow.values.size();
+        bool ordered = true;
+        for (int i=0; i<n; i++) {
+            if (slow.values[i]<0 || (i>0 && slow.values[i]<=slow.values[i-1])) {
+                ordered = false;
+            }
+        }
+        slow.mutex.post();
+        checkTrue(n>=1 && n<10,"slow connection skips messages");
+        checkTrue(ordered,"slow connection gets intact messages in order");
+        pout.close();
+        pin1.close();
+        pin2.close();
+    }
+
     virtual void runTests() {
         NetworkBase::setLocalMode(true);
 
@@ -1416,6 +1663,8 @@ public:
         testPair();
         testReply();
         testUdp();
+        testUdpNoCrc();
+        testUdpStats();
         //testHeavy();
 
         testBackground();
@@ -1465,6 +1714,11 @@ public:
 
         testCallbackLock();
 
+        testMessageId();
+
+        testQosRate();
+        testQosDrop();
+
         NetworkBase::setLocalMode(false);
     }
 };
@@ -7,9 +7,12 @@
 
 #include <yarp/os/impl/String.h>
 #include <yarp/os/Network.h>
+#include <yarp/os/Time.h>
 #include <yarp/dev/PolyDriver.h>
 #include <yarp/dev/FrameGrabberInterfaces.h>
 #include <yarp/dev/ControlBoardInterfaces.h>
+#include <yarp/dev/PolyDriverList.h>
+#include <yarp/dev/Wrapper.h>
 
 #include "TestList.h"
 
@@ -224,10 +227,239 @@ name /mymotor\n\
         int axes = 0;
         pos->getAxes(&axes);
         checkEqual(axes,16,"interface seems functional");
+
+        // the streamed state reaches the client
+        IEncoders *enc = NULL;
+        result = dd2.view(enc);
+        checkTrue(result,"encoder interface reported");
+        double refs[16];
+        for (int i=0; i<16; i++) {
+            refs[i] = i;
+        }
+        pos->positionMove(refs);
+        double encs[16];
+        double timeout = Time::now()+5;
+        bool arrived = false;
+        while (!arrived && Time::now()<timeout) {
+            arrived = enc->getEncoders(encs) && encs[15]==15;
+            if (!arrived) {
+                Time::delay(0.05);
+            }
+        }
+        checkTrue(arrived,"encoders streamed");
+        double v = -1;
+        checkTrue(enc->getEncoder(7,&v),"single encoder read");
+        checkEqual(v,7.0,"single encoder value");
+        checkFalse(enc->getEncoder(16,&v),"no encoder beyond the axes");
+
         result = dd.close() && dd2.close();
         checkTrue(result,"close reported successful");
     }
 
+    void testControlBoardExtrapolation() {
+        report(0,"\ntest the extrapolation of the controlboard state");
+        PolyDriver dd;
+        Property p;
+        p.put("device","controlboardwrapper2");
+        p.put("subdevice","test_motor");
+        p.put("name","/motor");
+        p.put("axes",4);
+        p.put("period",500);
+        bool result;
+        result = dd.open(p);
+        checkTrue(result,"controlboardwrapper open reported successful");
+
+        PolyDriver dd2;
+        Property p2;
+        p2.put("device","remote_controlboard");
+        p2.put("remote","/motor");
+        p2.put("local","/motor/client");
+        p2.put("carrier","tcp");
+        p2.put("ignoreProtocolCheck","true");
+        p2.put("timeout",2.0);
+        p2.put("extrapolation",1.0);
+        result = dd2.open(p2);
+        checkTrue(result,"remote_controlboard open reported successful");
+
+        if(!result)   return;  // cannot go on if the device was not opened
+
+        IVelocityControl *vel = NULL;
+        IEncodersTimed *enc = NULL;
+        dd2.view(vel);
+        dd2.view(enc);
+        checkTrue(vel!=NULL && enc!=NULL,"interfaces reported");
+        double spds[4] = { 10, 10, 10, 10 };
+        vel->velocityMove(spds);
+        double timeout = Time::now()+5;
+        bool moving = false;
+        while (!moving && Time::now()<timeout) {
+            moving = enc->getEncoderSpeeds(spds) && spds[0]==10;
+            if (!moving) {
+                Time::delay(0.05);
+            }
+        }
+        checkTrue(moving,"velocity streamed");
+
+        // positions move with the time of the call, not with the
+        // arrival of the state; the reads usually fall between two
+        // states, and the tolerance leaves room for scheduling delays
+        double e1[4], e2[4], t1[4], t2[4];
+        checkTrue(enc->getEncodersTimed(e1,t1),"first read");
+        Time::delay(0.1);
+        checkTrue(enc->getEncodersTimed(e2,t2),"second read");
+        checkTrue(t2[0]>t1[0],"stamp moves between reads");
+        if (t2[0]>t1[0]) {
+            double rate = (e2[0]-e1[0])/(t2[0]-t1[0]);
+            checkTrue(rate>5 && rate<15,"extrapolated with the velocity");
+        }
+
+        // without a server the state gets stale
+        dd.close();
+        timeout = Time::now()+10;
+        bool stale = false;
+        while (!stale && Time::now()<timeout) {
+            stale = !enc->getEncoderSpeeds(spds);
+            if (!stale) {
+                Time::delay(0.1);
+            }
+        }
+        checkTrue(stale,"stale state rejected");
+        checkFalse(enc->getEncoders(e1),"stale encoders rejected");
+        dd2.close();
+    }
+
+    void testControlBoardLatest() {
+        report(0,"\ntest the latest-wins streaming of the controlboard wrapper");
+        PolyDriver dd;
+        Property p;
+        p.put("device","controlboardwrapper2");
+        p.put("subdevice","test_motor");
+        p.put("name","/motor");
+        p.put("axes",4);
+        p.put("period",20);
+        p.put("streaming_mode","latest");
+        bool result;
+        result = dd.open(p);
+        checkTrue(result,"controlboardwrapper open reported successful");
+
+        PolyDriver dd2;
+        Property p2;
+        p2.put("device","remote_controlboard");
+        p2.put("remote","/motor");
+        p2.put("local","/motor/client");
+        p2.put("carrier","tcp");
+        p2.put("ignoreProtocolCheck","true");
+        result = dd2.open(p2);
+        checkTrue(result,"remote_controlboard open reported successful");
+
+        if(!result)   return;  // cannot go on if the device was not opened
+
+        IVelocityControl *vel = NULL;
+        IEncodersTimed *enc = NULL;
+        dd2.view(vel);
+        dd2.view(enc);
+        checkTrue(vel!=NULL && enc!=NULL,"interfaces reported");
+
+        // a burst on one joint must neither lose the last value nor the
+        // value of another joint streamed before it
+        vel->velocityMove(1,7);
+        for (int i=0; i<=100; i++) {
+            vel->velocityMove(0,i);
+        }
+        double spds[4] = { 0, 0, 0, 0 };
+        double timeout = Time::now()+5;
+        bool applied = false;
+        while (!applied && Time::now()<timeout) {
+            applied = enc->getEncoderSpeeds(spds) && spds[0]==100 && spds[1]==7;
+            if (!applied) {
+                Time::delay(0.05);
+            }
+        }
+        checkEqual(spds[0],100.0,"latest value of the burst applied");
+        checkEqual(spds[1],7.0,"value of the other joint kept");
+
+        dd2.close();
+        dd.close();
+    }
+
+    void testControlBoardParts() {
+        report(0,"\ntest the state of several parts merged by the controlboard wrapper");
+        PolyDriver part1, part2;
+        Property p1;
+        p1.put("device","test_motor");
+        p1.put("axes",2);
+        checkTrue(part1.open(p1),"first part open");
+        Property p2;
+        p2.put("device","test_motor");
+        p2.put("axes",4);
+        checkTrue(part2.open(p2),"second part open");
+
+        PolyDriver dd;
+        Property p;
+        p.fromString("(device controlboardwrapper2) (name /motor) (period 20) (joints 5) (networks (part1 part2)) (part1 0 1 0 1) (part2 2 4 1 3)");
+        bool result;
+        result = dd.open(p);
+        checkTrue(result,"controlboardwrapper open reported successful");
+
+        IMultipleWrapper *wrapper = NULL;
+        dd.view(wrapper);
+        checkTrue(wrapper!=NULL,"wrapper interface reported");
+        if (!result || wrapper==NULL) return;
+        PolyDriverList parts;
+        parts.push(&part1,"part1");
+        parts.push(&part2,"part2");
+        checkTrue(wrapper->attachAll(parts),"parts attached");
+
+        PolyDriver dd2;
+        Property p2c;
+        p2c.put("device","remote_controlboard");
+        p2c.put("remote","/motor");
+        p2c.put("local","/motor/client");
+        p2c.put("carrier","tcp");
+        p2c.put("ignoreProtocolCheck","true");
+        result = dd2.open(p2c);
+        checkTrue(result,"remote_controlboard open reported successful");
+
+        if(!result)   return;  // cannot go on if the device was not opened
+
+        IVelocityControl *vel = NULL;
+        IEncodersTimed *enc = NULL;
+        dd2.view(vel);
+        dd2.view(enc);
+        checkTrue(vel!=NULL && enc!=NULL,"interfaces reported");
+        int axes = 0;
+        enc->getAxes(&axes);
+        checkEqual(axes,5,"joints of both parts");
+
+        double spds[5] = { 1, 2, 3, 4, 5 };
+        vel->velocityMove(spds);
+        double got[5] = { 0, 0, 0, 0, 0 };
+        double timeout = Time::now()+5;
+        bool moving = false;
+        while (!moving && Time::now()<timeout) {
+            moving = enc->getEncoderSpeeds(got) && got[4]==5;
+            if (!moving) {
+                Time::delay(0.05);
+            }
+        }
+        for (int i=0; i<5; i++) {
+            checkEqual(got[i],spds[i],"speed of the joint in the merged state");
+        }
+
+        // the second part maps joints 1 to 3 of its device
+        IEncoders *enc2 = NULL;
+        part2.view(enc2);
+        double own[4] = { 0, 0, 0, 0 };
+        checkTrue(enc2!=NULL && enc2->getEncoderSpeeds(own),"second part read");
+        checkEqual(own[1],3.0,"wrapper joint 2 is joint 1 of the second part");
+
+        dd2.close();
+        wrapper->detachAll();
+        dd.close();
+        part2.close();
+        part1.close();
+    }
+
     virtual void runTests() {
         Network::setLocalMode(true);
         Drivers::factory().add(new DriverCreatorOf<DeviceDriverTest>("devicedrivertest",
@@ -246,6 +478,9 @@ name /mymotor\n\
         testControlBoard();
 #endif // YARP_NO_DEPRECATED
         testControlBoard2();
+        testControlBoardExtrapolation();
+        testControlBoardLatest();
+        testControlBoardParts();
         Network::setLocalMode(false);
     }
 };
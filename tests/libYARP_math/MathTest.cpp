@@ -547,6 +547,7 @@ public:
         eigenTest();
         elementTest();
         catAndPileTest();
+        inPlaceOps();
     }
 
     void eulerTests()
@@ -693,6 +694,67 @@ public:
         assertEqual(cat(1.0, 2.0, 3.0, 4.0, 5.0), f, " cat(n1, n2, n3, n4, n5)=[n1, n2, n3, n4, n5] " );
     }
 
+    void inPlaceOps()
+    {
+        report(0, "checking operations on preallocated storage...");
+        Matrix J(6,7), K(6,6), H(4,4), M;
+        Vector q(7), xd(6), x(6), e, y(6), v;
+        for (int r=0; r<J.rows(); r++)
+            for (int c=0; c<J.cols(); c++)
+                J(r,c)=Rand::scalar(-1,1);
+        for (int r=0; r<K.rows(); r++)
+            for (int c=0; c<K.cols(); c++)
+                K(r,c)=Rand::scalar(-1,1);
+        for (size_t i=0; i<q.size(); i++)
+            q[i]=Rand::scalar(-1,1);
+        for (size_t i=0; i<x.size(); i++)
+        {
+            x[i]=Rand::scalar(-1,1);
+            xd[i]=Rand::scalar(-1,1);
+        }
+
+        checkTrue(sub(xd,x,e), "sub() succeeds");
+        assertEqual(e, xd-x, "sub(a,b,res)=a-b");
+        checkTrue(add(xd,x,v), "add() succeeds");
+        assertEqual(v, xd+x, "add(a,b,res)=a+b");
+        checkTrue(mul(2.0,x,v), "scalar mul() succeeds");
+        assertEqual(v, 2.0*x, "mul(k,a,res)=k*a");
+        checkTrue(mul(J,q,y), "matrix-vector mul() succeeds");
+        assertEqual(y, J*q, "mul(m,a,res)=m*a");
+        checkTrue(mul(x,J,v), "vector-matrix mul() succeeds");
+        assertEqual(v, x*J, "mul(a,m,res)=a*m");
+        checkTrue(gemv(1.0,K,e,1.0,y), "gemv() succeeds");
+        assertEqual(y, J*q+K*(xd-x), "J*q+K*(xd-x) without temporaries");
+        v=x;
+        checkTrue(axpy(0.5,xd,v), "axpy() succeeds");
+        assertEqual(v, x+0.5*xd, "axpy(k,x,y) gives y+k*x");
+        checkTrue(mul(K,J,M), "matrix-matrix mul() succeeds");
+        assertEqual(M, K*J, "mul(a,b,res)=a*b");
+        checkFalse(mul(J,K,M), "mul() rejects mismatching sizes");
+        checkFalse(mul(K,x,x), "mul() rejects aliased result");
+        checkTrue(cat(x,q,v), "cat() succeeds");
+        assertEqual(v, cat(x,q), "cat(v1,v2,res)=[v1 v2]");
+        checkTrue(cat(J,K,M), "matrix cat() succeeds");
+        assertEqual(M, cat(J,K), "cat(m1,m2,res)=[m1 m2]");
+        checkTrue(pile(K,K,M), "pile() succeeds");
+        assertEqual(M, pile(K,K), "pile(m1,m2,res)=[m1; m2]");
+        checkTrue(outerProduct(x,xd,M), "outerProduct() succeeds");
+        assertEqual(M, outerProduct(x,xd), "outerProduct(a,b,res)=a*b'");
+
+        Vector rpy(3);
+        rpy[0]=0.3; rpy[1]=-0.2; rpy[2]=1.1;
+        H=rpy2dcm(rpy);
+        H(0,3)=0.1; H(1,3)=-0.4; H(2,3)=0.25;
+        checkTrue(SE3inv(H,M), "SE3inv() succeeds");
+        assertEqual(M, SE3inv(H), "SE3inv(H,res)=SE3inv(H)");
+        assertEqual(M*H, eye(4,4), "SE3inv(H,res)*H=I");
+        checkTrue(adjoint(H,M), "adjoint() succeeds");
+        assertEqual(M, adjoint(H), "adjoint(H,res)=adjoint(H)");
+        Matrix Hinv(H);
+        checkTrue(SE3inv(Hinv,Hinv), "SE3inv() in place succeeds");
+        assertEqual(Hinv, SE3inv(H), "SE3inv(H,H)=SE3inv(H)");
+    }
+
 };
 
 static MathTest theMathTest;
@@ -24,6 +24,8 @@ namespace yarp {
 extern yarp::os::impl::UnitTest& getMathTest();
 extern yarp::os::impl::UnitTest& getSVDTest();
 extern yarp::os::impl::UnitTest& getRandTest();
+extern yarp::os::impl::UnitTest& getTransformTest();
+extern yarp::os::impl::UnitTest& getLinearSolversTest();
 
 class yarp::os::impl::TestList {
 public:
@@ -32,6 +34,8 @@ public:
         root.add(getMathTest());
         root.add(getSVDTest());
         root.add(getRandTest());
+        root.add(getTransformTest());
+        root.add(getLinearSolversTest());
     }
 };
 
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2016 iCub Facility - Istituto Italiano di Tecnologia
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ *
+ */
+
+/**
+ * \infile Tests for LUSolver and CholeskySolver.
+ */
+
+#include <yarp/os/impl/UnitTest.h>
+
+#include <yarp/sig/Vector.h>
+#include <yarp/sig/Matrix.h>
+#include <yarp/math/Math.h>
+#include <yarp/math/Rand.h>
+#include <yarp/math/LinearSolvers.h>
+#include <math.h>
+
+using namespace yarp::os::impl;
+using namespace yarp::sig;
+using namespace yarp::math;
+
+const double TOL = 1e-8;
+
+class LinearSolversTest : public UnitTest {
+    bool near(const Matrix &A, const Matrix &B)
+    {
+        if ((A.rows()!=B.rows()) || (A.cols()!=B.cols()))
+            return false;
+        for (int r=0; r<A.rows(); r++)
+            for (int c=0; c<A.cols(); c++)
+                if (fabs(A(r,c)-B(r,c))>TOL)
+                    return false;
+        return true;
+    }
+
+    bool near(const Vector &a, const Vector &b)
+    {
+        if (a.length()!=b.length())
+            return false;
+        for (size_t i=0; i<a.length(); i++)
+            if (fabs(a[i]-b[i])>TOL)
+                return false;
+        return true;
+    }
+
+public:
+    virtual String getName() { return "LinearSolversTest"; }
+
+    void lu()
+    {
+        report(0,"checking LUSolver");
+
+        int n=6;
+        Matrix A;
+        do
+        {
+            A=Rand::matrix(n,n);
+        } while (fabs(det(A))<TOL);
+
+        Vector b=Rand::vector(n), x;
+        LUSolver solver(n);
+        checkTrue(solver.factorize(A),"factorization");
+        checkTrue(solver.solve(b,x),"solve");
+        checkTrue(near(A*x,b),"solution of A*x=b");
+
+        Matrix Ainv;
+        checkTrue(solver.inverse(Ainv),"inverse");
+        checkTrue(near(A*Ainv,eye(n)),"inverse matches");
+        checkTrue(fabs(solver.det()-det(A))<TOL,"determinant matches det()");
+
+        Vector y=b;
+        checkTrue(solver.solve(y,y) && near(y,x),"solve in place");
+
+        // the storage is reallocated for a different size
+        Matrix B=A.submatrix(0,n-2,0,n-2)+eye(n-1)*10.0;
+        checkTrue(solver.factorize(B),"factorization of a smaller matrix");
+        checkTrue(solver.inverse(Ainv) && near(B*Ainv,eye(n-1)),"inverse of a smaller matrix");
+
+        checkFalse(solver.factorize(zeros(n,n)),"singular matrix detected");
+        checkFalse(solver.solve(b,x),"singular matrix is not solved");
+        checkFalse(solver.factorize(zeros(n,n+1)),"non square matrix detected");
+    }
+
+    void cholesky()
+    {
+        report(0,"checking CholeskySolver");
+
+        int n=6;
+        Matrix J=Rand::matrix(n,n+1);
+        Matrix A=J*J.transposed()+eye(n)*0.01;
+
+        Vector b=Rand::vector(n), x;
+        CholeskySolver solver(n);
+        checkTrue(solver.factorize(A),"factorization");
+        checkTrue(solver.solve(b,x),"solve");
+        checkTrue(near(A*x,b),"solution of A*x=b");
+
+        Matrix Ainv;
+        checkTrue(solver.inverse(Ainv),"inverse");
+        checkTrue(near(A*Ainv,eye(n)),"inverse matches");
+
+        Vector y=b;
+        checkTrue(solver.solve(y,y) && near(y,x),"solve in place");
+
+        checkFalse(solver.factorize(-1.0*eye(n)),"non positive definite matrix detected");
+        checkFalse(solver.solve(b,x),"failed factorization is not solved");
+    }
+
+    virtual void runTests()
+    {
+        lu();
+        cholesky();
+    }
+};
+
+static LinearSolversTest theLinearSolversTest;
+
+UnitTest& getLinearSolversTest() {
+    return theLinearSolversTest;
+}
@@ -254,6 +254,45 @@ public:
         }
     }
 
+    void svdSolver()
+    {
+        report(0, "checking SVDSolver");
+
+        SVDSolver golub(6,7), jacobi(6,7,SVDSolver::Jacobi);
+        Matrix Minv, Mpinv, S;
+        for(int shape=0; shape<3; shape++)
+        {
+            int m=(shape==1)?7:6, n=(shape==2)?7:6, k=m<n?m:n;
+            Matrix M = Rand::matrix(m,n)*10;
+
+            for(int j=0; j<2; j++)
+            {
+                SVDSolver &solver = (j==0)?golub:jacobi;
+                string method = (j==0)?" (Golub-Reinsch)":" (Jacobi)";
+
+                checkTrue(solver.decompose(M), ("SVDSolver decomposition"+method).c_str());
+                S.resize(k,k);
+                S.diagonal(solver.getS());
+                assertEqual(solver.getU()*S*solver.getV().transposed(), M, "SVDSolver U*S*V^T"+method);
+                assertEqual(solver.getU().transposed()*solver.getU(), eye(k), "SVDSolver U is orthogonal"+method);
+                assertEqual(solver.getV().transposed()*solver.getV(), eye(k), "SVDSolver V is orthogonal"+method);
+                for(int c=1; c<k; c++)
+                    checkTrue(solver.getS()[c-1]>=solver.getS()[c], ("SVDSolver singular values are sorted"+method).c_str());
+
+                checkTrue(solver.pinv(M, Minv, TOL), ("SVDSolver pinv"+method).c_str());
+                assertEqual(Minv, pinv(M, TOL), "SVDSolver pinv matches pinv()"+method);
+
+                checkTrue(solver.pinvDamped(M, Minv, 0.1), ("SVDSolver pinvDamped"+method).c_str());
+                assertEqual(Minv, pinvDamped(M, 0.1), "SVDSolver pinvDamped matches pinvDamped()"+method);
+            }
+        }
+
+        // rank deficient matrix
+        Matrix M = Rand::matrix(6,3)*Rand::matrix(3,7);
+        jacobi.pinv(M, Minv, 1e-6);
+        assertEqual(M*Minv*M, M, "SVDSolver pinv of rank deficient matrix (Jacobi)");
+    }
+
     virtual void runTests() 
     {
         svd();
@@ -263,6 +302,7 @@ public:
         pInvDamp();
         projMat();
         nullspaceMat();
+        svdSolver();
     }
 };
 
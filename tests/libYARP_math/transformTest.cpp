@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2016 iCub Facility - Istituto Italiano di Tecnologia
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ *
+ */
+
+/**
+ * \infile Tests for the fixed-size Quaternion, Rotation3 and Transform3.
+ */
+
+#include <yarp/os/impl/UnitTest.h>
+
+#include <yarp/sig/Vector.h>
+#include <yarp/sig/Matrix.h>
+#include <yarp/math/Math.h>
+#include <yarp/math/Quaternion.h>
+#include <yarp/math/Rotation3.h>
+#include <yarp/math/Transform3.h>
+#include <math.h>
+
+using namespace yarp::os::impl;
+using namespace yarp::sig;
+using namespace yarp::math;
+
+class TransformTest : public UnitTest {
+    bool near(const Matrix &A, const Matrix &B, double tol=1e-9)
+    {
+        if ((A.rows()!=B.rows()) || (A.cols()!=B.cols()))
+            return false;
+        for (int r=0; r<A.rows(); r++)
+            for (int c=0; c<A.cols(); c++)
+                if (fabs(A(r,c)-B(r,c))>tol)
+                    return false;
+        return true;
+    }
+
+    bool near(const Vector &a, const Vector &b, double tol=1e-9)
+    {
+        if (a.length()!=b.length())
+            return false;
+        for (size_t i=0; i<a.length(); i++)
+            if (fabs(a[i]-b[i])>tol)
+                return false;
+        return true;
+    }
+
+    Matrix homogeneous(double roll, double pitch, double yaw,
+                       double x, double y, double z)
+    {
+        Vector rpy(3);
+        rpy[0]=roll; rpy[1]=pitch; rpy[2]=yaw;
+        Matrix H=rpy2dcm(rpy);
+        H(0,3)=x; H(1,3)=y; H(2,3)=z;
+        return H;
+    }
+
+public:
+    virtual String getName() { return "TransformTest"; }
+
+    void checkRotation()
+    {
+        report(0,"checking Rotation3 against the Matrix functions");
+
+        Vector rpy(3);
+        rpy[0]=0.3; rpy[1]=-0.7; rpy[2]=1.9;
+        Rotation3 R=Rotation3::fromRPY(rpy[0],rpy[1],rpy[2]);
+        checkTrue(near(R.toMatrix(),rpy2dcm(rpy)),"fromRPY() matches rpy2dcm()");
+
+        Vector v(3);
+        R.toRPY(v[0],v[1],v[2]);
+        checkTrue(near(v,dcm2rpy(rpy2dcm(rpy))),"toRPY() matches dcm2rpy()");
+
+        Vector axis(4);
+        axis[0]=1.0; axis[1]=-2.0; axis[2]=0.5; axis[3]=0.8;
+        double n=sqrt(axis[0]*axis[0]+axis[1]*axis[1]+axis[2]*axis[2]);
+        axis[0]/=n; axis[1]/=n; axis[2]/=n;
+        R=Rotation3::fromAxisAngle(axis[0],axis[1],axis[2],axis[3]);
+        checkTrue(near(R.toMatrix(),axis2dcm(axis)),"fromAxisAngle() matches axis2dcm()");
+
+        Vector a(4);
+        R.toAxisAngle(a.data());
+        checkTrue(near(a,dcm2axis(axis2dcm(axis))),"toAxisAngle() matches dcm2axis()");
+
+        Rotation3 Rpi=Rotation3::fromAxisAngle(axis[0],axis[1],axis[2],M_PI);
+        Rpi.toAxisAngle(a.data());
+        checkTrue(fabs(a[3]-M_PI)<1e-9,"toAxisAngle() finds the angle pi");
+        checkTrue(fabs(fabs(a[0]*axis[0]+a[1]*axis[1]+a[2]*axis[2])-1.0)<1e-9,
+                  "toAxisAngle() finds the axis of a rotation of pi");
+
+        Rotation3 I;
+        I.toAxisAngle(a.data());
+        checkTrue(fabs(a[3])<1e-12,"toAxisAngle() of the identity");
+
+        Rotation3 R1=Rotation3::fromRPY(0.1,0.2,0.3);
+        Rotation3 R2=Rotation3::fromRPY(-1.1,0.4,2.3);
+        checkTrue(near((R1*R2).toMatrix(),R1.toMatrix()*R2.toMatrix()),"composition");
+        checkTrue(near((R1*R1.transposed()).toMatrix(),eye(4,4)),"transposed() is the inverse");
+
+        double p[3]={1.0,2.0,3.0};
+        double q[3];
+        R1.apply(p,q);
+        Vector ph(4,1.0); ph[0]=p[0]; ph[1]=p[1]; ph[2]=p[2];
+        Vector qh=R1.toMatrix()*ph;
+        checkTrue((fabs(q[0]-qh[0])<1e-12) && (fabs(q[1]-qh[1])<1e-12) &&
+                  (fabs(q[2]-qh[2])<1e-12),"apply()");
+    }
+
+    void checkQuaternion()
+    {
+        report(0,"checking Quaternion against the Matrix functions");
+
+        Rotation3 R1=Rotation3::fromRPY(0.1,0.2,0.3);
+        Rotation3 R2=Rotation3::fromRPY(-1.1,0.4,2.3);
+        Matrix H1=R1.toMatrix();
+        Matrix H2=R2.toMatrix();
+
+        checkTrue(near(R1.toQuaternion().toVector(),dcm2quat(H1)),"toQuaternion() matches dcm2quat()");
+
+        // exercise the branches with a negative trace
+        Rotation3 R3=Rotation3::fromAxisAngle(0.0,1.0,0.0,3.0);
+        Rotation3 R4=Rotation3::fromAxisAngle(0.0,0.0,1.0,3.0);
+        Rotation3 R5=Rotation3::fromAxisAngle(1.0,0.0,0.0,3.0);
+        checkTrue(near(R3.toQuaternion().toVector(),dcm2quat(R3.toMatrix())),"toQuaternion() y branch");
+        checkTrue(near(R4.toQuaternion().toVector(),dcm2quat(R4.toMatrix())),"toQuaternion() z branch");
+        checkTrue(near(R5.toQuaternion().toVector(),dcm2quat(R5.toMatrix())),"toQuaternion() x branch");
+
+        Vector qv=dcm2quat(H1);
+        checkTrue(near(Rotation3(Quaternion(qv)).toMatrix(),quat2dcm(qv)),"Rotation3(Quaternion) matches quat2dcm()");
+
+        Quaternion q12=R1.toQuaternion()*R2.toQuaternion();
+        checkTrue(near(Rotation3(q12).toMatrix(),H1*H2),"product of quaternions matches the product of rotations");
+
+        Quaternion q1=R1.toQuaternion();
+        checkTrue(near(Rotation3(q1.conjugate()).toMatrix(),H1.transposed()),"conjugate() is the inverse");
+    }
+
+    void checkTransform()
+    {
+        report(0,"checking Transform3 against the Matrix functions");
+
+        Matrix H1=homogeneous(0.1,0.2,0.3,1.0,-2.0,0.5);
+        Matrix H2=homogeneous(-1.1,0.4,2.3,0.3,0.7,-1.2);
+        Transform3 T1(H1);
+        Transform3 T2(H2);
+
+        checkTrue(near(T1.toMatrix(),H1),"round trip with Matrix");
+        checkTrue(near((T1*T2).toMatrix(),H1*H2),"composition");
+        checkTrue(near(T1.inverse().toMatrix(),SE3inv(H1)),"inverse() matches SE3inv()");
+
+        Matrix A;
+        T1.adjoint(A);
+        checkTrue(near(A,adjoint(H1)),"adjoint() matches adjoint()");
+
+        double p[3]={1.0,2.0,3.0};
+        double q[3];
+        T1.apply(p,q);
+        Vector ph(4,1.0); ph[0]=p[0]; ph[1]=p[1]; ph[2]=p[2];
+        Vector qh=H1*ph;
+        checkTrue((fabs(q[0]-qh[0])<1e-12) && (fabs(q[1]-qh[1])<1e-12) &&
+                  (fabs(q[2]-qh[2])<1e-12),"apply()");
+    }
+
+    virtual void runTests()
+    {
+        checkRotation();
+        checkQuaternion();
+        checkTransform();
+    }
+};
+
+static TransformTest theTransformTest;
+
+UnitTest& getTransformTest() {
+    return theTransformTest;
+}
@@ -16,12 +16,16 @@
 #include <yarp/os/impl/BufferedConnectionWriter.h>
 #include <yarp/sig/Image.h>
 #include <yarp/sig/ImageDraw.h>
+#include <yarp/sig/ImageResample.h>
 #include <yarp/os/Network.h>
 #include <yarp/os/PortReaderBuffer.h>
 #include <yarp/os/Port.h>
 #include <yarp/os/Bottle.h>
 #include <yarp/os/Time.h>
 
+#include <cmath>
+#include <cstring>
+
 #include "TestList.h"
 
 using namespace yarp::os::impl;
@@ -265,6 +269,49 @@ public:
     }
 
 
+    void testReadConversion() {
+        report(0,"testing conversion while reading...");
+
+        // several chunks plus a partial one, with padding on both sides
+        ImageOf<PixelBgr> img1;
+        img1.setQuantum(1);
+        img1.resize(301,200);
+        for (int x=0; x<img1.width(); x++) {
+            for (int y=0; y<img1.height(); y++) {
+                PixelBgr& pixel = img1.pixel(x,y);
+                pixel.r = x;
+                pixel.g = y;
+                pixel.b = 42;
+            }
+        }
+
+        ImageOf<PixelRgb> img2;
+        bool ok = Portable::copyPortable(img1,img2);
+        checkTrue(ok,"read reported successful");
+        checkEqual(img2.width(),img1.width(),"width check");
+        checkEqual(img2.height(),img1.height(),"height check");
+        unsigned char *mem = img2.getRawImage();
+        ok = Portable::copyPortable(img1,img2);
+        checkTrue(ok,"second read reported successful");
+        checkTrue(mem==img2.getRawImage(),"image storage reused");
+        if (img1.width()==img2.width() &&
+            img1.height()==img2.height()) {
+            int mismatch = 0;
+            for (int x=0; x<img1.width(); x++) {
+                for (int y=0; y<img1.height(); y++) {
+                    PixelBgr& pix0 = img1.pixel(x,y);
+                    PixelRgb& pix1 = img2.pixel(x,y);
+                    if (pix0.r!=pix1.r ||
+                        pix0.g!=pix1.g ||
+                        pix0.b!=pix1.b) {
+                        mismatch++;
+                    }
+                }
+            }
+            checkEqual(mismatch,0,"pixel match check");
+        }
+    }
+
     void testPadding() {
         report(0,"checking image padding...");
         ImageOf<PixelMono> img1;
@@ -362,6 +409,126 @@ public:
 
     // test row pointer access (getRow())
     // this function only tests if getRow(r)[c] is consistent with the operator ()
+    bool samePixels(const Image& a, const Image& b) {
+        if (a.width()!=b.width() || a.height()!=b.height()) return false;
+        for (int y=0; y<a.height(); y++) {
+            if (memcmp(a.getRow(y),b.getRow(y),a.width()*a.getPixelSize())!=0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void testResample() {
+        report(0,"testing resampling...");
+        using namespace yarp::sig::resample;
+
+        // a flat image stays flat with every method and pixel type
+        ImageOf<PixelRgb> rgb;
+        rgb.resize(97,61);
+        rgb.zero();
+        for (int x=0; x<rgb.width(); x++) {
+            for (int y=0; y<rgb.height(); y++) {
+                rgb(x,y) = PixelRgb(10,200,255);
+            }
+        }
+        ImageOf<PixelFloat> flt;
+        flt.resize(97,61);
+        ImageOf<PixelMono16> m16;
+        m16.resize(97,61);
+        for (int x=0; x<flt.width(); x++) {
+            for (int y=0; y<flt.height(); y++) {
+                flt(x,y) = 1.5f;
+                m16(x,y) = 60000;
+            }
+        }
+        int methods[] = { METHOD_NEAREST, METHOD_AREA, METHOD_BILINEAR, METHOD_CUBIC };
+        for (int m=0; m<4; m++) {
+            ImageOf<PixelRgb> rgb2;
+            ImageOf<PixelFloat> flt2;
+            ImageOf<PixelMono16> m162;
+            checkTrue(resize(rgb,rgb2,40,30,methods[m]),"rgb shrink");
+            checkTrue(resize(flt,flt2,200,100,methods[m]),"float grow");
+            checkTrue(resize(m16,m162,33,20,methods[m]),"mono16 shrink");
+            int bad = 0;
+            for (int x=0; x<rgb2.width(); x++) {
+                for (int y=0; y<rgb2.height(); y++) {
+                    PixelRgb& p = rgb2(x,y);
+                    if (p.r!=10 || p.g!=200 || p.b!=255) bad++;
+                }
+            }
+            for (int x=0; x<m162.width(); x++) {
+                for (int y=0; y<m162.height(); y++) {
+                    if (m162(x,y)!=60000) bad++;
+                }
+            }
+            for (int x=0; x<flt2.width(); x++) {
+                for (int y=0; y<flt2.height(); y++) {
+                    if (fabs(flt2(x,y)-1.5f)>1e-5) bad++;
+                }
+            }
+            checkEqual(bad,0,"flat image stays flat");
+        }
+
+        // halving averages 2x2 blocks
+        ImageOf<PixelMono> mono;
+        mono.resize(8,6);
+        for (int x=0; x<mono.width(); x++) {
+            for (int y=0; y<mono.height(); y++) {
+                mono(x,y) = (x%2)*100+(y%2)*20;
+            }
+        }
+        ImageOf<PixelMono> half;
+        checkTrue(resize(mono,half,4,3,METHOD_AREA),"area shrink");
+        checkEqual(half.width(),4,"area width");
+        checkEqual(half.height(),3,"area height");
+        checkEqual((int)half(1,1),60,"area average");
+        checkTrue(resize(mono,half,4,3,METHOD_BILINEAR),"bilinear shrink");
+        checkEqual((int)half(2,2),60,"bilinear between the samples");
+
+        // averages ending in .5 round up, whether they are stored by the
+        // vectorized part of a row or by its tail
+        ImageOf<PixelMono> halves;
+        halves.resize(44,6);
+        for (int x=0; x<halves.width(); x++) {
+            for (int y=0; y<halves.height(); y++) {
+                halves(x,y) = (x/2)%5*2+x%2;
+            }
+        }
+        checkTrue(resize(halves,half,22,3,METHOD_AREA),"area shrink to halves");
+        int wrong = 0;
+        for (int x=0; x<half.width(); x++) {
+            for (int y=0; y<half.height(); y++) {
+                if (half(x,y)!=x%5*2+1) wrong++;
+            }
+        }
+        checkEqual(wrong,0,"halves round up across the row");
+
+        // nearest matches copy(alt,w,h)
+        ImageOf<PixelRgb> a, b;
+        a.copy(rgb,33,17);
+        resize(rgb,b,33,17,METHOD_NEAREST);
+        checkTrue(samePixels(a,b),"nearest matches copy");
+
+        // a large image gives the same result on several threads
+        ImageOf<PixelRgb> big;
+        big.resize(640,480);
+        for (int x=0; x<big.width(); x++) {
+            for (int y=0; y<big.height(); y++) {
+                big(x,y) = PixelRgb(x,y,x+y);
+            }
+        }
+        ImageOf<PixelRgb> one, four;
+        resize(big,one,320,240,METHOD_CUBIC,1);
+        resize(big,four,320,240,METHOD_CUBIC,4);
+        checkTrue(samePixels(one,four),"threads give the same result");
+
+        // converted to the type of the destination
+        ImageOf<PixelMono> grey;
+        checkTrue(resize(rgb,grey,20,10,METHOD_AREA),"resize to another type");
+        checkEqual(grey.width(),20,"converted width");
+    }
+
     void testRowPointer()
     {
         report(0,"checking row pointer...");
@@ -560,6 +727,8 @@ public:
         testCreate();
         bool netMode = Network::setLocalMode(true);
         testTransmit();
+        testReadConversion();
+        testResample();
         Network::setLocalMode(netMode);
         testCopy();
         testCast();
@@ -6,11 +6,15 @@
  */
 
 #include <yarp/sig/Sound.h>
+#include <yarp/sig/SoundFile.h>
 #include <yarp/os/Network.h>
 #include <yarp/os/BufferedPort.h>
 
 #include "TestList.h"
 
+#include <cstdio>
+#include <cmath>
+
 using namespace yarp::os::impl;
 using namespace yarp::sig;
 using namespace yarp::os;
@@ -39,6 +43,215 @@ public:
     }
 
 
+    void checkBulkAccess() {
+        report(0,"check bulk access to channels...");
+        Sound snd;
+        snd.resize(100,2);
+        for (int i=0; i<snd.getSamples(); i++) {
+            snd.set(i,i,0);
+            snd.set(-i,i,1);
+        }
+        const Sound& csnd = snd;
+        checkEqual(10,(int)csnd.getChannelData(0)[10],"channel 0 data");
+        checkEqual(-10,(int)csnd.getChannelData(1)[10],"channel 1 data");
+        snd.getChannelData(1)[20] = 1234;
+        checkEqual(1234,snd.get(20,1),"write through channel data");
+
+        Sound sub = snd.subSound(10,20);
+        checkEqual(10,sub.getSamples(),"subsound length");
+        checkEqual(-15,(int)sub.getChannelData(1)[5],"subsound data");
+    }
+
+    void checkAppend() {
+        report(0,"check append...");
+        Sound snd, part;
+        snd.setFrequency(16000);
+        part.setFrequency(16000);
+        part.resize(10,2);
+        int total = 0;
+        bool ok = true;
+        for (int k=0; k<50; k++) {
+            for (int i=0; i<10; i++) {
+                part.set(k*10+i,i,0);
+                part.set(-(k*10+i),i,1);
+            }
+            ok = ok && snd.append(part);
+            total += 10;
+        }
+        checkTrue(ok,"append succeeded");
+        checkEqual(total,snd.getSamples(),"sample count after append");
+        checkEqual(2,snd.getChannels(),"channel count after append");
+        for (int i=0; i<total; i++) {
+            ok = ok && ((short)snd.get(i,0)==i) && ((short)snd.get(i,1)==-i);
+        }
+        checkTrue(ok,"samples after append");
+
+        snd += snd;
+        checkEqual(2*total,snd.getSamples(),"self append");
+        checkEqual(total-1,(int)(short)snd.get(2*total-1,0),"self append data");
+
+        Sound mono;
+        mono.resize(10,1);
+        mono.setFrequency(16000);
+        checkFalse(snd.append(mono),"channel mismatch refused");
+
+        Sound copy(snd);
+        checkEqual(2*total,copy.getSamples(),"copy of appended sound");
+        checkEqual(-7,(int)(short)copy.get(7,1),"copy data");
+    }
+
+    void checkReserve() {
+        report(0,"check reserve...");
+        const int n = 100;
+        Sound snd;
+        snd.resize(n,2);
+        for (int i=0; i<n; i++) {
+            snd.set(i,i,0);
+            snd.set(-i,i,1);
+        }
+        const int sizes[3] = { 10, n, 1000 };
+        bool ok = true;
+        for (int k=0; k<3; k++) {
+            snd.reserve(sizes[k]);
+            ok = ok && (snd.getSamples()==n) && (snd.getChannels()==2);
+            for (int i=0; i<n; i++) {
+                ok = ok && ((short)snd.get(i,0)==i) && ((short)snd.get(i,1)==-i);
+            }
+        }
+        checkTrue(ok,"samples kept by reserve");
+
+        Sound part;
+        part.resize(1,2);
+        part.set(7,0,0);
+        part.set(-7,0,1);
+        checkTrue(snd.append(part),"append after reserve");
+        checkEqual(n+1,snd.getSamples(),"sample count after reserve");
+        checkEqual(n-1,(int)(short)snd.get(n-1,0),"first channel after reserve");
+        checkEqual(-7,(int)(short)snd.get(n,1),"second channel after reserve");
+    }
+
+    void checkConversion() {
+        report(0,"check interleaved and float conversion...");
+        const int n = 37;
+        short in[2*n];
+        for (int i=0; i<n; i++) {
+            in[2*i] = (short)(i*800-16000);
+            in[2*i+1] = (short)(-i*800);
+        }
+        Sound snd;
+        snd.setInterleaved(in,n,2);
+        checkEqual(n,snd.getSamples(),"interleaved sample count");
+        checkEqual(2,snd.getChannels(),"interleaved channel count");
+        checkEqual(-800,(int)(short)snd.get(1,1),"interleaved data");
+
+        short out[2*n];
+        snd.getInterleaved(out);
+        bool ok = true;
+        for (int i=0; i<2*n; i++) {
+            ok = ok && (in[i]==out[i]);
+        }
+        checkTrue(ok,"short round trip");
+
+        float f[2*n];
+        snd.getInterleaved(f);
+        checkTrue(fabs(f[0]+16000/32768.0)<1e-6,"float value");
+        Sound snd2;
+        snd2.setInterleaved(f,n,2);
+        snd2.getInterleaved(out);
+        ok = true;
+        for (int i=0; i<2*n; i++) {
+            ok = ok && (in[i]==out[i]);
+        }
+        checkTrue(ok,"float round trip");
+
+        float plane[n];
+        snd.getChannel(0,plane);
+        snd2.setChannel(1,plane);
+        checkEqual((int)in[2*(n-1)],(int)(short)snd2.get(n-1,1),"planar float");
+
+        // out of range values saturate
+        float loud[n];
+        for (int i=0; i<n; i++) {
+            loud[i] = (i%2)?2.0f:-2.0f;
+        }
+        snd2.setChannel(0,loud);
+        checkEqual(-32768,(int)(short)snd2.get(0,0),"negative saturation");
+        checkEqual(32767,(int)(short)snd2.get(n-2,0),"positive saturation");
+    }
+
+    void checkRounding() {
+        report(0,"check float rounding and clamping...");
+        // 13 samples: one vectorizable block of 8 and a scalar tail of 5
+        const int n = 13;
+        const float pattern[8] = { 1e6f, -1e6f, 2.5f/32768, -2.5f/32768,
+                                   0.5f/32768, -0.5f/32768, 3.0f, -3.0f };
+        const int expect[8] = { 32767, -32768, 3, -3, 1, -1, 32767, -32768 };
+        float in[n];
+        for (int i=0; i<n; i++) {
+            in[i] = pattern[i%8];
+        }
+        Sound snd;
+        snd.resize(n,1);
+        snd.setChannel(0,in);
+        bool ok = true;
+        for (int i=0; i<n; i++) {
+            ok = ok && ((int)(short)snd.get(i,0)==expect[i%8]);
+        }
+        checkTrue(ok,"block and tail agree");
+    }
+
+    void checkFile() {
+        report(0,"check wav file round trip...");
+        const char *name = "sound_test.wav";
+        Sound snd;
+        snd.setFrequency(8000);
+        snd.resize(10000,2);
+        for (int i=0; i<snd.getSamples(); i++) {
+            snd.set((i*7)%30000,i,0);
+            snd.set(-(i*3)%30000,i,1);
+        }
+        checkTrue(yarp::sig::file::write(snd,name),"write");
+        Sound in;
+        checkTrue(yarp::sig::file::read(in,name),"read");
+        checkEqual(snd.getSamples(),in.getSamples(),"samples read");
+        checkEqual(2,in.getChannels(),"channels read");
+        checkEqual(8000,in.getFrequency(),"frequency read");
+        bool ok = true;
+        for (int i=0; i<snd.getSamples() && ok; i++) {
+            ok = (snd.get(i,0)==in.get(i,0)) && (snd.get(i,1)==in.get(i,1));
+        }
+        checkTrue(ok,"samples read");
+
+        yarp::sig::file::soundStreamWriter writer;
+        checkTrue(writer.open(name,8000,2),"stream open for writing");
+        for (int i=0; i<snd.getSamples(); i+=3000) {
+            int last = i+3000;
+            if (last>snd.getSamples()) last = snd.getSamples();
+            checkTrue(writer.writeBlock(snd.subSound(i,last)),"write block");
+        }
+        checkTrue(writer.close(),"stream close");
+
+        yarp::sig::file::soundStreamReader reader;
+        checkTrue(reader.open(name),"stream open for reading");
+        Sound block;
+        size_t got = 0;
+        ok = true;
+        while (reader.readBlock(block,4000)>0) {
+            for (int i=0; i<block.getSamples() && ok; i++) {
+                ok = (block.get(i,0)==snd.get(got+i,0)) &&
+                    (block.get(i,1)==snd.get(got+i,1));
+            }
+            got += block.getSamples();
+        }
+        checkEqual(snd.getSamples(),(int)got,"samples streamed");
+        checkTrue(ok,"streamed samples");
+        checkTrue(reader.rewind(5000),"rewind");
+        reader.readBlock(block,1);
+        checkEqual(snd.get(5000,1),block.get(0,1),"sample after rewind");
+        reader.close();
+
+        remove(name);
+    }
 
     void checkTransmit() {
         report(0,"checking sound transmission...");
@@ -85,6 +298,12 @@ public:
     virtual void runTests() {
         Network::setLocalMode(true);
         checkSetGet();
+        checkBulkAccess();
+        checkAppend();
+        checkReserve();
+        checkConversion();
+        checkRounding();
+        checkFile();
         checkTransmit();
         Network::setLocalMode(false);
     }